@@ -0,0 +1,107 @@
+#include "adc_dma.h"
+
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+// Clock do ADC (clk_adc, derivado do PLL USB) e amostras por segundo com o divisor mínimo
+#define ADC_CLOCK_HZ 48000000u
+#define ADC_TAXA_MAXIMA_HZ 500000u
+
+// Canais DMA do pingue-pongue (reservados na primeira chamada) e seus buffers
+static int canais[2] = {-1, -1};
+static uint16_t *buffers[2];
+static uint amostras_por_bloco;
+static adc_dma_callback_t callback_atual = NULL;
+static volatile uint32_t blocos = 0;
+
+// Pino em uso e a função/pull que tinha antes de passar ao modo analógico
+static uint pino_atual;
+static gpio_function_t funcao_anterior;
+static bool pullup_anterior, pulldown_anterior;
+static bool amostrando = false;
+
+// Tratador da interrupção DMA_IRQ_1, compartilhada com outros canais
+static void adc_dma_irq_handler(void) {
+    for (int i = 0; i < 2; i++) {
+        if (canais[i] < 0 || !dma_channel_get_irq1_status(canais[i])) continue;
+        dma_channel_acknowledge_irq1(canais[i]);
+
+        // O outro canal já foi disparado pelo encadeamento; este volta ao início do buffer para a próxima vez
+        dma_channel_set_write_addr(canais[i], buffers[i], false);
+        blocos++;
+        if (callback_atual) callback_atual(buffers[i], amostras_por_bloco);
+    }
+}
+
+bool adc_dma_iniciar(uint canal, uint32_t taxa_hz, uint16_t *buffer_a, uint16_t *buffer_b, uint num_amostras,
+                     adc_dma_callback_t callback) {
+    if (canal > 2 || taxa_hz == 0 || taxa_hz > ADC_TAXA_MAXIMA_HZ) return false;
+    if (amostrando) adc_dma_parar();
+
+    if (canais[0] < 0) {
+        canais[0] = dma_claim_unused_channel(true);
+        canais[1] = dma_claim_unused_channel(true);
+        irq_add_shared_handler(DMA_IRQ_1, adc_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+    }
+    buffers[0] = buffer_a;
+    buffers[1] = buffer_b;
+    amostras_por_bloco = num_amostras;
+    callback_atual = callback;
+    blocos = 0;
+
+    // O pino deixa a função digital (no teclado, uma das linhas) enquanto o ADC o usa
+    pino_atual = 26 + canal;
+    funcao_anterior = gpio_get_function(pino_atual);
+    pullup_anterior = gpio_is_pulled_up(pino_atual);
+    pulldown_anterior = gpio_is_pulled_down(pino_atual);
+
+    adc_init();
+    adc_gpio_init(pino_atual);
+    adc_select_input(canal);
+    // FIFO com DREQ a cada amostra, sem bit de erro e sem reduzir a 8 bits
+    adc_fifo_setup(true, true, 1, false, false);
+    // Uma conversão a cada (divisor + 1) ciclos de clk_adc
+    adc_set_clkdiv((float)ADC_CLOCK_HZ / taxa_hz - 1.0f);
+
+    // Amostras de 16 bits lidas sempre da FIFO do ADC e gravadas em sequência; cada canal dispara o outro
+    for (int i = 0; i < 2; i++) {
+        dma_channel_config c = dma_channel_get_default_config(canais[i]);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+        channel_config_set_dreq(&c, DREQ_ADC);
+        channel_config_set_chain_to(&c, canais[i ^ 1]);
+        dma_channel_configure(canais[i], &c, buffers[i], &adc_hw->fifo, num_amostras, false);
+        dma_channel_set_irq1_enabled(canais[i], true);
+    }
+
+    amostrando = true;
+    dma_channel_start(canais[0]);
+    adc_run(true);
+    return true;
+}
+
+void adc_dma_parar(void) {
+    if (!amostrando) return;
+    amostrando = false;
+
+    adc_run(false);
+    for (int i = 0; i < 2; i++) {
+        // Sem a interrupção habilitada, o abort não deixa um bloco pela metade para o callback
+        dma_channel_set_irq1_enabled(canais[i], false);
+        dma_channel_abort(canais[i]);
+        dma_channel_acknowledge_irq1(canais[i]);
+    }
+    adc_fifo_drain();
+
+    gpio_set_function(pino_atual, funcao_anterior);
+    gpio_set_input_enabled(pino_atual, true);
+    gpio_set_pulls(pino_atual, pullup_anterior, pulldown_anterior);
+}
+
+uint32_t adc_dma_blocos(void) {
+    return blocos;
+}
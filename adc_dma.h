@@ -0,0 +1,35 @@
+#ifndef ADC_DMA_H
+#define ADC_DMA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/types.h"
+
+/**
+ * @brief Função chamada, em contexto de interrupção, quando um buffer de amostras fica completo.
+ */
+typedef void (*adc_dma_callback_t)(const uint16_t *amostras, uint num_amostras);
+
+/**
+ * @brief Amostra um canal do ADC em ritmo livre, com dois canais DMA encadeados em pingue-pongue.
+ *
+ * Cada canal DMA preenche um dos buffers pelo DREQ do ADC e, ao terminar, dispara o outro: a
+ * amostragem não tem lacunas entre os blocos. A interrupção (DMA_IRQ_1, compartilhada) entrega o
+ * buffer completo ao callback e devolve o endereço de escrita do canal ao início do seu buffer.
+ *
+ * @param canal Canal do ADC (0 a 2, GPIO 26 a 28). O GPIO 29 (canal 3) mede VSYS na Pico e é
+ *              usado pelo CYW43 na Pico W, por isso é recusado.
+ * @param taxa_hz Amostras por segundo (até 500 kHz, com o ADC a 48 MHz).
+ * @param num_amostras Tamanho de cada buffer, em amostras de 16 bits (12 bits úteis).
+ * @return false se o canal ou a taxa forem inválidos.
+ */
+bool adc_dma_iniciar(uint canal, uint32_t taxa_hz, uint16_t *buffer_a, uint16_t *buffer_b, uint num_amostras,
+                     adc_dma_callback_t callback);
+
+// Para o ADC e os dois canais DMA e devolve o pino à sua função anterior
+void adc_dma_parar(void);
+
+// Blocos completos desde adc_dma_iniciar
+uint32_t adc_dma_blocos(void);
+
+#endif
@@ -0,0 +1,154 @@
+#include "animacao.h"
+
+#include <stddef.h>
+#include "compacta.h"
+#include "fila_spsc.h"
+#include "trace.h"
+
+typedef struct {
+    const anim_sequencia_t *seq;
+    anim_modo_t modo;
+} anim_pedido_t;
+
+static anim_relogio_t relogio_atual;
+static anim_saida_t saida_atual;
+
+// Pedidos de anim_tocar a caminho de anim_tick (possivelmente em outra interrupção ou outro núcleo)
+static anim_pedido_t pedidos_buffer[ANIM_FILA_TAM];
+static fila_spsc_t pedidos;
+
+// Sequências que aguardam o fim da atual; acessadas apenas por anim_tick
+static const anim_sequencia_t *espera[ANIM_FILA_TAM];
+static uint8_t num_espera = 0;
+
+// Estado da reprodução, alterado apenas por anim_tick
+static const anim_sequencia_t *atual = NULL;
+static uint32_t passo = 0;
+static anim_passo_t passo_atual;
+static bool exibido = false;
+static uint32_t inicio_ms = 0;
+static bool suspensa = false;
+
+// Sequências compactadas e geradas: o frame do passo atual é produzido uma vez, quando o passo começa.
+// A saída não pode guardar o ponteiro além da duração do passo (fb_enviar copia o frame).
+static compacta_t decodificador;
+static uint32_t quadro_gerado[COMPACTA_MAX_PIXELS];
+
+void anim_init(anim_relogio_t relogio, anim_saida_t saida) {
+    relogio_atual = relogio;
+    saida_atual = saida;
+    fila_spsc_init(&pedidos, pedidos_buffer, sizeof(anim_pedido_t), ANIM_FILA_TAM);
+    num_espera = 0;
+    atual = NULL;
+    suspensa = false;
+}
+
+bool anim_tocar(const anim_sequencia_t *seq, anim_modo_t modo) {
+    anim_pedido_t pedido = {seq, modo};
+    return fila_spsc_inserir(&pedidos, &pedido);
+}
+
+// Prepara passo_atual; false se o frame não puder ser decodificado ou a sequência gerada terminou
+static bool produzir_passo(void) {
+    if (atual->gerador) {
+        passo_atual.frame = quadro_gerado;
+        return atual->gerador(atual->contexto, passo, quadro_gerado, &passo_atual.duracao_ms);
+    }
+    if (!atual->compactada) {
+        if (passo >= atual->num_passos) return false;
+        passo_atual = atual->passos[passo];
+        return true;
+    }
+    passo_atual.frame = quadro_gerado;
+    return compacta_proximo(&decodificador, quadro_gerado, &passo_atual.duracao_ms);
+}
+
+static bool carregar_passo(void) {
+    TRACE(TRACE_CODIFICANDO, passo);
+    bool ok = produzir_passo();
+    if (ok) TRACE(TRACE_CODIFICADO, passo);
+    return ok;
+}
+
+static void iniciar(const anim_sequencia_t *seq) {
+    atual = NULL;
+    passo = 0;
+    exibido = false;
+    if (!seq) return;
+
+    if (!seq->gerador && seq->compactada && !compacta_abrir(&decodificador, seq->compactada)) return;
+
+    atual = seq;
+    if (!carregar_passo()) atual = NULL;
+}
+
+// Consome os pedidos pendentes: um ANIM_SUBSTITUIR descarta a animação atual e tudo o que aguardava
+static void processar_pedidos(void) {
+    anim_pedido_t pedido;
+
+    while (fila_spsc_retirar(&pedidos, &pedido)) {
+        if (pedido.modo == ANIM_SUBSTITUIR) {
+            num_espera = 0;
+            iniciar(pedido.seq);
+        } else if (atual == NULL && num_espera == 0) {
+            iniciar(pedido.seq);
+        } else if (num_espera < ANIM_FILA_TAM) {
+            espera[num_espera++] = pedido.seq;
+        }
+    }
+}
+
+// Ao fim de uma sequência, passa para a próxima que aguardava (se houver)
+static void proxima_sequencia(void) {
+    if (num_espera == 0) {
+        atual = NULL;
+        return;
+    }
+    iniciar(espera[0]);
+    num_espera--;
+    for (uint8_t i = 0; i < num_espera; i++) {
+        espera[i] = espera[i + 1];
+    }
+}
+
+void anim_tick(void) {
+    uint32_t agora = relogio_atual();
+
+    processar_pedidos();
+
+    // Suspensa, outra fonte ocupa a matriz: o passo atual é reexibido ao retomar
+    if (suspensa) {
+        exibido = false;
+        return;
+    }
+
+    while (atual) {
+        if (!exibido) {
+            // Saída ocupada: tenta novamente no próximo tick, com o mesmo frame já decodificado
+            if (!saida_atual(passo_atual.frame)) return;
+            exibido = true;
+            inicio_ms = agora;
+        }
+        if (agora - inicio_ms < passo_atual.duracao_ms) return;
+
+        passo++;
+        if (carregar_passo()) {
+            exibido = false;
+        } else {
+            proxima_sequencia();
+        }
+    }
+}
+
+void anim_suspender(bool suspender) {
+    suspensa = suspender;
+}
+
+bool anim_ativa(void) {
+    return atual != NULL || num_espera > 0 || fila_spsc_ocupacao(&pedidos) > 0;
+}
+
+bool anim_mantendo(void) {
+    const anim_sequencia_t *seq = atual;
+    return seq != NULL && seq->manter && num_espera == 0 && fila_spsc_ocupacao(&pedidos) == 0;
+}
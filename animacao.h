@@ -0,0 +1,94 @@
+#ifndef ANIMACAO_H
+#define ANIMACAO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Quantidade de pedidos de animação aguardando o próximo tick (potência de 2)
+#define ANIM_FILA_TAM 4
+
+/**
+ * @brief Um passo de animação: frame já codificado e tempo em que permanece na matriz.
+ */
+typedef struct {
+    const uint32_t *frame;
+    uint32_t duracao_ms;
+} anim_passo_t;
+
+/**
+ * @brief Gera o frame de um passo de uma sequência procedural.
+ *
+ * Chamado uma vez no início de cada passo, com passo = 0 ao (re)começar a sequência.
+ *
+ * @param frame Destino com até COMPACTA_MAX_PIXELS palavras GRB.
+ * @return false quando a sequência termina (o frame anterior permanece aceso).
+ */
+typedef bool (*anim_gerador_t)(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms);
+
+/**
+ * @brief Sequência de passos exibidos em ordem; o último frame permanece aceso ao final.
+ *
+ * Com compactada definida, os passos vêm de um contêiner de compacta.h, decodificado um frame
+ * por passo; com gerador definido, cada frame é produzido pela função no início do passo.
+ * Nos dois casos, passos e num_passos são ignorados. Com manter, a sequência não termina e só
+ * renova a mesma imagem (um pontilhado, por exemplo): anim_mantendo a separa de uma animação.
+ */
+typedef struct {
+    const anim_passo_t *passos;
+    uint8_t num_passos;
+    const uint8_t *compactada;
+    anim_gerador_t gerador;
+    void *contexto;
+    bool manter;
+} anim_sequencia_t;
+
+// Como um novo pedido convive com a animação em andamento
+typedef enum {
+    ANIM_SUBSTITUIR,  // Interrompe a animação atual e descarta os pedidos enfileirados
+    ANIM_ENFILEIRAR   // Começa quando as animações anteriores terminarem
+} anim_modo_t;
+
+// Fonte de tempo em milissegundos, injetável para permitir simulação no host
+typedef uint32_t (*anim_relogio_t)(void);
+
+// Envia um frame para a matriz; retorna false se a saída ainda estiver ocupada
+typedef bool (*anim_saida_t)(const uint32_t *frame);
+
+/**
+ * @brief Inicializa o escalonador de animações.
+ *
+ * @param relogio Função que informa o tempo atual em ms.
+ * @param saida Função que entrega um frame à matriz sem bloquear.
+ */
+void anim_init(anim_relogio_t relogio, anim_saida_t saida);
+
+/**
+ * @brief Solicita a reprodução de uma sequência.
+ *
+ * Pode ser chamada do laço principal enquanto anim_tick roda em interrupção ou no outro núcleo;
+ * o pedido segue por uma fila sem travas e passa a valer no próximo tick.
+ *
+ * @return false se a fila de pedidos estiver cheia.
+ */
+bool anim_tocar(const anim_sequencia_t *seq, anim_modo_t modo);
+
+/**
+ * @brief Avança a animação de acordo com o relógio; chamada periodicamente por um timer.
+ */
+void anim_tick(void);
+
+/**
+ * @brief Suspende ou retoma a saída do escalonador (ex.: enquanto a stream serial ocupa a matriz).
+ *
+ * Suspenso, anim_tick continua aceitando pedidos mas não envia frames nem conta o tempo dos passos;
+ * ao retomar, o passo atual é exibido de novo e sua duração recomeça. Chamada no contexto de anim_tick.
+ */
+void anim_suspender(bool suspender);
+
+// Indica se há uma sequência em reprodução ou pedidos pendentes (aproximado se consultado de outro núcleo)
+bool anim_ativa(void);
+
+// Indica se a única coisa em reprodução é uma sequência com manter, sem pedidos pendentes
+bool anim_mantendo(void);
+
+#endif
@@ -0,0 +1,45 @@
+# Animações compiladas no build, como pico_generate_pio_header faz com os .pio:
+#
+#   pio_matrix_gerar_animacoes(alvo entrada.txt...)
+#
+# executa tools/compactar sobre as entradas (caminhos relativos à raiz do projeto), gera
+# animacoes.c e animacoes.h na pasta de build, acrescenta o .c às fontes do alvo e a pasta às
+# inclusões. Cada contêiner é conferido por uma decodificação completa e uma entrada inválida
+# interrompe o build. Os frames pré-codificados usam o protocolo de PIO_MATRIX_LED.
+
+set(ANIMACOES_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+function(pio_matrix_gerar_animacoes alvo)
+    if (TARGET compactar)
+        set(compactar_executavel $<TARGET_FILE:compactar>)
+        set(compactar_depende compactar)
+    else()
+        # Firmware: compactar roda no computador de build; a mesma árvore é configurada no modo
+        # PIO_MATRIX_HOST com o compilador do host, como o SDK faz com o pioasm
+        include(ExternalProject)
+        set(compactar_build ${CMAKE_BINARY_DIR}/compactar_host)
+        set(compactar_executavel ${compactar_build}/compactar${CMAKE_HOST_EXECUTABLE_SUFFIX})
+        set(compactar_depende compactar_host)
+        ExternalProject_Add(compactar_host
+            SOURCE_DIR ${ANIMACOES_DIR}
+            BINARY_DIR ${compactar_build}
+            CMAKE_ARGS -DPIO_MATRIX_HOST=ON -DPIO_MATRIX_LED=${PIO_MATRIX_LED}
+            BUILD_COMMAND ${CMAKE_COMMAND} --build <BINARY_DIR> --target compactar
+            BUILD_BYPRODUCTS ${compactar_executavel}
+            INSTALL_COMMAND ""
+        )
+    endif()
+
+    set(saida_c ${CMAKE_CURRENT_BINARY_DIR}/animacoes.c)
+    set(saida_h ${CMAKE_CURRENT_BINARY_DIR}/animacoes.h)
+    add_custom_command(
+        OUTPUT ${saida_c} ${saida_h}
+        COMMAND ${compactar_executavel} -o ${saida_c} -H ${saida_h} ${ARGN}
+        DEPENDS ${ARGN} ${compactar_depende}
+        WORKING_DIRECTORY ${ANIMACOES_DIR}
+        COMMENT "Compilando as animações (tools/compactar)"
+        VERBATIM
+    )
+    target_sources(${alvo} PRIVATE ${saida_c})
+    target_include_directories(${alvo} PRIVATE ${CMAKE_CURRENT_BINARY_DIR})
+endfunction()
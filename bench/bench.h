@@ -0,0 +1,71 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Utilitários comuns aos benchmarks executados no host (Linux)
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Contador de ciclos da CPU do host; recorre a nanossegundos quando não há contador acessível
+static inline uint64_t bench_ciclos(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// Tempo monotônico em nanossegundos
+static inline uint64_t bench_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Impede que o compilador descarte resultados calculados apenas para medição
+static volatile uint32_t bench_sumidouro;
+
+static inline void bench_consumir(uint32_t valor) {
+    bench_sumidouro ^= valor;
+}
+
+// Imprime uma linha de resultado no formato comum a todos os benchmarks
+static inline void bench_relatar(const char *nome, uint64_t ciclos, uint64_t ns, uint32_t repeticoes) {
+    printf("%-32s %10.1f ciclos/op %10.1f ns/op\n", nome,
+           (double)ciclos / repeticoes, (double)ns / repeticoes);
+}
+
+// Conferências dos benchmarks que também validam o código medido: cada condição falsa é impressa e contada
+static uint32_t bench_falhas = 0;
+
+static inline void conferir(bool condicao, const char *descricao) {
+    if (condicao) return;
+    bench_falhas++;
+    printf("FALHA: %s\n", descricao);
+}
+
+// Imprime o total de falhas e devolve o código de saída do benchmark (0 se todas as conferências passaram)
+static inline int bench_resultado(void) {
+    printf("%s: %u falhas\n", bench_falhas ? "FALHA" : "ok", bench_falhas);
+    return bench_falhas ? 1 : 0;
+}
+
+// Codificação original do firmware (matrix_rgb em double), referência das medições de bench_cor e
+// bench_quadros contra as tabelas de cor.h
+static inline uint32_t matrix_rgb_double(double b, double r, double g) {
+    unsigned char R, G, B;
+    R = r * 255;
+    G = g * 255;
+    B = b * 255;
+    return (G << 24) | (R << 16) | (B << 8);
+}
+
+#endif
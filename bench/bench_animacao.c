@@ -0,0 +1,273 @@
+// Escalonador de animações (animacao.h) com relógio e saída falsos, sem esperas reais:
+// - cada passo exibido em ordem, no instante em que o anterior completa sua duração, e o último
+//   frame mantido ao fim da sequência;
+// - saída ocupada: o frame é tentado de novo no tick seguinte e a duração conta a partir da exibição;
+// - ANIM_ENFILEIRAR começa quando a sequência atual termina; ANIM_SUBSTITUIR a interrompe no
+//   próximo tick e descarta o que estava enfileirado antes dele;
+// - fila de pedidos cheia;
+// - sequência compactada (compacta.h): cada frame decodificado no início do seu passo, com a
+//   duração gravada no contêiner;
+// - sequência gerada: o gerador chamado uma vez por passo, a partir do passo 0, até recusar;
+// - sequência mantida (manter): renova a imagem a cada passo sem terminar; anim_mantendo só vale
+//   enquanto nada mais estiver em reprodução ou pedido, e um ANIM_SUBSTITUIR a encerra;
+// - custo de um tick ocioso e de um tick com sequência em andamento.
+//
+// Compilação no host:
+//   gcc -O2 -DPIO_MATRIX_TRACE=0 -I.. -I../tools bench_animacao.c ../animacao.c ../fila_spsc.c ../compacta.c ../cor.c ../tools/compacta_codificador.c -o bench_animacao
+
+#include <stdbool.h>
+
+#include "animacao.h"
+#include "bench.h"
+#include "compacta_codificador.h"
+#include "cor.h"
+
+#define REPETICOES 1000000
+
+// ----- Relógio e saída falsos -----
+
+static uint32_t agora_ms = 0;
+static uint32_t ocupada_ate_ms = 0;   // A saída recusa frames antes deste instante
+
+// Frames entregues à saída, com o instante da entrega e o primeiro pixel (os frames decodificados
+// de uma sequência compactada chegam sempre no mesmo buffer)
+typedef struct {
+    const uint32_t *frame;
+    uint32_t instante_ms;
+    uint32_t pixel0;
+} entrega_t;
+
+#define MAX_ENTREGAS 64
+static entrega_t entregas[MAX_ENTREGAS];
+static uint32_t num_entregas = 0;
+
+static uint32_t relogio(void) {
+    return agora_ms;
+}
+
+static bool saida(const uint32_t *frame) {
+    if (agora_ms < ocupada_ate_ms) return false;
+    if (num_entregas < MAX_ENTREGAS) entregas[num_entregas++] = (entrega_t){frame, agora_ms, frame[0]};
+    return true;
+}
+
+// Avança o relógio de 1 em 1 ms até fim_ms, com um tick a cada ms
+static void avancar_ate(uint32_t fim_ms) {
+    while (agora_ms < fim_ms) {
+        agora_ms++;
+        anim_tick();
+    }
+}
+
+static void reiniciar(void) {
+    agora_ms = 0;
+    ocupada_ate_ms = 0;
+    num_entregas = 0;
+    anim_init(relogio, saida);
+}
+
+static bool entrega_igual(uint32_t i, const uint32_t *frame, uint32_t instante_ms) {
+    return i < num_entregas && entregas[i].frame == frame && entregas[i].instante_ms == instante_ms;
+}
+
+// ----- Sequências de teste -----
+
+static const uint32_t frame_a[1] = {1}, frame_b[1] = {2}, frame_c[1] = {3}, frame_x[1] = {4}, frame_y[1] = {5};
+
+static const anim_passo_t passos_abc[3] = {{frame_a, 10}, {frame_b, 20}, {frame_c, 30}};
+static const anim_sequencia_t seq_abc = {.passos = passos_abc, .num_passos = 3};
+
+static const anim_passo_t passos_xy[2] = {{frame_x, 5}, {frame_y, 5}};
+static const anim_sequencia_t seq_xy = {.passos = passos_xy, .num_passos = 2};
+
+static void conferir_ordem(void) {
+    reiniciar();
+    conferir(!anim_ativa(), "ativa antes de qualquer pedido");
+    anim_tocar(&seq_abc, ANIM_SUBSTITUIR);
+    conferir(anim_ativa(), "pedido pendente não conta como ativo");
+
+    // O pedido vale no próximo tick; cada passo começa quando o anterior completa a duração
+    avancar_ate(100);
+    conferir(num_entregas == 3, "número de frames entregues");
+    conferir(entrega_igual(0, frame_a, 1), "primeiro passo fora do instante");
+    conferir(entrega_igual(1, frame_b, 11), "segundo passo fora do instante");
+    conferir(entrega_igual(2, frame_c, 31), "terceiro passo fora do instante");
+
+    // Ao fim, o último frame fica na matriz e nada mais é enviado
+    conferir(!anim_ativa(), "ativa depois do último passo");
+}
+
+static void conferir_saida_ocupada(void) {
+    reiniciar();
+    ocupada_ate_ms = 4;
+    anim_tocar(&seq_abc, ANIM_SUBSTITUIR);
+    avancar_ate(100);
+
+    // O primeiro frame espera a saída; a duração de 10 ms conta a partir da exibição
+    conferir(entrega_igual(0, frame_a, 4), "frame não tentado de novo quando a saída liberou");
+    conferir(entrega_igual(1, frame_b, 14), "duração contada antes da exibição");
+    conferir(num_entregas == 3, "frames perdidos com a saída ocupada");
+}
+
+static void conferir_enfileirar(void) {
+    reiniciar();
+    anim_tocar(&seq_abc, ANIM_SUBSTITUIR);
+    avancar_ate(5);
+    anim_tocar(&seq_xy, ANIM_ENFILEIRAR);
+    avancar_ate(100);
+
+    // seq_xy começa quando o último passo de seq_abc completa seus 30 ms
+    conferir(num_entregas == 5, "número de frames com uma sequência enfileirada");
+    conferir(entrega_igual(2, frame_c, 31) && entrega_igual(3, frame_x, 61) && entrega_igual(4, frame_y, 66),
+             "sequência enfileirada fora do instante");
+}
+
+static void conferir_substituir(void) {
+    reiniciar();
+    anim_tocar(&seq_abc, ANIM_SUBSTITUIR);
+    avancar_ate(15);
+
+    // Um pedido enfileirado seguido de um ANIM_SUBSTITUIR: o primeiro é descartado
+    anim_tocar(&seq_abc, ANIM_ENFILEIRAR);
+    anim_tocar(&seq_xy, ANIM_SUBSTITUIR);
+    avancar_ate(100);
+
+    conferir(entrega_igual(1, frame_b, 11), "substituição antes do pedido");
+    conferir(entrega_igual(2, frame_x, 16), "ANIM_SUBSTITUIR não interrompeu no próximo tick");
+    conferir(entrega_igual(3, frame_y, 21), "segundo passo da sequência substituta");
+    conferir(num_entregas == 4, "pedido enfileirado antes do ANIM_SUBSTITUIR não foi descartado");
+    conferir(!anim_ativa(), "ativa depois da sequência substituta");
+}
+
+static void conferir_fila_cheia(void) {
+    uint32_t aceitos = 0;
+
+    reiniciar();
+    for (int i = 0; i < ANIM_FILA_TAM + 2; i++) aceitos += anim_tocar(&seq_xy, ANIM_ENFILEIRAR);
+    conferir(aceitos == ANIM_FILA_TAM, "capacidade da fila de pedidos");
+
+    // Sem ticks, os pedidos aceitos tocam em ordem depois
+    avancar_ate(200);
+    conferir(num_entregas == 2 * ANIM_FILA_TAM, "pedidos aceitos não tocaram todos");
+}
+
+static void conferir_compactada(void) {
+    // Três frames de 25 pixels, cada um inteiro numa cor da paleta, com 10, 20 e 30 ms
+    static const uint8_t paleta[3 * 3] = {255, 0, 0, 0, 255, 0, 0, 0, 255};
+    static const uint16_t duracoes[3] = {10, 20, 30};
+    static uint8_t dados[COMPACTA_TAMANHO_MAXIMO(25, 3, 3)];
+    uint8_t indices[3 * 25];
+
+    for (uint32_t i = 0; i < sizeof(indices); i++) indices[i] = (uint8_t)(i / 25);
+    conferir(compacta_codificar(dados, paleta, 3, indices, duracoes, 25, 3) > 0, "contêiner de teste");
+    const anim_sequencia_t seq = {.compactada = dados};
+
+    reiniciar();
+    anim_tocar(&seq, ANIM_SUBSTITUIR);
+    avancar_ate(100);
+    conferir(num_entregas == 3, "número de frames da sequência compactada");
+    for (uint32_t q = 0; q < 3 && q < num_entregas; q++) {
+        conferir(entregas[q].pixel0 == cor_grb(paleta[3 * q], paleta[3 * q + 1], paleta[3 * q + 2]),
+                 "frame compactado decodificado errado");
+    }
+    conferir(num_entregas == 3 && entregas[1].instante_ms == 11 && entregas[2].instante_ms == 31,
+             "duração gravada no contêiner");
+}
+
+// Gerador de teste: três passos de 10 ms, cada um com o número do passo no primeiro pixel
+static uint32_t chamadas_gerador = 0;
+
+static bool gerador(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms) {
+    conferir(passo == chamadas_gerador++, "gerador chamado fora de ordem");
+    if (passo >= *(const uint32_t *)contexto) return false;
+    frame[0] = passo;
+    *duracao_ms = 10;
+    return true;
+}
+
+static void conferir_gerada(void) {
+    static const uint32_t num_passos = 3;
+    const anim_sequencia_t seq = {.gerador = gerador, .contexto = (void *)&num_passos};
+
+    reiniciar();
+    chamadas_gerador = 0;
+    anim_tocar(&seq, ANIM_SUBSTITUIR);
+    avancar_ate(100);
+    conferir(num_entregas == 3 && chamadas_gerador == 4, "passos da sequência gerada");
+    for (uint32_t q = 0; q < 3 && q < num_entregas; q++) {
+        conferir(entregas[q].pixel0 == q && entregas[q].instante_ms == 1 + 10 * q, "passo gerado fora do instante");
+    }
+    conferir(!anim_ativa(), "ativa depois de o gerador recusar");
+}
+
+// Gerador sem fim, como um pontilhado: a mesma imagem renovada a cada 2 ms
+#define PIXEL_FIXO 9
+
+static bool gerador_fixo(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms) {
+    (void)contexto;
+    (void)passo;
+    frame[0] = PIXEL_FIXO;
+    *duracao_ms = 2;
+    return true;
+}
+
+static void conferir_mantida(void) {
+    const anim_sequencia_t seq_fixa = {.gerador = gerador_fixo, .manter = true};
+    const anim_sequencia_t seq_animada = {.gerador = gerador_fixo};
+
+    reiniciar();
+    anim_tocar(&seq_fixa, ANIM_SUBSTITUIR);
+    conferir(anim_ativa() && !anim_mantendo(), "pedido pendente contado como imagem mantida");
+    avancar_ate(100);
+    conferir(anim_ativa() && anim_mantendo(), "imagem mantida não reconhecida");
+    conferir(num_entregas == 50 && entregas[49].pixel0 == PIXEL_FIXO && entregas[49].instante_ms == 99,
+             "imagem mantida não renovada a cada passo");
+
+    // Um pedido enfileirado atrás dela é atividade, mesmo sem tocar (a mantida não termina)
+    anim_tocar(&seq_abc, ANIM_ENFILEIRAR);
+    conferir(!anim_mantendo(), "pedido pendente ignorado por anim_mantendo");
+    avancar_ate(110);
+    conferir(!anim_mantendo() && entregas[num_entregas - 1].pixel0 == PIXEL_FIXO, "sequência enfileirada atrás da mantida");
+
+    // ANIM_SUBSTITUIR a encerra; a sequência substituta termina e nada fica ativo
+    anim_tocar(&seq_abc, ANIM_SUBSTITUIR);
+    avancar_ate(200);
+    conferir(!anim_ativa() && !anim_mantendo(), "imagem mantida não encerrada por ANIM_SUBSTITUIR");
+
+    // A mesma geração sem manter é uma animação comum
+    anim_tocar(&seq_animada, ANIM_SUBSTITUIR);
+    avancar_ate(210);
+    conferir(anim_ativa() && !anim_mantendo(), "sequência sem manter contada como imagem mantida");
+}
+
+static void medir(void) {
+    static const anim_passo_t passos_longos[1] = {{frame_a, 0xFFFFFFFFu}};
+    static const anim_sequencia_t seq_longa = {.passos = passos_longos, .num_passos = 1};
+
+    reiniciar();
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t i = 0; i < REPETICOES; i++) anim_tick();
+    bench_relatar("anim_tick (ocioso)", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+
+    anim_tocar(&seq_longa, ANIM_SUBSTITUIR);
+    anim_tick();
+    c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t i = 0; i < REPETICOES; i++, agora_ms++) anim_tick();
+    bench_relatar("anim_tick (passo em andamento)", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+}
+
+int main(void) {
+    cor_set_brilho(255);
+
+    conferir_ordem();
+    conferir_saida_ocupada();
+    conferir_enfileirar();
+    conferir_substituir();
+    conferir_fila_cheia();
+    conferir_compactada();
+    conferir_gerada();
+    conferir_mantida();
+    medir();
+
+    return bench_resultado();
+}
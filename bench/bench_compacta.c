@@ -0,0 +1,126 @@
+// Formato compactado (compacta.h) aplicado às animações existentes: as das teclas '1' e '9'
+// e os textos das teclas '2' a '8' desenhados com a fonte 5x5.
+// Para cada sequência: tamanho pré-codificado (uint32_t por pixel) x contêiner, taxa de compressão
+// e custo de decodificar um frame, comparado à cópia de um frame pré-codificado.
+//
+// Compilação no host:
+//   gcc -O2 -I.. -I../tools bench_compacta.c ../tools/compacta_codificador.c ../compacta.c ../cor.c ../fonte.c ../layout.c -o bench_compacta
+
+#include <string.h>
+
+#include "bench.h"
+#include "compacta_codificador.h"
+#include "cor.h"
+#include "fonte.h"
+#include "layout.h"
+
+#define NUM_PIXELS 25
+#define MAX_QUADROS 5
+#define REPETICOES 20000
+
+typedef struct {
+    const char *nome;
+    uint8_t rgb[MAX_QUADROS][NUM_PIXELS][3];
+    uint16_t duracoes[MAX_QUADROS];
+    uint16_t num_quadros;
+} sequencia_t;
+
+// Desenhos das teclas '1' e '9' na ordem dos LEDs, como em frames_tecla_1 e frames_tecla_9
+static const uint8_t desenhos_tecla_1[MAX_QUADROS][NUM_PIXELS] = {
+    {1,1,1,1,1, 1,0,0,0,1, 1,0,1,0,1, 1,0,0,0,1, 1,1,1,1,1},
+    {1,0,0,0,1, 0,1,0,1,0, 0,0,1,0,0, 0,1,0,1,0, 1,0,0,0,1},
+    {0,1,1,1,0, 1,0,0,0,1, 0,1,0,1,0, 0,1,0,1,0, 0,0,0,0,0},
+    {1,1,1,1,1, 1,0,0,0,1, 1,1,1,0,1, 1,0,0,0,0, 1,1,1,1,1},
+    {0,1,1,1,0, 1,0,0,0,1, 1,0,0,0,1, 1,0,0,0,1, 0,1,1,1,0},
+};
+static const uint8_t cores_tecla_1[MAX_QUADROS][3] = {{255,255,255}, {255,255,255}, {255,0,0}, {0,255,0}, {0,255,0}};
+
+static const uint8_t desenhos_tecla_9[MAX_QUADROS][NUM_PIXELS] = {
+    {1,1,1,1,1, 1,1,1,1,1, 1,1,1,1,1, 1,1,1,1,1, 1,1,1,1,1},
+    {0,1,1,1,0, 1,0,1,0,1, 0,0,1,0,0, 0,0,1,0,0, 0,0,1,0,0},
+    {1,1,1,1,1, 1,0,0,0,0, 0,0,1,1,1, 1,0,0,0,0, 1,1,1,1,1},
+    {1,0,0,0,1, 1,0,0,1,1, 1,0,1,0,1, 1,1,0,0,1, 1,0,0,0,1},
+    {0,1,1,1,1, 1,0,0,0,1, 1,0,0,0,1, 1,0,0,0,1, 0,1,1,1,1},
+};
+static const uint8_t cores_tecla_9[MAX_QUADROS][3] = {{255,255,255}, {0,0,255}, {255,0,0}, {255,0,0}, {255,0,0}};
+
+static void montar_tecla(sequencia_t *s, const char *nome, const uint8_t (*desenhos)[NUM_PIXELS], const uint8_t (*cores)[3]) {
+    memset(s, 0, sizeof(*s));
+    s->nome = nome;
+    s->num_quadros = MAX_QUADROS;
+    for (int q = 0; q < MAX_QUADROS; q++) {
+        s->duracoes[q] = 2000;
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            if (desenhos[q][i]) memcpy(s->rgb[q][i], cores[q], 3);
+        }
+    }
+}
+
+// Um caractere por frame, aceso em azul, na posição física dos LEDs (mesmo desenho de fonte_desenhar)
+static void montar_texto(sequencia_t *s, const char *texto) {
+    uint32_t mascara[NUM_PIXELS];
+
+    memset(s, 0, sizeof(*s));
+    s->nome = texto;
+    s->num_quadros = MAX_QUADROS;
+    for (int q = 0; q < MAX_QUADROS; q++) {
+        s->duracoes[q] = 1500;
+        fonte_desenhar(fonte_glifo(texto[q]), 1, 0, mascara);
+        for (int i = 0; i < NUM_PIXELS; i++) s->rgb[q][i][2] = mascara[i] ? 255 : 0;
+    }
+}
+
+static void medir(const sequencia_t *s, uint32_t *total_bruto, uint32_t *total_compactado) {
+    static uint8_t paleta[COMPACTA_MAX_CORES * 3];
+    static uint8_t indices[MAX_QUADROS * NUM_PIXELS];
+    static uint8_t dados[COMPACTA_TAMANHO_MAXIMO(NUM_PIXELS, MAX_QUADROS, COMPACTA_MAX_CORES)];
+    static compacta_t c;
+    uint32_t frame[NUM_PIXELS];
+
+    uint8_t num_cores = compacta_paleta(&s->rgb[0][0][0], s->num_quadros * NUM_PIXELS, paleta, indices);
+    uint32_t tamanho = compacta_codificar(dados, paleta, num_cores, indices, s->duracoes, NUM_PIXELS, s->num_quadros);
+    uint32_t bruto = s->num_quadros * NUM_PIXELS * 4u;
+
+    // Cada repetição abre o contêiner e decodifica todos os frames, como uma reprodução completa
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES; n++) {
+        compacta_abrir(&c, dados);
+        while (compacta_proximo(&c, frame, NULL)) bench_consumir(frame[n % NUM_PIXELS]);
+    }
+    uint64_t ciclos = bench_ciclos() - c0, ns = bench_ns() - t0;
+
+    printf("%-8s %2u cores %4u -> %3u bytes (%.1fx) ", s->nome, num_cores, bruto, tamanho, (double)bruto / tamanho);
+    bench_relatar("decodificar / frame", ciclos, ns, REPETICOES * s->num_quadros);
+    *total_bruto += bruto;
+    *total_compactado += tamanho;
+}
+
+int main(void) {
+    static const char *const textos[] = {"ABCDE", "FGHIJ", "KLMNO", "PQRST", "UVWXY", "01234", "56789"};
+    static sequencia_t s;
+    static uint32_t pre_codificado[NUM_PIXELS], frame[NUM_PIXELS];
+    uint32_t bruto = 0, compactado = 0;
+
+    cor_set_brilho(COR_BRILHO_PADRAO);
+    layout_definir(&LAYOUT_PLACA);
+
+    montar_tecla(&s, "tecla_1", desenhos_tecla_1, cores_tecla_1);
+    medir(&s, &bruto, &compactado);
+    montar_tecla(&s, "tecla_9", desenhos_tecla_9, cores_tecla_9);
+    medir(&s, &bruto, &compactado);
+    for (unsigned t = 0; t < sizeof(textos) / sizeof(textos[0]); t++) {
+        montar_texto(&s, textos[t]);
+        medir(&s, &bruto, &compactado);
+    }
+    printf("total: %u -> %u bytes (%.1fx)\n\n", bruto, compactado, (double)bruto / compactado);
+
+    // Referência: reproduzir um frame pré-codificado é só uma cópia de bloco
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES * MAX_QUADROS; n++) {
+        pre_codificado[n % NUM_PIXELS] = n;
+        memcpy(frame, pre_codificado, sizeof(frame));
+        bench_consumir(frame[n % NUM_PIXELS]);
+    }
+    bench_relatar("copiar pré-codificado / frame", bench_ciclos() - c0, bench_ns() - t0, REPETICOES * MAX_QUADROS);
+    return 0;
+}
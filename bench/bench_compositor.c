@@ -0,0 +1,173 @@
+// Compositor de camadas (compositor.h):
+// - a mistura SWAR (vermelho e azul numa multiplicação, verde em outra) conferida contra uma
+//   versão escalar, canal a canal, em entradas aleatórias, nos modos de mistura e de soma;
+// - custo por pixel da mistura SWAR e da escalar;
+// - custo de um frame de 3 camadas na matriz 5x5 e num mosaico 16x16 (256 LEDs): composição
+//   completa, só a camada de cima alterada e nenhuma alteração.
+//
+// Compilação no host:
+//   gcc -O2 -I.. bench_compositor.c ../compositor.c ../efeitos.c ../fonte.c ../layout.c ../cor.c -o bench_compositor
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "bench.h"
+#include "compositor.h"
+#include "cor.h"
+#include "efeitos.h"
+#include "fonte.h"
+#include "layout.h"
+
+#define REPETICOES 100000
+#define AMOSTRAS_CONFERIDAS 1000000
+
+// Tick das animações no firmware
+#define TICK_US 2000u
+
+static uint32_t semente = 0x9E3779B9u;
+
+static uint32_t aleatorio(void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
+
+// Referência: um canal por vez, com o mesmo alfa de 0 a 256 e o mesmo arredondamento para baixo
+static uint32_t misturar_escalar(uint32_t abaixo, uint32_t argb, comp_modo_t modo) {
+    uint32_t a = argb >> 24, resultado = 0;
+    a += a >> 7;
+
+    for (int desloc = 0; desloc <= 16; desloc += 8) {
+        uint32_t c = (argb >> desloc) & 0xFFu, d = (abaixo >> desloc) & 0xFFu, v;
+        if (modo == COMP_MISTURA) {
+            v = ((c * a) >> 8) + ((d * (256 - a)) >> 8);
+        } else {
+            v = ((c * a) >> 8) + d;
+            if (v > 255) v = 255;
+        }
+        resultado |= v << desloc;
+    }
+    return resultado;
+}
+
+static void conferir_mistura(void) {
+    uint32_t erros = 0;
+
+    for (uint32_t i = 0; i < AMOSTRAS_CONFERIDAS; i++) {
+        uint32_t abaixo = aleatorio() & 0x00FFFFFFu, argb = aleatorio();
+        comp_modo_t modo = (i & 1) ? COMP_SOMA : COMP_MISTURA;
+        erros += comp_misturar(abaixo, argb, modo) != misturar_escalar(abaixo, argb, modo);
+    }
+    conferir(erros == 0, "mistura SWAR diferente da escalar");
+
+    conferir(comp_misturar(0x123456u, COMP_ARGB(0, 200, 100, 50), COMP_MISTURA) == 0x123456u,
+             "alfa 0 altera o que está abaixo");
+    conferir(comp_misturar(0x123456u, COMP_ARGB(255, 200, 100, 50), COMP_MISTURA) == 0xC86432u,
+             "alfa 255 não copia a camada");
+    conferir(comp_misturar(0xF0F0F0u, COMP_ARGB(255, 0x20, 0x0F, 0x10), COMP_SOMA) == 0xFFFFFFu,
+             "soma não satura");
+    conferir(comp_misturar(0x808080u, COMP_ARGB(255, 0x80, 0x7F, 0x00), COMP_SOMA) == 0xFFFF80u,
+             "soma com vai-um vazando para o canal vizinho");
+}
+
+// Três camadas como na cena: fundo opaco, glifo com sombra e uma linha somada
+static void montar(compositor_t *c, efeito_t *fundo) {
+    comp_init(c, 3, layout_matriz.num_pixels);
+    comp_modo(c, 2, COMP_SOMA);
+    efeito_camada(fundo, c->camadas[0].pixels);
+    comp_glifo(c, 1, fonte_glifo('0'), COMP_ARGB(255, 255, 255, 255), COMP_ARGB(160, 0, 0, 0));
+    for (uint32_t x = 0; x < layout_matriz.largura; x++) {
+        comp_definir(&c->camadas[2], (layout_matriz.altura - 1u) * layout_matriz.largura + x,
+                     COMP_ARGB(160, 0, 0, 255));
+    }
+    comp_compor(c);
+}
+
+static double medir_composicao(compositor_t *c, const char *caso, const char *tamanho, int alteradas) {
+    static uint32_t frame[LAYOUT_MAX_PIXELS];
+    char nome[48];
+
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t r = 0; r < REPETICOES; r++) {
+        // Alterar a camada de cima não muda as de baixo: só ela é refeita
+        if (alteradas == 3) c->camadas[0].alterada = true;
+        if (alteradas >= 1) comp_definir(&c->camadas[2], 0, COMP_ARGB(r & 0xFF, 255, 0, 0));
+        if (comp_compor(c)) comp_codificar(c, frame);
+        bench_consumir(frame[r % layout_matriz.num_pixels]);
+    }
+    uint64_t ns = bench_ns() - t0;
+    snprintf(nome, sizeof(nome), "%s %s / frame", caso, tamanho);
+    bench_relatar(nome, bench_ciclos() - c0, ns, REPETICOES);
+    return (double)ns / REPETICOES;
+}
+
+static void medir_tamanho(const char *tamanho) {
+    static compositor_t c;
+    static efeito_t fundo;
+
+    efeito_init(&fundo, EFEITO_PLASMA, 16);
+    montar(&c, &fundo);
+
+    uint32_t antes = c.estatisticas.camadas_misturadas;
+    double completa = medir_composicao(&c, "3 camadas", tamanho, 3);
+    conferir(c.estatisticas.camadas_misturadas - antes == 3u * REPETICOES, "composição completa não refez as 3 camadas");
+
+    antes = c.estatisticas.camadas_misturadas;
+    double topo = medir_composicao(&c, "só a de cima", tamanho, 1);
+    conferir(c.estatisticas.camadas_misturadas - antes <= REPETICOES, "camada de cima refez as de baixo");
+
+    antes = c.estatisticas.ignoradas;
+    double nada = medir_composicao(&c, "sem alteração", tamanho, 0);
+    conferir(c.estatisticas.ignoradas - antes == REPETICOES, "composição sem alteração não foi ignorada");
+
+    printf("  %s: completa %.3f us = %.3f%% do tick, só a de cima %.2fx mais rápida, sem alteração %.1f ns\n",
+           tamanho, completa / 1000.0, 100.0 * completa / 1000.0 / TICK_US, completa / topo, nada);
+}
+
+static void medir_pixel(void) {
+    static uint32_t abaixo[LAYOUT_MAX_PIXELS], camada[LAYOUT_MAX_PIXELS];
+
+    for (uint32_t i = 0; i < LAYOUT_MAX_PIXELS; i++) {
+        abaixo[i] = aleatorio() & 0x00FFFFFFu;
+        camada[i] = aleatorio();
+    }
+
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t r = 0; r < REPETICOES; r++) {
+        for (uint32_t i = 0; i < LAYOUT_MAX_PIXELS; i++) abaixo[i] = comp_misturar(abaixo[i], camada[i], COMP_MISTURA);
+    }
+    bench_relatar("mistura SWAR / pixel", bench_ciclos() - c0, bench_ns() - t0, REPETICOES * LAYOUT_MAX_PIXELS);
+
+    c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t r = 0; r < REPETICOES; r++) {
+        for (uint32_t i = 0; i < LAYOUT_MAX_PIXELS; i++) abaixo[i] = misturar_escalar(abaixo[i], camada[i], COMP_MISTURA);
+    }
+    bench_relatar("mistura escalar / pixel", bench_ciclos() - c0, bench_ns() - t0, REPETICOES * LAYOUT_MAX_PIXELS);
+
+    c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t r = 0; r < REPETICOES; r++) {
+        for (uint32_t i = 0; i < LAYOUT_MAX_PIXELS; i++) abaixo[i] = comp_misturar(abaixo[i], camada[i], COMP_SOMA);
+    }
+    bench_relatar("soma SWAR / pixel", bench_ciclos() - c0, bench_ns() - t0, REPETICOES * LAYOUT_MAX_PIXELS);
+    bench_consumir(abaixo[0]);
+}
+
+int main(void) {
+    cor_set_brilho(COR_BRILHO_PADRAO);
+    efeitos_init();
+    conferir_mistura();
+    medir_pixel();
+
+    printf("\n");
+    layout_definir(&LAYOUT_PLACA);
+    medir_tamanho("5x5");
+
+    // Mosaico de 2 x 2 painéis 8x8 em serpentina, como em bench_efeitos
+    printf("\n");
+    layout_definir(&(layout_config_t){.largura = 8, .altura = 8, .fiacao = LAYOUT_SERPENTINA,
+                                      .paineis_x = 2, .paineis_y = 2, .fiacao_paineis = LAYOUT_SERPENTINA});
+    medir_tamanho("16x16");
+
+    return bench_resultado();
+}
@@ -0,0 +1,45 @@
+// Compara o custo por frame da codificação em ponto flutuante (matrix_rgb original)
+// com a codificação em ponto fixo por tabela (cor_grb).
+//
+// Compilação no host:
+//   gcc -O2 -I.. bench_cor.c ../cor.c -o bench_cor
+
+#include "bench.h"
+#include "cor.h"
+
+#define NUM_PIXELS 25
+#define REPETICOES 200000
+
+int main(void) {
+    // Mesma densidade de dados das tabelas de desenho: intensidade em um canal por pixel
+    volatile double padrao_d[NUM_PIXELS];
+    volatile uint8_t padrao_u8[NUM_PIXELS];
+    uint32_t frame[NUM_PIXELS];
+
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        padrao_d[i] = (i % 3) ? 1.0 : 0.2;
+        padrao_u8[i] = (i % 3) ? 255 : 51;
+    }
+    cor_set_brilho(COR_BRILHO_PADRAO);
+
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES; n++) {
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            frame[i] = matrix_rgb_double(padrao_d[i], 0.0, 0.5);
+        }
+        bench_consumir(frame[n % NUM_PIXELS]);
+    }
+    bench_relatar("matrix_rgb (double) / frame", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+
+    c0 = bench_ciclos(); t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES; n++) {
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            frame[i] = cor_grb(0, 128, padrao_u8[i]);
+        }
+        bench_consumir(frame[n % NUM_PIXELS]);
+    }
+    bench_relatar("cor_grb (LUT) / frame", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+
+    // O host tem FPU; no RP2040 cada operação double é emulada em software e a diferença é maior
+    return 0;
+}
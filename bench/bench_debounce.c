@@ -0,0 +1,221 @@
+// Debounce do teclado (debounce.h) alimentado com sinais de contato simulados, uma leitura a cada
+// KEYPAD_PERIODO_MS como a varredura do firmware:
+// - pulsos mais curtos que DEBOUNCE_MS, isolados ou em rajada, não geram evento;
+// - uma pressão com repiques gera exatamente um KEYPAD_PRESSIONADA, no início do trecho estável e
+//   entregue DEBOUNCE_MS depois, KEYPAD_SEGURADA e KEYPAD_REPETICAO nos instantes previstos por
+//   DEBOUNCE_SEGURAR_MS e DEBOUNCE_REPETIR_MS, e um único KEYPAD_SOLTA após os repiques da soltura;
+// - pressões aleatórias com repiques aleatórios geram sempre um par pressionada/solta;
+// - o acorde registrado nos eventos com duas teclas fechadas;
+// - custo de uma leitura das 16 teclas.
+//
+// Compilação no host:
+//   gcc -O2 -DPIO_MATRIX_TRACE=0 -I.. bench_debounce.c ../debounce.c ../fila_spsc.c -o bench_debounce
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "bench.h"
+#include "debounce.h"
+#include "keypad.h"
+
+#define REPETICOES 1000000
+#define PRESSOES_ALEATORIAS 2048
+
+static const char mapa[DEBOUNCE_NUM_TECLAS] = {'1', '2', '3', 'A', '4', '5', '6', 'B',
+                                               '7', '8', '9', 'C', '*', '0', '#', 'D'};
+
+static uint32_t semente = 0x2545F491u;
+
+static uint32_t aleatorio(uint32_t min, uint32_t max) {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return min + semente % (max - min + 1);
+}
+
+// Eventos recebidos, com o instante da leitura que os entregou
+typedef struct {
+    keypad_evento_t evento;
+    uint32_t entregue_ms;
+} recebido_t;
+
+#define MAX_RECEBIDOS 8192
+static recebido_t recebidos[MAX_RECEBIDOS];
+static uint32_t num_recebidos;
+
+// Sinal de uma tecla: trechos alternados fechado/aberto, começando aberto em t = 0
+typedef struct {
+    uint32_t bordas[1024];   // Instantes em que o contato muda de estado
+    uint32_t num_bordas;
+} sinal_t;
+
+static void borda(sinal_t *s, uint32_t t) {
+    if (s->num_bordas < sizeof(s->bordas) / sizeof(s->bordas[0])) s->bordas[s->num_bordas++] = t;
+}
+
+static bool fechado(const sinal_t *s, uint32_t t) {
+    uint32_t n = 0;
+    while (n < s->num_bordas && s->bordas[n] <= t) n++;
+    return n & 1u;
+}
+
+// Alimenta o debounce de 0 até fim_ms com as teclas dos sinais (NULL: sempre aberta)
+static void simular(const sinal_t *sinais[DEBOUNCE_NUM_TECLAS], uint32_t fim_ms) {
+    keypad_evento_t e;
+
+    debounce_init(mapa);
+    num_recebidos = 0;
+    for (uint32_t t = 0; t <= fim_ms; t += KEYPAD_PERIODO_MS) {
+        uint16_t bruto = 0;
+        for (int k = 0; k < DEBOUNCE_NUM_TECLAS; k++) {
+            if (sinais[k] && fechado(sinais[k], t)) bruto |= (uint16_t)(1u << k);
+        }
+        debounce_atualizar(bruto, t);
+        while (debounce_obter_evento(&e)) {
+            if (num_recebidos < MAX_RECEBIDOS) recebidos[num_recebidos++] = (recebido_t){e, t};
+        }
+    }
+}
+
+static bool evento_igual(uint32_t i, char tecla, keypad_tipo_evento_t tipo, uint32_t tempo_ms, uint32_t entregue_ms) {
+    const recebido_t *r = &recebidos[i];
+    return i < num_recebidos && r->evento.tecla == tecla && r->evento.tipo == tipo && r->evento.tempo_ms == tempo_ms &&
+           r->entregue_ms == entregue_ms;
+}
+
+static void conferir_ruido(void) {
+    static sinal_t s;
+    const sinal_t *sinais[DEBOUNCE_NUM_TECLAS] = {0};
+
+    // Um pulso isolado de DEBOUNCE_MS - 1 e uma rajada de pulsos curtos com intervalos curtos
+    memset(&s, 0, sizeof(s));
+    borda(&s, 100), borda(&s, 100 + DEBOUNCE_MS - 1);
+    for (uint32_t t = 300; t < 400; t += 2 * (DEBOUNCE_MS - 1)) borda(&s, t), borda(&s, t + DEBOUNCE_MS - 1);
+    sinais[5] = &s;
+    simular(sinais, 1000);
+    conferir(num_recebidos == 0, "pulso mais curto que DEBOUNCE_MS gerou evento");
+    conferir(debounce_ocioso(), "debounce não voltou ao repouso após o ruído");
+
+    // Referência: o mesmo pulso com DEBOUNCE_MS é aceito
+    memset(&s, 0, sizeof(s));
+    borda(&s, 100), borda(&s, 100 + DEBOUNCE_MS + 1);
+    simular(sinais, 1000);
+    conferir(evento_igual(0, '5', KEYPAD_PRESSIONADA, 100, 100 + DEBOUNCE_MS), "pulso de DEBOUNCE_MS não aceito");
+}
+
+static void conferir_repiques(void) {
+    static sinal_t s;
+    const sinal_t *sinais[DEBOUNCE_NUM_TECLAS] = {0};
+
+    // Pressão: fecha em 1000, repica até 1006 e fica fechada; soltura em 2000, repica até 2003
+    memset(&s, 0, sizeof(s));
+    borda(&s, 1000), borda(&s, 1002), borda(&s, 1003), borda(&s, 1004), borda(&s, 1006);
+    borda(&s, 2000), borda(&s, 2001), borda(&s, 2003);
+    sinais[0] = &s;
+    simular(sinais, 3000);
+
+    uint32_t estavel = 1006, segurada = estavel + DEBOUNCE_SEGURAR_MS;
+    conferir(num_recebidos == 5, "número de eventos da pressão com repiques");
+    conferir(evento_igual(0, '1', KEYPAD_PRESSIONADA, estavel, estavel + DEBOUNCE_MS),
+             "KEYPAD_PRESSIONADA fora do trecho estável");
+    conferir(evento_igual(1, '1', KEYPAD_SEGURADA, segurada, segurada), "KEYPAD_SEGURADA fora do instante");
+    conferir(evento_igual(2, '1', KEYPAD_REPETICAO, segurada + DEBOUNCE_REPETIR_MS, segurada + DEBOUNCE_REPETIR_MS),
+             "primeira KEYPAD_REPETICAO fora do instante");
+    conferir(evento_igual(3, '1', KEYPAD_REPETICAO, segurada + 2 * DEBOUNCE_REPETIR_MS,
+                          segurada + 2 * DEBOUNCE_REPETIR_MS),
+             "segunda KEYPAD_REPETICAO fora do instante");
+    conferir(evento_igual(4, '1', KEYPAD_SOLTA, 2003, 2003 + DEBOUNCE_MS), "KEYPAD_SOLTA após os repiques");
+    conferir(debounce_ocioso(), "debounce não voltou ao repouso após a soltura");
+}
+
+static void conferir_aleatorio(void) {
+    static sinal_t s;
+    const sinal_t *sinais[DEBOUNCE_NUM_TECLAS] = {0};
+    uint32_t t, pressionadas = 0, soltas = 0, outros = 0, tempos_errados = 0;
+    uint32_t estaveis[64];
+
+    // Lotes de pressões curtas (sem segurar), cada borda com uma rajada de repiques mais curtos que a janela
+    for (uint32_t lote = 0; lote < PRESSOES_ALEATORIAS / 32; lote++) {
+        memset(&s, 0, sizeof(s));
+        t = 10;
+        for (uint32_t p = 0; p < 32; p++) {
+            for (int lado = 0; lado < 2; lado++) {
+                uint32_t repiques = aleatorio(0, 6);
+                for (uint32_t r = 0; r < repiques; r++) {
+                    borda(&s, t);
+                    t += aleatorio(1, DEBOUNCE_MS - 1);
+                    borda(&s, t);
+                    t += aleatorio(1, DEBOUNCE_MS - 1);
+                }
+                borda(&s, t);
+                if (lado == 0) estaveis[p] = t;
+                t += lado == 0 ? aleatorio(DEBOUNCE_MS + 1, DEBOUNCE_SEGURAR_MS - 100)
+                               : aleatorio(DEBOUNCE_MS + 1, 100);
+            }
+        }
+        sinais[7] = &s;
+        simular(sinais, t + 10);
+        for (uint32_t i = 0; i < num_recebidos; i++) {
+            if (recebidos[i].evento.tipo == KEYPAD_PRESSIONADA) {
+                uint32_t n = pressionadas % 32;
+                tempos_errados += recebidos[i].evento.tempo_ms != estaveis[n];
+                pressionadas++;
+            } else if (recebidos[i].evento.tipo == KEYPAD_SOLTA) {
+                soltas++;
+            } else {
+                outros++;
+            }
+        }
+    }
+    conferir(pressionadas == PRESSOES_ALEATORIAS && soltas == PRESSOES_ALEATORIAS && outros == 0,
+             "pressões aleatórias com repiques não geraram um par pressionada/solta cada");
+    conferir(tempos_errados == 0, "KEYPAD_PRESSIONADA fora do início do trecho estável");
+    printf("%u pressões aleatórias com repiques: %u pressionadas, %u soltas, %u outros\n", PRESSOES_ALEATORIAS,
+           pressionadas, soltas, outros);
+}
+
+static void conferir_acorde(void) {
+    static sinal_t a, b;
+    const sinal_t *sinais[DEBOUNCE_NUM_TECLAS] = {0};
+
+    // '*' fechada de 100 a 650 (antes de segurar); '5' repica a partir de 300 e fica fechada até 400
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+    borda(&a, 100), borda(&a, 650);
+    borda(&b, 300), borda(&b, 301), borda(&b, 303), borda(&b, 400);
+    sinais[12] = &a;
+    sinais[5] = &b;
+    simular(sinais, 1000);
+
+    uint16_t ambas = (uint16_t)((1u << 12) | (1u << 5));
+    conferir(num_recebidos == 4, "número de eventos do acorde");
+    conferir(evento_igual(1, '5', KEYPAD_PRESSIONADA, 303, 303 + DEBOUNCE_MS) && recebidos[1].evento.acorde == ambas,
+             "acorde na pressão da segunda tecla");
+    conferir(evento_igual(2, '5', KEYPAD_SOLTA, 400, 400 + DEBOUNCE_MS) && recebidos[2].evento.acorde == (1u << 12),
+             "acorde na soltura da segunda tecla");
+}
+
+static void medir(void) {
+    uint32_t t = 0;
+
+    debounce_init(mapa);
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t i = 0; i < REPETICOES; i++, t += KEYPAD_PERIODO_MS) {
+        // Uma tecla trocando a cada 64 ms e ruído de 1 ms em outra a cada 16 ms
+        uint16_t bruto = (uint16_t)(((t >> 6) & 1u) | ((t & 15u) == 0 ? 1u << 9 : 0u));
+        debounce_atualizar(bruto, t);
+        keypad_evento_t e;
+        while (debounce_obter_evento(&e)) bench_consumir(e.tempo_ms);
+    }
+    bench_relatar("debounce_atualizar (16 teclas)", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+}
+
+int main(void) {
+    conferir_ruido();
+    conferir_repiques();
+    conferir_aleatorio();
+    conferir_acorde();
+    medir();
+
+    return bench_resultado();
+}
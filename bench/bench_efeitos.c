@@ -0,0 +1,110 @@
+// Efeitos procedurais (efeitos.h):
+// - custo de um frame de cada efeito na matriz 5x5 e num mosaico 16x16 (256 LEDs), comparado ao
+//   orçamento de um tick de animação (ANIM_TICK_MS = 2 ms, até 500 frames/s);
+// - conferência das tabelas: cores primárias da roda de matizes e simetria da onda senoidal;
+// - cada efeito precisa acender a matriz e mudar de um frame para o outro.
+//
+// Compilação no host:
+//   gcc -O2 -I.. bench_efeitos.c ../efeitos.c ../layout.c ../cor.c -o bench_efeitos
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "bench.h"
+#include "cor.h"
+#include "efeitos.h"
+#include "layout.h"
+
+#define REPETICOES 100000
+
+// Tick das animações no firmware e clock do sistema
+#define TICK_US 2000u
+#define CLOCK_MHZ 128u
+
+// Frames calculados antes de conferir o conteúdo (o fogo precisa de alguns para aquecer)
+#define FRAMES_AQUECIMENTO 64
+
+static void conferir_tabelas(void) {
+    uint8_t rgb[3];
+
+    efeitos_hsv(0, 255, 255, rgb);
+    conferir(rgb[0] == 255 && rgb[1] == 0 && rgb[2] == 0, "matiz 0 não é vermelho puro");
+    efeitos_hsv(85, 255, 255, rgb);
+    conferir(rgb[0] <= 2 && rgb[1] == 255 && rgb[2] == 0, "matiz 85 não é verde");
+    efeitos_hsv(128, 255, 255, rgb);
+    conferir(rgb[0] == 0 && rgb[1] == 255 && rgb[2] == 255, "matiz 128 não é ciano");
+    efeitos_hsv(171, 255, 255, rgb);
+    conferir(rgb[0] <= 2 && rgb[1] == 0 && rgb[2] == 255, "matiz 171 não é azul");
+    efeitos_hsv(77, 0, 255, rgb);
+    conferir(rgb[0] >= 254 && rgb[1] >= 254 && rgb[2] >= 254, "saturação 0 não é branco");
+    efeitos_hsv(77, 255, 0, rgb);
+    conferir((rgb[0] | rgb[1] | rgb[2]) == 0, "valor 0 não apaga");
+
+    for (int i = 1; i < 128; i++) {
+        conferir(efeitos_seno8[i] + efeitos_seno8[256 - i] == 256, "onda senoidal assimétrica");
+    }
+}
+
+static void conferir_conteudo(efeito_tipo_t tipo) {
+    static efeito_t e;
+    uint32_t anterior[25], frame[25];
+    uint32_t apagado = cor_grb(0, 0, 0), acesos = 0;
+
+    efeito_init(&e, tipo, 16);
+    for (int q = 0; q < FRAMES_AQUECIMENTO; q++) efeito_quadro(&e, anterior);
+    efeito_quadro(&e, frame);
+
+    for (int i = 0; i < 25; i++) acesos += frame[i] != apagado;
+    conferir(acesos > 0, "efeito com a matriz apagada");
+    conferir(memcmp(anterior, frame, sizeof(frame)) != 0, "efeito parado entre dois frames");
+}
+
+// Custo médio de um frame; retorna ns por frame
+static double medir(efeito_tipo_t tipo, const char *tamanho) {
+    static efeito_t e;
+    static uint32_t frame[LAYOUT_MAX_PIXELS];
+    char nome[48];
+
+    efeito_init(&e, tipo, 16);
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t r = 0; r < REPETICOES; r++) {
+        efeito_quadro(&e, frame);
+        bench_consumir(frame[r % layout_matriz.num_pixels]);
+    }
+    uint64_t ns = bench_ns() - t0;
+    snprintf(nome, sizeof(nome), "%s %s / frame", efeito_nome(tipo), tamanho);
+    bench_relatar(nome, bench_ciclos() - c0, ns, REPETICOES);
+    return (double)ns / REPETICOES;
+}
+
+int main(void) {
+    double pior_5x5 = 0, pior_16x16 = 0;
+
+    cor_set_brilho(COR_BRILHO_PADRAO);
+    efeitos_init();
+    conferir_tabelas();
+
+    layout_definir(&LAYOUT_PLACA);
+    for (int t = 0; t < EFEITO_NUM; t++) conferir_conteudo((efeito_tipo_t)t);
+    for (int t = 0; t < EFEITO_NUM; t++) {
+        double ns = medir((efeito_tipo_t)t, "5x5");
+        if (ns > pior_5x5) pior_5x5 = ns;
+    }
+
+    // Mosaico de 2 x 2 painéis 8x8 em serpentina: a mesma imagem lógica, dez vezes mais pixels
+    printf("\n");
+    layout_definir(&(layout_config_t){.largura = 8, .altura = 8, .fiacao = LAYOUT_SERPENTINA,
+                                      .paineis_x = 2, .paineis_y = 2, .fiacao_paineis = LAYOUT_SERPENTINA});
+    for (int t = 0; t < EFEITO_NUM; t++) {
+        double ns = medir((efeito_tipo_t)t, "16x16");
+        if (ns > pior_16x16) pior_16x16 = ns;
+    }
+
+    printf("\norçamento por tick: %u us (%u ciclos a %u MHz)\n", TICK_US, TICK_US * CLOCK_MHZ, CLOCK_MHZ);
+    printf("pior efeito no host: 5x5 %.3f us/frame = %.3f%% do tick; 16x16 %.3f us/frame = %.3f%% do tick\n",
+           pior_5x5 / 1000.0, 100.0 * pior_5x5 / 1000.0 / TICK_US, pior_16x16 / 1000.0,
+           100.0 * pior_16x16 / 1000.0 / TICK_US);
+
+    conferir(pior_5x5 < TICK_US * 1000.0 / 100.0, "efeito 5x5 acima de 1% do tick no host");
+    return bench_resultado();
+}
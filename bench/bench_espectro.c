@@ -0,0 +1,166 @@
+// Analisador de espectro (espectro.h):
+// - FFT em ponto fixo contra uma DFT em double sobre ruído, com o erro relativo à escala;
+// - tons sintéticos no centro de cada faixa: a coluna da faixa precisa ser a mais alta e quase encher
+//   (fora do centro de uma raia, a janela de Hann perde até 1,4 dB),
+//   e o silêncio (com 1 LSB de ruído) precisa manter todas as colunas vazias;
+// - custo por bloco da FFT e da análise completa, comparado ao tempo de um bloco (16 ms a 16 kHz).
+//
+// Compilação no host:
+//   gcc -O2 -I.. bench_espectro.c ../espectro.c ../layout.c ../cor.c -lm -o bench_espectro
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "cor.h"
+#include "espectro.h"
+#include "layout.h"
+
+#define REPETICOES 20000
+
+// Blocos analisados por tom, para o nível assentar
+#define BLOCOS_TOM 8
+
+// Nível mínimo da coluna de um tom de AMPLITUDE
+#define NIVEL_TOM 240
+
+// Amplitude dos tons em unidades do ADC de 12 bits (meia escala = 2048)
+#define AMPLITUDE 1000
+
+// conferir de bench.h seguido do valor medido
+static void conferir_valor(bool condicao, const char *descricao, double valor) {
+    conferir(condicao, descricao);
+    if (!condicao) printf("  valor: %.1f\n", valor);
+}
+
+// Bloco de um tom puro em torno da meia escala, continuando a fase do bloco anterior
+static void gerar_tom(uint16_t *amostras, double freq_hz, double amplitude, uint32_t bloco) {
+    for (uint32_t n = 0; n < ESPECTRO_N; n++) {
+        double t = (double)(bloco * ESPECTRO_N + n) / ESPECTRO_TAXA_HZ;
+        amostras[n] = (uint16_t)lround(2048.0 + amplitude * sin(2.0 * M_PI * freq_hz * t));
+    }
+}
+
+static void conferir_fft(void) {
+    static int16_t re[ESPECTRO_N], im[ESPECTRO_N];
+    static double xr[ESPECTRO_N], xi[ESPECTRO_N];
+    double pior = 0;
+
+    srand(1);
+    for (uint32_t n = 0; n < ESPECTRO_N; n++) {
+        re[n] = (int16_t)(rand() % 16384 - 8192);
+        im[n] = (int16_t)(rand() % 16384 - 8192);
+        xr[n] = re[n];
+        xi[n] = im[n];
+    }
+    espectro_fft(re, im);
+
+    // A FFT divide por 2 a cada estágio: o resultado é a DFT / ESPECTRO_N
+    for (uint32_t k = 0; k < ESPECTRO_N; k++) {
+        double sr = 0, si = 0;
+        for (uint32_t n = 0; n < ESPECTRO_N; n++) {
+            double a = -2.0 * M_PI * k * n / ESPECTRO_N;
+            sr += xr[n] * cos(a) - xi[n] * sin(a);
+            si += xr[n] * sin(a) + xi[n] * cos(a);
+        }
+        double erro = hypot(sr / ESPECTRO_N - re[k], si / ESPECTRO_N - im[k]);
+        if (erro > pior) pior = erro;
+    }
+    printf("fft: maior erro contra a DFT em double = %.2f LSB (entrada de até 8192)\n", pior);
+    conferir_valor(pior < 8.0, "erro da FFT acima de 8 LSB", pior);
+}
+
+static void conferir_tons(void) {
+    static espectro_t e;
+    static const uint32_t limites[ESPECTRO_BANDAS + 1] = ESPECTRO_LIMITES_HZ;
+    uint16_t amostras[ESPECTRO_N];
+
+    printf("\ntom (Hz)   níveis das colunas\n");
+    for (int b = 0; b < ESPECTRO_BANDAS; b++) {
+        double centro = sqrt((double)limites[b] * limites[b + 1]);
+        espectro_init(&e, ESPECTRO_TAXA_HZ, 2);
+        for (uint32_t q = 0; q < BLOCOS_TOM; q++) {
+            gerar_tom(amostras, centro, AMPLITUDE, q);
+            espectro_bloco(&e, amostras);
+        }
+
+        printf("%8.0f  ", centro);
+        for (int c = 0; c < ESPECTRO_BANDAS; c++) printf(" %3u", e.nivel[c]);
+        printf("\n");
+
+        conferir_valor(e.nivel[b] >= NIVEL_TOM, "coluna do tom abaixo de NIVEL_TOM", e.nivel[b]);
+        for (int c = 0; c < ESPECTRO_BANDAS; c++) {
+            if (c != b) conferir_valor(e.nivel[c] < e.nivel[b], "outra coluna tão alta quanto a do tom", e.nivel[c]);
+        }
+    }
+
+    // Silêncio: meia escala com 1 LSB de ruído; as colunas cheias precisam esvaziar
+    srand(2);
+    for (uint32_t q = 0; q < 64; q++) {
+        for (uint32_t n = 0; n < ESPECTRO_N; n++) amostras[n] = (uint16_t)(2047 + rand() % 3);
+        espectro_bloco(&e, amostras);
+    }
+    printf("  silêncio ");
+    for (int c = 0; c < ESPECTRO_BANDAS; c++) {
+        printf(" %3u", e.nivel[c]);
+        conferir_valor(e.nivel[c] == 0, "coluna acesa no silêncio", e.nivel[c]);
+    }
+    printf("\n");
+}
+
+int main(void) {
+    static espectro_t e;
+    static uint16_t amostras[ESPECTRO_N];
+    static int16_t re[ESPECTRO_N], im[ESPECTRO_N];
+    uint32_t frame[25];
+
+    cor_set_brilho(COR_BRILHO_PADRAO);
+    layout_definir(&LAYOUT_PLACA);
+
+    conferir_fft();
+    conferir_tons();
+
+    // Custo: um acorde de três tons, para que nada seja trivial
+    for (uint32_t n = 0; n < ESPECTRO_N; n++) {
+        double t = (double)n / ESPECTRO_TAXA_HZ;
+        amostras[n] = (uint16_t)lround(2048.0 + 300 * sin(2 * M_PI * 110 * t) + 300 * sin(2 * M_PI * 700 * t) +
+                                       300 * sin(2 * M_PI * 3000 * t));
+    }
+    espectro_init(&e, ESPECTRO_TAXA_HZ, 2);
+    printf("\n");
+
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t r = 0; r < REPETICOES; r++) {
+        for (uint32_t n = 0; n < ESPECTRO_N; n++) {
+            re[n] = (int16_t)((amostras[n] - 2048) * 8);
+            im[n] = 0;
+        }
+        espectro_fft(re, im);
+        bench_consumir((uint32_t)re[r % ESPECTRO_N]);
+    }
+    bench_relatar("fft 256 pontos / bloco", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+
+    c0 = bench_ciclos(); t0 = bench_ns();
+    for (uint32_t r = 0; r < REPETICOES; r++) {
+        espectro_bloco(&e, amostras);
+        bench_consumir(e.nivel[r % ESPECTRO_BANDAS]);
+    }
+    uint64_t ns_bloco = bench_ns() - t0;
+    bench_relatar("análise completa / bloco", bench_ciclos() - c0, ns_bloco, REPETICOES);
+
+    c0 = bench_ciclos(); t0 = bench_ns();
+    for (uint32_t r = 0; r < REPETICOES; r++) {
+        espectro_quadro(&e, frame);
+        bench_consumir(frame[r % 25]);
+    }
+    bench_relatar("desenho das colunas / frame", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+
+    uint32_t bloco_us = 1000000u * ESPECTRO_N / ESPECTRO_TAXA_HZ;
+    double us_bloco = ns_bloco / 1000.0 / REPETICOES;
+    printf("\nbloco: %u amostras a %u Hz = %u us (%.1f frames/s)\n", ESPECTRO_N, ESPECTRO_TAXA_HZ, bloco_us,
+           1000000.0 / bloco_us);
+    printf("análise no host: %.2f us/bloco = %.3f%% do tempo do bloco\n", us_bloco, 100.0 * us_bloco / bloco_us);
+
+    conferir_valor(us_bloco < bloco_us / 100.0, "análise acima de 1% do bloco no host", us_bloco);
+    return bench_resultado();
+}
@@ -0,0 +1,223 @@
+// Envio de frames por DMA (frame_dma.h) contra um backend falso de PIO/DMA (bench/sdk_falso):
+// - o frame_dma.c do firmware, sem alterações, sobre um DMA simulado que entrega uma palavra à
+//   FIFO a cada US_POR_PALAVRA (o ritmo do DREQ) e gera a interrupção DMA_IRQ_0 ao terminar;
+// - configuração do canal: DREQ de TX da state machine, escrita fixa na FIFO, palavras de 32 bits;
+// - ocupado desde o envio, recusa de um segundo frame durante a transferência e durante o latch,
+//   callback e contagem na conclusão, liberação exatamente FRAME_DMA_LATCH_US depois dela;
+// - interrupções de outros canais na mesma linha ignoradas e frame_dma_aguardar retornando no
+//   instante da liberação.
+//
+// Compilação no host:
+//   gcc -O2 -DPIO_MATRIX_TRACE=0 -I.. -Isdk_falso bench_frame_dma.c ../frame_dma.c -o bench_frame_dma
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "bench.h"
+#include "frame_dma.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+#define CANAL 3
+#define OUTRO_CANAL 5
+#define SM 1
+#define NUM_PALAVRAS 25
+
+// Ritmo do DREQ simulado: 24 bits a 800 kHz por palavra
+#define US_POR_PALAVRA 30
+
+// ----- Backend falso -----
+
+static struct {
+    uint64_t agora_us;
+    bool canal_reservado;
+    dma_channel_config config;
+    volatile void *destino;
+    bool irq0_habilitada;
+    irq_handler_t tratador;
+    bool linha_habilitada;
+    uint32_t pendentes;              // Bits de irq0 por canal, como INTS0
+
+    // Transferência em andamento
+    bool ativa;
+    const uint32_t *origem;
+    uint transferencias;
+    uint64_t fim_us;                 // Quando a última palavra entra na FIFO
+    uint32_t transferencias_iniciadas;
+} dma;
+
+uint64_t time_us_64(void) {
+    return dma.agora_us;
+}
+
+// Interrupções que venceram até o instante atual
+static void atender(void) {
+    if (dma.ativa && dma.agora_us >= dma.fim_us) {
+        dma.ativa = false;
+        if (dma.irq0_habilitada) dma.pendentes |= 1u << CANAL;
+    }
+    if (dma.pendentes && dma.linha_habilitada && dma.tratador) dma.tratador();
+}
+
+static void avancar_ate(uint64_t instante_us) {
+    dma.agora_us = instante_us;
+    atender();
+}
+
+void tight_loop_contents(void) {
+    avancar_ate(dma.agora_us + 1);
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t prioridade) {
+    (void)prioridade;
+    if (num == DMA_IRQ_0) dma.tratador = handler;
+}
+
+void irq_set_enabled(uint num, bool habilitar) {
+    if (num == DMA_IRQ_0) dma.linha_habilitada = habilitar;
+}
+
+int dma_claim_unused_channel(bool obrigatorio) {
+    (void)obrigatorio;
+    dma.canal_reservado = true;
+    return CANAL;
+}
+
+dma_channel_config dma_channel_get_default_config(uint canal) {
+    (void)canal;
+    return (dma_channel_config){.tamanho = DMA_SIZE_32, .incrementa_leitura = true, .incrementa_escrita = true};
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size tamanho) {
+    c->tamanho = tamanho;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incrementa) {
+    c->incrementa_leitura = incrementa;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incrementa) {
+    c->incrementa_escrita = incrementa;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = dreq;
+}
+
+void dma_channel_configure(uint canal, const dma_channel_config *c, volatile void *destino, const volatile void *origem,
+                           uint transferencias, bool iniciar) {
+    (void)origem;
+    (void)transferencias;
+    (void)iniciar;
+    if (canal != CANAL) return;
+    dma.config = *c;
+    dma.destino = destino;
+}
+
+void dma_channel_set_irq0_enabled(uint canal, bool habilitar) {
+    if (canal == CANAL) dma.irq0_habilitada = habilitar;
+}
+
+bool dma_channel_get_irq0_status(uint canal) {
+    return (dma.pendentes >> canal) & 1u;
+}
+
+void dma_channel_acknowledge_irq0(uint canal) {
+    dma.pendentes &= ~(1u << canal);
+}
+
+void dma_channel_transfer_from_buffer_now(uint canal, const volatile void *origem, uint transferencias) {
+    (void)canal;
+    conferir(!dma.ativa, "transferência iniciada com o canal ainda ativo");
+    dma.ativa = true;
+    dma.origem = (const uint32_t *)origem;
+    dma.transferencias = transferencias;
+    dma.fim_us = dma.agora_us + (uint64_t)transferencias * US_POR_PALAVRA;
+    dma.transferencias_iniciadas++;
+}
+
+// ----- Conferências -----
+
+static uint32_t chamadas_callback = 0;
+static void *contexto_recebido = NULL;
+
+static void concluido(void *contexto) {
+    chamadas_callback++;
+    contexto_recebido = contexto;
+}
+
+static void conferir_configuracao(pio_hw_t *pio) {
+    conferir(dma.canal_reservado, "canal DMA não reservado");
+    conferir(dma.config.tamanho == DMA_SIZE_32, "transferência não é de 32 bits");
+    conferir(dma.config.incrementa_leitura && !dma.config.incrementa_escrita, "incrementos do canal");
+    conferir(dma.config.dreq == pio_get_dreq(pio, SM, true), "canal não é pautado pelo DREQ de TX da state machine");
+    conferir(dma.destino == &pio->txf[SM], "canal não escreve na FIFO TX da state machine");
+    conferir(dma.irq0_habilitada && dma.linha_habilitada && dma.tratador, "interrupção do DMA não habilitada");
+}
+
+static void conferir_envio(void) {
+    static uint32_t frame[NUM_PALAVRAS], outro[NUM_PALAVRAS];
+    int contexto;
+
+    avancar_ate(1000);
+    conferir(!frame_dma_ocupado(), "ocupado antes do primeiro frame");
+    conferir(frame_dma_enviar(frame, NUM_PALAVRAS, concluido, &contexto), "primeiro frame recusado");
+    uint64_t inicio = dma.agora_us, fim = inicio + NUM_PALAVRAS * US_POR_PALAVRA;
+    conferir(dma.origem == frame && dma.transferencias == NUM_PALAVRAS, "transferência com buffer ou tamanho errado");
+    conferir(frame_dma_ocupado(), "livre logo após o envio");
+
+    // Durante a transferência: ocupado, e um segundo frame não inicia outra
+    conferir(!frame_dma_enviar(outro, NUM_PALAVRAS, NULL, NULL), "segundo frame aceito durante a transferência");
+    conferir(dma.transferencias_iniciadas == 1 && dma.origem == frame, "segundo frame alterou a transferência");
+    avancar_ate(fim - 1);
+    conferir(frame_dma_ocupado() && chamadas_callback == 0, "concluído antes da última palavra");
+
+    // Interrupção de outro canal na mesma linha
+    dma.pendentes |= 1u << OUTRO_CANAL;
+    atender();
+    dma.pendentes &= ~(1u << OUTRO_CANAL);
+    conferir(chamadas_callback == 0 && frame_dma_frames_concluidos() == 0, "interrupção de outro canal tratada como conclusão");
+
+    // Conclusão: callback uma vez, com o contexto, e a matriz ainda no latch
+    avancar_ate(fim);
+    conferir(chamadas_callback == 1 && contexto_recebido == &contexto, "callback de conclusão");
+    conferir(frame_dma_frames_concluidos() == 1, "contagem de frames concluídos");
+    conferir(!(dma.pendentes & (1u << CANAL)), "interrupção não reconhecida");
+    conferir(frame_dma_ocupado(), "livre antes do latch");
+    conferir(!frame_dma_enviar(outro, NUM_PALAVRAS, NULL, NULL), "frame aceito durante o latch");
+
+    avancar_ate(fim + FRAME_DMA_LATCH_US - 1);
+    conferir(frame_dma_ocupado(), "latch mais curto que FRAME_DMA_LATCH_US");
+    avancar_ate(fim + FRAME_DMA_LATCH_US);
+    conferir(!frame_dma_ocupado(), "ocupado depois do latch");
+
+    // Sem callback; frame_dma_aguardar volta no instante da liberação
+    conferir(frame_dma_enviar(outro, NUM_PALAVRAS, NULL, NULL), "frame recusado com a matriz livre");
+    conferir(dma.origem == outro && dma.transferencias_iniciadas == 2, "segundo envio não iniciou a transferência");
+    uint64_t liberacao = dma.agora_us + NUM_PALAVRAS * US_POR_PALAVRA + FRAME_DMA_LATCH_US;
+    frame_dma_aguardar();
+    conferir(dma.agora_us == liberacao, "frame_dma_aguardar fora do instante da liberação");
+    conferir(chamadas_callback == 1 && frame_dma_frames_concluidos() == 2, "conclusão sem callback");
+
+    printf("frame de %d palavras: %llu us no DMA + %u us de latch\n", NUM_PALAVRAS,
+           (unsigned long long)(NUM_PALAVRAS * US_POR_PALAVRA), FRAME_DMA_LATCH_US);
+}
+
+// Custo de consultar o estado no laço (frame_dma_ocupado é chamado a cada tentativa de envio)
+static void medir_consulta(void) {
+    const uint32_t repeticoes = 1000000;
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t i = 0; i < repeticoes; i++) bench_consumir(frame_dma_ocupado());
+    bench_relatar("frame_dma_ocupado", bench_ciclos() - c0, bench_ns() - t0, repeticoes);
+}
+
+int main(void) {
+    static pio_hw_t pio;
+
+    frame_dma_init(&pio, SM);
+    conferir_configuracao(&pio);
+    conferir_envio();
+    medir_consulta();
+
+    return bench_resultado();
+}
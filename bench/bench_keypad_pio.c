@@ -0,0 +1,170 @@
+// Programa keypad_varredura (pio_matrix.pio) no emulador de tools/pio_maquina.h, com a
+// configuração de keypad_varredura_program_init e um teclado sem diodos simulado nos pinos da placa:
+// - o side-set de ROW4 codificado como no pioasm (opt, pindirs);
+// - cada uma das 16 teclas, sozinha, chega à FIFO RX e vira o seu bit em keypad_pio_converter, em
+//   até duas varreduras, qualquer que seja o ciclo em que foi pressionada; a soltura entrega 0;
+// - com a leitura estável nada mais é entregue;
+// - o acorde '*' + '5' chega com as duas teclas, e soltar '*' entrega só o '5';
+// - as linhas nunca conduzem nível alto (dreno aberto);
+// - custo de keypad_pio_converter, o trabalho da interrupção por leitura.
+// As teclas de ROW4 ('*', '0', '#' e 'D') só são lidas se o side-set ainda a conduz na leitura.
+//
+// Compilação no host:
+//   gcc -O2 -I.. -I../tools -Isdk_falso -DPIO_MATRIX_PIO='"../pio_matrix.pio"' bench_keypad_pio.c ../tools/pio_maquina.c -o bench_keypad_pio
+
+#include <stdbool.h>
+
+#include "bench.h"
+#include "keypad.h"
+#include "keypad_pio.h"
+#include "pio_maquina.h"
+
+#ifndef PIO_MATRIX_PIO
+#define PIO_MATRIX_PIO "../pio_matrix.pio"
+#endif
+
+#define REPETICOES 10000000
+
+// Instruções de uma varredura sem mudança (de inicio ao .wrap, sem atrasos); uma mudança soma 3
+#define CICLOS_VARREDURA 11
+#define LATENCIA_MAXIMA (2 * CICLOS_VARREDURA + 3)
+
+static const char mapa[DEBOUNCE_NUM_TECLAS] = {'1', '2', '3', 'A', '4', '5', '6', 'B',
+                                               '7', '8', '9', 'C', '*', '0', '#', 'D'};
+static const uint linhas[4] = {ROW1, ROW2, ROW3, ROW4};
+static const uint colunas[4] = {COL1, COL2, COL3, COL4};
+
+// ----- Teclado simulado -----
+
+static uint16_t fechadas = 0;        // Bit linha * 4 + coluna em 1 para cada tecla fechada
+static bool linha_em_alto = false;   // Alguma linha conduziu nível alto
+
+// Colunas com pull-up; uma linha conduzida em nível baixo puxa as colunas das suas teclas fechadas
+static uint32_t entradas(void *contexto, uint32_t pinos, uint32_t dirs) {
+    uint32_t gpio = 0xFFFFFFFFu;
+
+    (void)contexto;
+    for (int r = 0; r < 4; r++) {
+        uint32_t linha = 1u << linhas[r];
+        if (!(dirs & linha)) continue;
+        if (pinos & linha) {
+            linha_em_alto = true;
+            continue;
+        }
+        for (int c = 0; c < 4; c++) {
+            if ((fechadas >> (r * 4 + c)) & 1u) gpio &= ~(1u << colunas[c]);
+        }
+    }
+    return gpio;
+}
+
+// ----- State machine -----
+
+static programa_t programa;
+static config_t config;
+static sm_t sm;
+
+static void reiniciar(void) {
+    // Como keypad_varredura_program_init: ROW3..ROW1 no set, ROW4 no side-set, colunas a partir de COL4
+    config = (config_t){.clkdiv = 1, .limiar_pull = 32, .set_base = ROW3, .set_qtd = 3, .in_base = COL4,
+                        .side_base = ROW4};
+    sm = (sm_t){.programa = &programa, .config = &config, .entradas = entradas};
+    fechadas = 0;
+    linha_em_alto = false;
+}
+
+/**
+ * @brief Executa até ciclos ciclos e devolve quantas leituras chegaram à FIFO RX.
+ *
+ * @param ultima Recebe a última leitura, já convertida.
+ * @param ciclos_ate Recebe em que ciclo chegou a primeira.
+ */
+static uint32_t coletar(uint32_t ciclos, uint16_t *ultima, uint32_t *ciclos_ate) {
+    uint32_t n = 0, leitura;
+
+    for (uint32_t i = 1; i <= ciclos; i++) {
+        pio_ciclo(&sm);
+        while (pio_rx_retirar(&sm, &leitura)) {
+            if (n++ == 0 && ciclos_ate) *ciclos_ate = i;
+            *ultima = keypad_pio_converter(leitura);
+        }
+    }
+    return n;
+}
+
+static void conferir_codificacao(void) {
+    // set pindirs, 0b000 side 1 e mov x, isr side 0: bit 12 habilita o side-set, bit 11 é o valor
+    conferir(programa.side_bits == 1 && programa.side_opt && programa.side_pindirs, ".side_set 1 opt pindirs");
+    conferir(programa.instrucoes[0] == 0xe084, "set sem side-set");
+    conferir(programa.instrucoes[6] == 0xf880, "side 1 codificado errado");
+    conferir(programa.instrucoes[8] == 0xb026, "side 0 codificado errado");
+}
+
+static void conferir_teclas(void) {
+    uint16_t leitura = 0xFFFF;
+    uint32_t ciclos_ate = 0, pior = 0;
+
+    reiniciar();
+    conferir(coletar(2 * CICLOS_VARREDURA, &leitura, NULL) == 1 && leitura == 0, "leitura inicial sem teclas");
+
+    for (int k = 0; k < DEBOUNCE_NUM_TECLAS; k++) {
+        char descricao[48];
+        snprintf(descricao, sizeof(descricao), "tecla %c lida errada", mapa[k]);
+
+        // Cada tecla pressionada num ciclo diferente da varredura
+        coletar((uint32_t)k % CICLOS_VARREDURA, &leitura, NULL);
+        fechadas = (uint16_t)(1u << k);
+        uint32_t n = coletar(4 * CICLOS_VARREDURA, &leitura, &ciclos_ate);
+        conferir(n == 1 && leitura == fechadas, descricao);
+        if (ciclos_ate > pior) pior = ciclos_ate;
+
+        fechadas = 0;
+        snprintf(descricao, sizeof(descricao), "soltura da tecla %c", mapa[k]);
+        conferir(coletar(4 * CICLOS_VARREDURA, &leitura, &ciclos_ate) == 1 && leitura == 0, descricao);
+        if (ciclos_ate > pior) pior = ciclos_ate;
+    }
+    conferir(pior <= LATENCIA_MAXIMA, "leitura atrasada mais de duas varreduras");
+
+    fechadas = 1u << 7;
+    coletar(4 * CICLOS_VARREDURA, &leitura, NULL);
+    conferir(coletar(1000 * CICLOS_VARREDURA, &leitura, NULL) == 0, "leitura repetida sem mudança");
+    conferir(!linha_em_alto, "linha conduzida em nível alto");
+}
+
+static void conferir_acorde(void) {
+    uint16_t leitura = 0;
+    const uint16_t asterisco = 1u << 12, cinco = 1u << 5;
+
+    reiniciar();
+    coletar(2 * CICLOS_VARREDURA, &leitura, NULL);
+
+    fechadas = asterisco;
+    conferir(coletar(4 * CICLOS_VARREDURA, &leitura, NULL) == 1 && leitura == asterisco, "'*' do acorde");
+    fechadas |= cinco;
+    conferir(coletar(4 * CICLOS_VARREDURA, &leitura, NULL) == 1 && leitura == (asterisco | cinco),
+             "acorde '*' + '5' sem as duas teclas");
+    fechadas = cinco;
+    conferir(coletar(4 * CICLOS_VARREDURA, &leitura, NULL) == 1 && leitura == cinco, "soltura de '*' no acorde");
+    conferir(!linha_em_alto, "linha conduzida em nível alto no acorde");
+}
+
+static void medir(void) {
+    volatile uint32_t leitura = 0xEFFF;
+    uint32_t soma = 0;
+
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t i = 0; i < REPETICOES; i++) soma += keypad_pio_converter(leitura);
+    bench_relatar("keypad_pio_converter", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+    conferir(soma == REPETICOES * (1u << 3), "conversão medida");
+}
+
+int main(void) {
+    pio_montar(PIO_MATRIX_PIO, "keypad_varredura", &programa);
+
+    conferir_codificacao();
+    conferir_teclas();
+    conferir_acorde();
+    medir();
+
+    return bench_resultado();
+}
@@ -0,0 +1,165 @@
+// Tabela de layout (layout.h):
+// - conferência de todos os layouts: cada combinação de fiação, rotação, espelhamentos e mosaico
+//   precisa ser uma permutação da cadeia, com as propriedades geométricas esperadas;
+// - a placa (LAYOUT_PLACA) reproduz a serpentina a partir do canto inferior direito;
+// - custo de codificar um frame gravando na ordem da cadeia contra gravar pela tabela.
+//
+// Compilação no host:
+//   gcc -O2 -I.. bench_layout.c ../layout.c ../cor.c -o bench_layout
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "bench.h"
+#include "cor.h"
+#include "layout.h"
+
+#define REPETICOES 200000
+
+// conferir de bench.h seguido da configuração em que a condição falhou
+static void conferir_config(bool condicao, const char *descricao, const layout_config_t *c) {
+    conferir(condicao, descricao);
+    if (condicao) return;
+    printf("  painel %ux%u, %s, rotação %u, espelhos %d%d, mosaico %ux%u %s\n",
+           c->largura, c->altura, c->fiacao == LAYOUT_SERPENTINA ? "serpentina" : "linhas", c->rotacao,
+           c->espelhar_x, c->espelhar_y, c->paineis_x, c->paineis_y,
+           c->fiacao_paineis == LAYOUT_SERPENTINA ? "serpentina" : "linhas");
+}
+
+// Índice na cadeia esperado para o pixel lógico (x, y), calculado de forma independente:
+// a imagem é espelhada e girada um quarto de volta por vez, com as dimensões trocando a cada giro
+static uint32_t esperado(const layout_config_t *c, uint32_t x, uint32_t y) {
+    uint32_t lw = (c->rotacao & 1) ? c->altura : c->largura;
+    uint32_t lh = (c->rotacao & 1) ? c->largura : c->altura;
+    uint32_t painel_x = x / lw, painel_y = y / lh;
+    uint32_t px = x % lw, py = y % lh, w = lw, h = lh;
+
+    if (c->espelhar_x) px = w - 1 - px;
+    if (c->espelhar_y) py = h - 1 - py;
+    for (uint32_t r = 0; r < c->rotacao; r++) {
+        // Um quarto de volta no sentido horário: (x, y) -> (h - 1 - y, x) numa imagem h x w
+        uint32_t nx = h - 1 - py, ny = px;
+        px = nx;
+        py = ny;
+        uint32_t t = w;
+        w = h;
+        h = t;
+    }
+    if (c->fiacao == LAYOUT_SERPENTINA && (py & 1)) px = w - 1 - px;
+    if (c->fiacao_paineis == LAYOUT_SERPENTINA && (painel_y & 1)) painel_x = c->paineis_x - 1 - painel_x;
+    return (painel_y * c->paineis_x + painel_x) * w * h + py * w + px;
+}
+
+static void conferir_layout(const layout_config_t *c) {
+    static layout_t l;
+    bool usado[LAYOUT_MAX_PIXELS];
+
+    if (!layout_montar(&l, c)) {
+        conferir_config(false, "configuração recusada", c);
+        return;
+    }
+    uint32_t lw = (c->rotacao & 1) ? c->altura : c->largura;
+    uint32_t lh = (c->rotacao & 1) ? c->largura : c->altura;
+    conferir_config(l.largura == lw * c->paineis_x && l.altura == lh * c->paineis_y, "dimensões lógicas", c);
+    conferir_config(l.num_pixels == l.largura * l.altura, "número de pixels", c);
+
+    memset(usado, 0, sizeof(usado));
+    bool permutacao = true, coerente = true;
+    for (uint32_t y = 0; y < l.altura; y++) {
+        for (uint32_t x = 0; x < l.largura; x++) {
+            uint16_t f = layout_fisico(&l, (uint16_t)x, (uint16_t)y);
+            if (f >= l.num_pixels || usado[f]) permutacao = false;
+            else usado[f] = true;
+            if (f != esperado(c, x, y)) coerente = false;
+        }
+    }
+    conferir_config(permutacao, "a tabela não é uma permutação da cadeia", c);
+    conferir_config(coerente, "posição diferente da rotação passo a passo", c);
+}
+
+// Codificação de um frame lógico: direto na ordem da cadeia ou pela tabela do layout
+static void codificar_direto(const uint8_t *rgb, uint32_t num_pixels, uint32_t *frame) {
+    for (uint32_t i = 0; i < num_pixels; i++, rgb += 3) frame[i] = cor_grb(rgb[0], rgb[1], rgb[2]);
+}
+
+static void codificar_layout(const layout_t *l, const uint8_t *rgb, uint32_t *frame) {
+    for (uint32_t i = 0; i < l->num_pixels; i++, rgb += 3) frame[l->fisico[i]] = cor_grb(rgb[0], rgb[1], rgb[2]);
+}
+
+static void medir(const char *nome, const layout_config_t *c) {
+    static layout_t l;
+    static uint8_t rgb[LAYOUT_MAX_PIXELS * 3];
+    static uint32_t frame[LAYOUT_MAX_PIXELS];
+    char rotulo[64];
+
+    layout_montar(&l, c);
+    for (uint32_t i = 0; i < sizeof(rgb); i++) rgb[i] = (uint8_t)(i * 37u);
+
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES; n++) {
+        rgb[0] = (uint8_t)n;
+        codificar_direto(rgb, l.num_pixels, frame);
+        bench_consumir(frame[n % l.num_pixels]);
+    }
+    snprintf(rotulo, sizeof(rotulo), "%s, na cadeia", nome);
+    bench_relatar(rotulo, bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+
+    c0 = bench_ciclos(); t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES; n++) {
+        rgb[0] = (uint8_t)n;
+        codificar_layout(&l, rgb, frame);
+        bench_consumir(frame[n % l.num_pixels]);
+    }
+    snprintf(rotulo, sizeof(rotulo), "%s, pela tabela", nome);
+    bench_relatar(rotulo, bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+}
+
+int main(void) {
+    static const uint8_t paineis[][2] = {{5, 5}, {8, 4}, {3, 7}, {1, 6}};
+    static const uint8_t mosaicos[][2] = {{1, 1}, {2, 1}, {1, 3}, {3, 2}};
+    uint32_t conferidos = 0;
+
+    cor_set_brilho(COR_BRILHO_PADRAO);
+
+    for (uint32_t p = 0; p < sizeof(paineis) / sizeof(paineis[0]); p++) {
+        for (uint32_t m = 0; m < sizeof(mosaicos) / sizeof(mosaicos[0]); m++) {
+            for (uint32_t variante = 0; variante < 2 * 4 * 4 * 2; variante++) {
+                layout_config_t c = {
+                    .largura = paineis[p][0], .altura = paineis[p][1],
+                    .fiacao = (layout_fiacao_t)(variante & 1), .rotacao = (uint8_t)((variante >> 1) & 3),
+                    .espelhar_x = (variante >> 3) & 1, .espelhar_y = (variante >> 4) & 1,
+                    .paineis_x = mosaicos[m][0], .paineis_y = mosaicos[m][1],
+                    .fiacao_paineis = (layout_fiacao_t)((variante >> 5) & 1),
+                };
+                conferir_layout(&c);
+                conferidos++;
+            }
+        }
+    }
+    printf("%u layouts conferidos\n", conferidos);
+
+    // Placa: serpentina que começa no canto inferior direito, como a fiação da BitDogLab
+    layout_t placa;
+    layout_config_t config_placa = LAYOUT_PLACA;
+    bool placa_ok = layout_montar(&placa, &config_placa);
+    for (uint32_t l = 0; l < 5; l++) {
+        for (uint32_t c = 0; c < 5; c++) {
+            placa_ok &= layout_fisico(&placa, (uint16_t)c, (uint16_t)l) == 24 - (l * 5 + ((l & 1) ? 4 - c : c));
+        }
+    }
+    conferir_config(placa_ok, "LAYOUT_PLACA fora da serpentina da placa", &config_placa);
+
+    // Configurações inválidas
+    layout_config_t grande = {.largura = 16, .altura = 16, .paineis_x = 2, .paineis_y = 1};
+    layout_t descartado;
+    conferir_config(!layout_montar(&descartado, &grande), "mosaico acima de LAYOUT_MAX_PIXELS aceito", &grande);
+    layout_config_t girado = {.largura = 5, .altura = 5, .rotacao = 4, .paineis_x = 1, .paineis_y = 1};
+    conferir_config(!layout_montar(&descartado, &girado), "rotação acima de 3 aceita", &girado);
+
+    medir("5x5 (placa)", &config_placa);
+    layout_config_t mosaico = {.largura = 8, .altura = 8, .fiacao = LAYOUT_SERPENTINA, .rotacao = 1,
+                               .paineis_x = 2, .paineis_y = 2, .fiacao_paineis = LAYOUT_SERPENTINA};
+    medir("16x16 (mosaico 2x2)", &mosaico);
+
+    return bench_resultado();
+}
@@ -0,0 +1,106 @@
+// Pontilhado temporal (pontilhado.h):
+// - custo de gerar um frame pontilhado de 25 pixels e passá-lo pelo framebuffer, comparado ao
+//   orçamento de um tick de animação (ANIM_TICK_MS = 2 ms a 128 MHz);
+// - fidelidade: média dos níveis exibidos em 256 frames contra o valor de 16 bits pedido;
+// - faixas: quantos níveis distintos chegam ao LED entre 0 e 20% de intensidade, com e sem pontilhado;
+// - como gerador, a sequência termina depois de um frame quando nenhum canal tem fração e continua
+//   enquanto houver fração a pontilhar.
+//
+// Compilação no host:
+//   gcc -O2 -I.. bench_pontilhado.c ../pontilhado.c ../framebuffer.c ../cor.c -o bench_pontilhado
+
+#include <stdlib.h>
+
+#include "bench.h"
+#include "cor.h"
+#include "framebuffer.h"
+#include "pontilhado.h"
+
+#define NUM_PIXELS 25
+#define REPETICOES 200000
+
+// Tick das animações no firmware e clock do sistema
+#define TICK_US 2000u
+#define CLOCK_MHZ 128u
+
+// Tempo de um frame no fio: 24 bits de 1,25 µs por LED e a pausa de reset
+#define FRAME_FIO_US (NUM_PIXELS * 30u + 50u)
+
+static bool saida_nula(const uint32_t *frame) {
+    bench_consumir(frame[0]);
+    return true;
+}
+
+int main(void) {
+    static pontilhado_t p;
+    uint32_t frame[NUM_PIXELS];
+
+    cor_set_brilho(COR_BRILHO_PADRAO);
+    fb_init(saida_nula, NUM_PIXELS);
+
+    // Branco a 20% (tecla '#'), o caso em que os níveis inteiros mais aparecem
+    pontilhado_init(&p, NUM_PIXELS, 2);
+    pontilhado_preencher(&p, 51, 51, 51);
+
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES; n++) {
+        pontilhado_quadro(&p, frame);
+        bench_consumir(frame[n % NUM_PIXELS]);
+    }
+    uint64_t ns_quadro = bench_ns() - t0;
+    bench_relatar("pontilhar / frame", bench_ciclos() - c0, ns_quadro, REPETICOES);
+
+    c0 = bench_ciclos(); t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES; n++) {
+        pontilhado_quadro(&p, fb_traseiro());
+        fb_apresentar();
+    }
+    uint64_t ns_pipeline = bench_ns() - t0;
+    bench_relatar("pontilhar + framebuffer / frame", bench_ciclos() - c0, ns_pipeline, REPETICOES);
+
+    printf("\norçamento por tick: %u us (%u ciclos a %u MHz); o frame ocupa o fio por %u us\n",
+           TICK_US, TICK_US * CLOCK_MHZ, CLOCK_MHZ, FRAME_FIO_US);
+    printf("pipeline no host: %.3f us/frame = %.3f%% do tick\n",
+           ns_pipeline / 1000.0 / REPETICOES, 100.0 * ns_pipeline / 1000.0 / REPETICOES / TICK_US);
+
+    // Fidelidade: um pixel, 256 frames por nível (um ciclo completo do acumulador)
+    uint32_t pior = 0, pior_nivel = 0;
+    for (uint32_t v = 0; v <= 0xFF00; v += 7) {
+        pontilhado_init(&p, 1, 2);
+        pontilhado_definir(&p, 0, (uint16_t)v, 0, 0);
+        uint32_t soma = 0;
+        for (int q = 0; q < 256; q++) {
+            pontilhado_quadro(&p, frame);
+            soma += (frame[0] >> 16) & 0xFF;
+        }
+        uint32_t erro = (uint32_t)abs((int)soma - (int)v);
+        if (erro > pior) {
+            pior = erro;
+            pior_nivel = v;
+        }
+    }
+    printf("fidelidade: maior erro da média em 256 frames = %u/256 de nível (em 0x%04x)\n", pior, pior_nivel);
+
+    // Faixas: níveis distintos para entradas de 0 a 51 (0 a 20%)
+    uint32_t distintos8 = 0, distintos16 = 0;
+    for (int i = 0; i <= 51; i++) {
+        if (i == 0 || cor_lut[i] != cor_lut[i - 1]) distintos8++;
+        if (i == 0 || cor_lut16[i] != cor_lut16[i - 1]) distintos16++;
+    }
+    printf("faixas de 0 a 20%%: %u níveis distintos em 8 bits, %u com pontilhado\n", distintos8, distintos16);
+
+    // Gerador: cor em níveis inteiros termina no segundo passo; com fração, segue renovando
+    uint32_t duracao, passos_inteiro = 0, passos_fracao = 0;
+    pontilhado_init(&p, NUM_PIXELS, 2);
+    for (uint32_t i = 0; i < NUM_PIXELS; i++) pontilhado_definir(&p, (uint16_t)i, 0x9C00, 0, 0x0700);
+    while (passos_inteiro < 1000 && pontilhado_gerar(&p, passos_inteiro, frame, &duracao)) passos_inteiro++;
+    pontilhado_preencher(&p, 51, 51, 51);
+    while (passos_fracao < 1000 && pontilhado_gerar(&p, passos_fracao, frame, &duracao)) passos_fracao++;
+    bool termina = passos_inteiro == 1 && passos_fracao == 1000 && pontilhado_fracionario(&p);
+    printf("%s: gerador com níveis inteiros termina após %u frame(s); com fração, %u frames sem terminar\n",
+           termina ? "ok" : "FALHA", passos_inteiro, passos_fracao);
+
+    bool cabe = ns_pipeline / REPETICOES < (uint64_t)TICK_US * 1000u / 100u;
+    printf("%s: o pipeline usa menos de 1%% do tick no host\n", cabe ? "ok" : "FALHA");
+    return cabe && termina ? 0 : 1;
+}
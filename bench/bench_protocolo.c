@@ -0,0 +1,114 @@
+// Vazão e latência do analisador do protocolo serial (protocolo.c).
+// 1) Custo do analisador por byte, com pacotes já em memória.
+// 2) Um produtor envia frames de 25 pixels por um pipe (como o PC pela serial) e o consumidor os
+//    lê em blocos de 64 bytes, como stream_processar; mede frames/s e a latência do envio ao callback.
+// Também confere que um pacote corrompido é descartado e o seguinte é aceito.
+//
+// Compilação no host:
+//   gcc -O2 -pthread -I.. bench_protocolo.c ../protocolo.c -o bench_protocolo
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "protocolo.h"
+
+#define NUM_PIXELS 25
+#define PACOTE PROTO_TAMANHO_PACOTE(NUM_PIXELS)
+#define PACOTES_MEMORIA 4096
+#define REPETICOES 50
+#define FRAMES_PIPE 20000
+#define BLOCO 64
+
+static uint8_t pacotes[PACOTES_MEMORIA * PACOTE];
+static uint64_t enviado_ns[FRAMES_PIPE];
+static uint64_t latencia_ns[FRAMES_PIPE];
+static uint32_t frames_recebidos;
+static int pipe_fd[2];
+
+static void frame_recebido(const uint8_t *rgb, uint32_t num_pixels, uint8_t seq) {
+    if (frames_recebidos < FRAMES_PIPE) {
+        latencia_ns[frames_recebidos] = bench_ns() - enviado_ns[frames_recebidos];
+    }
+    frames_recebidos++;
+    bench_consumir(rgb[seq % (num_pixels * 3)]);
+}
+
+static void *produtor(void *arg) {
+    uint8_t rgb[NUM_PIXELS * 3], pacote[PACOTE];
+
+    (void)arg;
+    for (uint32_t q = 0; q < FRAMES_PIPE; q++) {
+        memset(rgb, (int)q, sizeof(rgb));
+        uint32_t n = proto_codificar(pacote, (uint8_t)q, true, 0, NUM_PIXELS, rgb);
+        enviado_ns[q] = bench_ns();
+        if (write(pipe_fd[1], pacote, n) != (ssize_t)n) break;
+    }
+    close(pipe_fd[1]);
+    return NULL;
+}
+
+static int comparar(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int main(void) {
+    uint8_t rgb[NUM_PIXELS * 3];
+    proto_estatisticas_t e;
+
+    // Ressincronização: um byte alterado invalida o CRC só daquele pacote
+    memset(rgb, 0x40, sizeof(rgb));
+    proto_init(NUM_PIXELS, frame_recebido);
+    uint32_t n = proto_codificar(pacotes, 0, true, 0, NUM_PIXELS, rgb);
+    n += proto_codificar(pacotes + n, 1, true, 0, NUM_PIXELS, rgb);
+    pacotes[20] ^= 0xFF;
+    proto_alimentar(pacotes, n);
+    proto_obter_estatisticas(&e);
+    if (e.frames != 1 || e.erros_crc != 1) {
+        printf("ressincronização falhou: %u frames, %u erros de CRC\n", (unsigned)e.frames, (unsigned)e.erros_crc);
+        return 1;
+    }
+
+    // 1) Analisador sobre pacotes em memória
+    n = 0;
+    for (uint32_t q = 0; q < PACOTES_MEMORIA; q++) {
+        n += proto_codificar(pacotes + n, (uint8_t)q, true, 0, NUM_PIXELS, rgb);
+    }
+    proto_init(NUM_PIXELS, frame_recebido);
+    frames_recebidos = FRAMES_PIPE;   // Não registra latência nesta etapa
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (int r = 0; r < REPETICOES; r++) {
+        proto_alimentar(pacotes, n);
+    }
+    uint64_t ciclos = bench_ciclos() - c0, ns = bench_ns() - t0;
+    bench_relatar("analisador / pacote de 25 pixels", ciclos, ns, PACOTES_MEMORIA * REPETICOES);
+    printf("%-32s %10.2f ciclos/byte %10.1f MB/s\n", "analisador / byte", (double)ciclos / ((double)n * REPETICOES),
+           (double)n * REPETICOES / (ns / 1e9) / 1e6);
+
+    // 2) Produtor e consumidor ligados por um pipe
+    if (pipe(pipe_fd) != 0) return 1;
+    proto_init(NUM_PIXELS, frame_recebido);
+    frames_recebidos = 0;
+    pthread_t thread;
+    t0 = bench_ns();
+    pthread_create(&thread, NULL, produtor, NULL);
+
+    uint8_t bloco[BLOCO];
+    ssize_t lidos;
+    while ((lidos = read(pipe_fd[0], bloco, sizeof(bloco))) > 0) {
+        proto_alimentar(bloco, (uint32_t)lidos);
+    }
+    pthread_join(thread, NULL);
+    ns = bench_ns() - t0;
+
+    proto_obter_estatisticas(&e);
+    qsort(latencia_ns, frames_recebidos, sizeof(uint64_t), comparar);
+    printf("pipe: %u de %u frames em %.1f ms: %.0f frames/s; latência p50 %.1f µs, p99 %.1f µs; %u erros\n",
+           (unsigned)frames_recebidos, FRAMES_PIPE, ns / 1e6, frames_recebidos / (ns / 1e9),
+           latencia_ns[frames_recebidos / 2] / 1e3, latencia_ns[frames_recebidos * 99 / 100] / 1e3,
+           (unsigned)(e.erros_crc + e.erros_formato + e.perdidos));
+    return frames_recebidos == FRAMES_PIPE ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+// Custo por frame de tocar um passo das animações das teclas '1' e '9':
+// - codificação em double por pixel (como as funções tecla_1/tecla_9 originais);
+// - codificação por tabela (cor_grb) a partir de um desenho de 8 bits;
+// - reprodução de um frame pré-codificado em flash, que é só uma cópia de bloco.
+//
+// Compilação no host:
+//   gcc -O2 -I.. bench_quadros.c ../cor.c -o bench_quadros
+
+#include <string.h>
+
+#include "bench.h"
+#include "cor.h"
+
+#define NUM_PIXELS 25
+#define REPETICOES 200000
+
+// Mesmo desenho do "X" da tecla '1'
+static const uint8_t desenho_x[NUM_PIXELS] = {
+    255,   0,   0,   0, 255,
+      0, 255,   0, 255,   0,
+      0,   0, 255,   0,   0,
+      0, 255,   0, 255,   0,
+    255,   0,   0,   0, 255
+};
+
+int main(void) {
+    volatile double desenho_d[NUM_PIXELS];
+    static uint32_t pre_codificado[NUM_PIXELS];
+    uint32_t frame[NUM_PIXELS];
+
+    cor_set_brilho(COR_BRILHO_PADRAO);
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        desenho_d[i] = desenho_x[i] / 255.0;
+        pre_codificado[i] = cor_grb(desenho_x[i], desenho_x[i], desenho_x[i]);
+    }
+
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES; n++) {
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            frame[i] = matrix_rgb_double(desenho_d[i], desenho_d[i], desenho_d[i]);
+        }
+        bench_consumir(frame[n % NUM_PIXELS]);
+    }
+    bench_relatar("codificar (double) / frame", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+
+    c0 = bench_ciclos(); t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES; n++) {
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            uint8_t v = ((volatile const uint8_t *)desenho_x)[i];
+            frame[i] = cor_grb(v, v, v);
+        }
+        bench_consumir(frame[n % NUM_PIXELS]);
+    }
+    bench_relatar("codificar (cor_grb) / frame", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+
+    c0 = bench_ciclos(); t0 = bench_ns();
+    for (uint32_t n = 0; n < REPETICOES; n++) {
+        memcpy(frame, (const uint32_t *)((volatile const uint32_t *)pre_codificado), sizeof(frame));
+        __asm__ volatile("" : : "r"(frame) : "memory");
+        bench_consumir(frame[n % NUM_PIXELS]);
+    }
+    bench_relatar("pré-codificado (cópia) / frame", bench_ciclos() - c0, bench_ns() - t0, REPETICOES);
+
+    // No firmware o passo é essa cópia para o framebuffer (fb_enviar); o DMA leva o frame à FIFO
+    return 0;
+}
@@ -0,0 +1,252 @@
+// Roteiros de animação em bytecode (roteiro.h):
+// - conferência do interpretador: preenchimento, glifo, esmaecimento (número de frames e nível
+//   final), blocos de ROT_REPETIR simples, aninhados e sem fim;
+// - roteiro_validar recusando programas malformados, o interpretador terminando nos mesmos
+//   programas sem validação e num laço que nunca entrega frame;
+// - ida e volta de um roteiro pelo protocolo da serial (PROTO_TIPO_ROTEIRO);
+// - custo do despacho por instrução e de um frame de ROT_ESPERAR, ROT_GLIFO e ROT_ESMAECER na
+//   matriz 5x5 e num mosaico 16x16 (256 LEDs), comparado ao orçamento de um tick de animação.
+//
+// Compilação no host:
+//   gcc -O2 -I.. bench_roteiro.c ../roteiro.c ../fonte.c ../layout.c ../cor.c ../protocolo.c -o bench_roteiro
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "bench.h"
+#include "cor.h"
+#include "fonte.h"
+#include "layout.h"
+#include "protocolo.h"
+#include "roteiro.h"
+
+#define REPETICOES 100000
+
+// Tick das animações no firmware
+#define TICK_US 2000u
+
+static uint32_t frame[LAYOUT_MAX_PIXELS];
+
+// Frames entregues por um roteiro até terminar (ou até limite)
+static uint32_t contar_frames(const uint8_t *codigo, uint16_t tamanho, uint32_t limite) {
+    roteiro_t r;
+    uint32_t duracao, n = 0;
+
+    roteiro_init(&r, codigo, tamanho);
+    while (n < limite && roteiro_gerar(&r, n, frame, &duracao)) n++;
+    return n;
+}
+
+static void conferir_desenho(void) {
+    static const uint8_t preencher[] = {ROT_COR(10, 20, 30), ROT_PREENCHER, ROT_ESPERAR(700), ROT_FIM};
+    static const uint8_t glifo[] = {ROT_COR(255, 255, 255), ROT_GLIFO('1'), ROT_ESPERAR(0), ROT_FIM};
+    roteiro_t r;
+    uint32_t duracao = 0;
+    bool iguais = true;
+
+    roteiro_init(&r, preencher, sizeof(preencher));
+    conferir(roteiro_gerar(&r, 0, frame, &duracao) && duracao == 700, "ROT_ESPERAR não entregou o frame");
+    for (uint32_t i = 0; i < layout_matriz.num_pixels; i++) iguais &= frame[i] == cor_grb(10, 20, 30);
+    conferir(iguais, "ROT_PREENCHER diferente de cor_grb");
+    conferir(!roteiro_gerar(&r, 1, frame, &duracao), "ROT_FIM não terminou o roteiro");
+
+    roteiro_init(&r, glifo, sizeof(glifo));
+    roteiro_gerar(&r, 0, frame, &duracao);
+    uint32_t g = fonte_glifo('1');
+    iguais = true;
+    for (uint32_t l = 0; l < FONTE_ALTURA; l++) {
+        for (uint32_t c = 0; c < FONTE_LARGURA; c++) {
+            bool aceso = (g >> (FONTE_PIXELS - 1 - (l * FONTE_LARGURA + c))) & 1u;
+            uint32_t esperado = aceso ? cor_grb(255, 255, 255) : cor_grb(0, 0, 0);
+            iguais &= frame[layout_matriz.fisico[l * layout_matriz.largura + c]] == esperado;
+        }
+    }
+    conferir(iguais, "ROT_GLIFO diferente de fonte_glifo");
+}
+
+static void conferir_esmaecimento(void) {
+    static const uint8_t programa[] = {ROT_COR(200, 200, 200), ROT_PREENCHER, ROT_NIVEL(0),
+                                       ROT_ESMAECER(255, 10, 5), ROT_ESMAECER(40, 7, 3), ROT_FIM};
+    roteiro_t r;
+    uint32_t duracao, anterior = 0, passo = 0;
+    bool subindo = true, duracoes = true;
+
+    roteiro_init(&r, programa, sizeof(programa));
+    for (; passo < 10; passo++) {
+        roteiro_gerar(&r, passo, frame, &duracao);
+        uint32_t verde = frame[0] >> 24;
+        subindo &= passo == 0 || verde >= anterior;
+        duracoes &= duracao == 5;
+        anterior = verde;
+    }
+    conferir(subindo && duracoes, "esmaecimento para cima fora de ordem ou da duração");
+    conferir(frame[0] == cor_grb(200, 200, 200), "esmaecimento não chegou ao nível 255");
+
+    for (; passo < 17; passo++) roteiro_gerar(&r, passo, frame, &duracao);
+    conferir(r.nivel_q8 == 40u << 8 && duracao == 3, "esmaecimento para baixo não parou no alvo");
+    conferir(!roteiro_gerar(&r, passo, frame, &duracao), "esmaecimento entregou frames a mais");
+}
+
+static void conferir_repeticoes(void) {
+    static const uint8_t simples[] = {ROT_REPETIR(3), ROT_ESPERAR(1), ROT_VOLTAR, ROT_FIM};
+    static const uint8_t aninhado[] = {ROT_REPETIR(2), ROT_ESPERAR(1), ROT_REPETIR(3), ROT_ESPERAR(1),
+                                       ROT_VOLTAR, ROT_VOLTAR, ROT_ESPERAR(1)};
+    static const uint8_t sem_fim[] = {ROT_REPETIR(0), ROT_ESPERAR(1), ROT_VOLTAR};
+
+    conferir(contar_frames(simples, sizeof(simples), 100) == 3, "ROT_REPETIR(3) não entregou 3 frames");
+    conferir(contar_frames(aninhado, sizeof(aninhado), 100) == 2 * (1 + 3) + 1, "blocos aninhados contados errado");
+    conferir(contar_frames(sem_fim, sizeof(sem_fim), 10000) == 10000, "ROT_REPETIR(0) terminou");
+}
+
+static void conferir_validacao(void) {
+    static const uint8_t valido[] = {ROT_COR(1, 2, 3), ROT_REPETIR(2), ROT_PREENCHER, ROT_ESPERAR(10), ROT_VOLTAR};
+    static const uint8_t desconhecido[] = {ROT_PREENCHER, 0x77, ROT_ESPERAR(1)};
+    static const uint8_t incompleto[] = {ROT_PREENCHER, ROT_ESPERAR(1), ROT_OP_COR, 1};
+    static const uint8_t aberto[] = {ROT_REPETIR(2), ROT_ESPERAR(1)};
+    static const uint8_t fechado_a_mais[] = {ROT_ESPERAR(1), ROT_VOLTAR, ROT_ESPERAR(1)};
+    static const uint8_t fundo_demais[] = {ROT_REPETIR(2), ROT_REPETIR(2), ROT_REPETIR(2), ROT_REPETIR(2),
+                                           ROT_REPETIR(2), ROT_ESPERAR(1), ROT_VOLTAR, ROT_VOLTAR,
+                                           ROT_VOLTAR, ROT_VOLTAR, ROT_VOLTAR};
+    static const uint8_t travado[] = {ROT_REPETIR(0), ROT_COR(1, 2, 3), ROT_VOLTAR};
+    static uint8_t grande[ROTEIRO_MAX_BYTES + 1];
+
+    conferir(roteiro_validar(valido, sizeof(valido)), "programa válido recusado");
+    conferir(!roteiro_validar(desconhecido, sizeof(desconhecido)), "código desconhecido aceito");
+    conferir(!roteiro_validar(incompleto, sizeof(incompleto)), "operandos incompletos aceitos");
+    conferir(!roteiro_validar(aberto, sizeof(aberto)), "ROT_REPETIR sem ROT_VOLTAR aceito");
+    conferir(!roteiro_validar(fechado_a_mais, sizeof(fechado_a_mais)), "ROT_VOLTAR sem ROT_REPETIR aceito");
+    conferir(!roteiro_validar(fundo_demais, sizeof(fundo_demais)), "blocos além de ROTEIRO_MAX_LACOS aceitos");
+    memset(grande, ROT_OP_PREENCHER, sizeof(grande));
+    conferir(!roteiro_validar(grande, sizeof(grande)), "programa além de ROTEIRO_MAX_BYTES aceito");
+
+    // Sem validação, o interpretador entrega o que vem antes do erro e termina nele
+    conferir(contar_frames(desconhecido, sizeof(desconhecido), 100) == 0, "código desconhecido executado");
+    conferir(contar_frames(incompleto, sizeof(incompleto), 100) == 1, "operandos incompletos executados");
+    conferir(contar_frames(fechado_a_mais, sizeof(fechado_a_mais), 100) == 1, "ROT_VOLTAR sem bloco executado");
+    conferir(contar_frames(fundo_demais, sizeof(fundo_demais), 100) == 0, "pilha de blocos estourada");
+    conferir(contar_frames(travado, sizeof(travado), 100) == 0, "laço sem frame não foi interrompido");
+}
+
+static struct {
+    uint32_t chamadas;
+    char tecla;
+    uint8_t evento;
+    uint8_t codigo[ROTEIRO_MAX_BYTES];
+    uint32_t tamanho;
+} recebido;
+
+static void roteiro_recebido(char tecla, uint8_t evento, const uint8_t *codigo, uint32_t tamanho) {
+    recebido.chamadas++;
+    recebido.tecla = tecla;
+    recebido.evento = evento;
+    recebido.tamanho = tamanho;
+    memcpy(recebido.codigo, codigo, tamanho);
+}
+
+static void frame_recebido(const uint8_t *rgb, uint32_t num_pixels, uint8_t seq) {
+    (void)rgb;
+    (void)num_pixels;
+    (void)seq;
+}
+
+static void conferir_protocolo(void) {
+    static const uint8_t programa[] = {ROT_COR(0, 0, 255), ROT_PREENCHER, ROT_REPETIR(0),
+                                       ROT_ESMAECER(255, 40, 20), ROT_ESMAECER(16, 40, 20), ROT_VOLTAR};
+    uint8_t pacote[PROTO_CABECALHO + sizeof(programa) + 2];
+
+    proto_init(25, frame_recebido);
+    proto_roteiros(roteiro_recebido);
+    uint32_t n = proto_codificar_roteiro(pacote, 0, 'B', 2, programa, sizeof(programa));
+    conferir(n == sizeof(pacote), "tamanho do pacote de roteiro");
+
+    // Em pedaços de 3 bytes, como chegariam pela serial
+    for (uint32_t i = 0; i < n; i += 3) proto_alimentar(&pacote[i], n - i < 3 ? n - i : 3);
+    conferir(recebido.chamadas == 1 && recebido.tecla == 'B' && recebido.evento == 2 &&
+             recebido.tamanho == sizeof(programa) && memcmp(recebido.codigo, programa, sizeof(programa)) == 0,
+             "roteiro diferente do enviado");
+    conferir(roteiro_validar(recebido.codigo, recebido.tamanho), "roteiro recebido não passa na validação");
+
+    n = proto_codificar_roteiro(pacote, 1, 'B', 2, programa, sizeof(programa));
+    pacote[PROTO_CABECALHO + 1] ^= 0x01;
+    proto_alimentar(pacote, n);
+    proto_estatisticas_t e;
+    proto_obter_estatisticas(&e);
+    conferir(recebido.chamadas == 1 && e.erros_crc == 1, "roteiro corrompido entregue");
+}
+
+// Avança o roteiro REPETICOES frames; devolve ns por frame
+static double medir(const uint8_t *codigo, uint16_t tamanho, const char *caso, const char *tamanho_matriz,
+                    uint32_t *instrucoes) {
+    roteiro_t r;
+    uint32_t duracao;
+    char nome[48];
+
+    roteiro_init(&r, codigo, tamanho);
+    roteiro_gerar(&r, 0, frame, &duracao);
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t p = 1; p <= REPETICOES; p++) {
+        roteiro_gerar(&r, p, frame, &duracao);
+        bench_consumir(frame[p % layout_matriz.num_pixels]);
+    }
+    uint64_t ns = bench_ns() - t0;
+    snprintf(nome, sizeof(nome), "%s %s / frame", caso, tamanho_matriz);
+    bench_relatar(nome, bench_ciclos() - c0, ns, REPETICOES);
+    if (instrucoes) *instrucoes = r.instrucoes;
+    return (double)ns / REPETICOES;
+}
+
+static void medir_tamanho(const char *tamanho) {
+    static const uint8_t esperar[] = {ROT_COR(0, 0, 255), ROT_PREENCHER, ROT_REPETIR(0), ROT_ESPERAR(1), ROT_VOLTAR};
+    static const uint8_t glifo[] = {ROT_COR(255, 160, 0), ROT_REPETIR(0), ROT_GLIFO('8'), ROT_ESPERAR(1),
+                                    ROT_VOLTAR};
+    static const uint8_t esmaecer[] = {ROT_COR(0, 0, 255), ROT_PREENCHER, ROT_REPETIR(0), ROT_ESMAECER(255, 250, 1),
+                                       ROT_ESMAECER(0, 250, 1), ROT_VOLTAR};
+
+    double t_esperar = medir(esperar, sizeof(esperar), "ROT_ESPERAR", tamanho, NULL);
+    double t_glifo = medir(glifo, sizeof(glifo), "ROT_GLIFO + ESPERAR", tamanho, NULL);
+    double t_esmaecer = medir(esmaecer, sizeof(esmaecer), "ROT_ESMAECER", tamanho, NULL);
+    printf("  %s: ESPERAR %.3f%% do tick, GLIFO + ESPERAR %.3f%%, ESMAECER %.3f%%\n", tamanho,
+           100.0 * t_esperar / 1000.0 / TICK_US, 100.0 * t_glifo / 1000.0 / TICK_US,
+           100.0 * t_esmaecer / 1000.0 / TICK_US);
+}
+
+// Despacho: ~1000 instruções sem frame para cada ROT_ESPERAR, com a saída numa matriz de 1 pixel
+static void medir_despacho(void) {
+    static const uint8_t programa[] = {
+        ROT_REPETIR(0),
+            ROT_REPETIR(200), ROT_COR(1, 2, 3), ROT_NIVEL(128), ROT_COR(4, 5, 6), ROT_NIVEL(255), ROT_VOLTAR,
+            ROT_ESPERAR(1),
+        ROT_VOLTAR
+    };
+    uint32_t instrucoes;
+
+    layout_definir(&(layout_config_t){.largura = 1, .altura = 1, .fiacao = LAYOUT_LINHAS, .paineis_x = 1,
+                                      .paineis_y = 1});
+    double por_frame = medir(programa, sizeof(programa), "despacho 1003 instruções", "1x1", &instrucoes);
+    conferir(instrucoes / (REPETICOES + 1u) == 1003u, "número de instruções por frame");
+    printf("  despacho: %.2f ns por instrução\n", por_frame * (REPETICOES + 1u) / instrucoes);
+}
+
+int main(void) {
+    cor_set_brilho(COR_BRILHO_PADRAO);
+    layout_definir(&LAYOUT_PLACA);
+    conferir_desenho();
+    conferir_esmaecimento();
+    conferir_repeticoes();
+    conferir_validacao();
+    conferir_protocolo();
+
+    medir_despacho();
+
+    printf("\n");
+    layout_definir(&LAYOUT_PLACA);
+    medir_tamanho("5x5");
+
+    // Mosaico de 2 x 2 painéis 8x8 em serpentina, como em bench_efeitos
+    printf("\n");
+    layout_definir(&(layout_config_t){.largura = 8, .altura = 8, .fiacao = LAYOUT_SERPENTINA,
+                                      .paineis_x = 2, .paineis_y = 2, .fiacao_paineis = LAYOUT_SERPENTINA});
+    medir_tamanho("16x16");
+
+    return bench_resultado();
+}
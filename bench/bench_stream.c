@@ -0,0 +1,278 @@
+// Recepção de frames pela serial (stream.c) com a serial, o relógio e a saída falsos, no mesmo
+// arranjo do firmware: stream_processar no laço principal e, a cada tick, stream_tick decidindo
+// se o escalonador de animações fica suspenso antes de anim_tick.
+// - a serial nunca é lida dentro do tick (contexto de interrupção no firmware);
+// - com uma animação em andamento, os frames da stream não são sobrescritos; a animação retoma
+//   STREAM_POSSE_MS depois do último frame, reexibindo o passo em que parou;
+// - um pedido de animação feito durante a stream toca quando ela termina;
+// - uma imagem mantida (anim_sequencia_t.manter) também cede a matriz à stream e volta a ser
+//   renovada STREAM_POSSE_MS depois do último frame;
+// - sob rajada, STREAM_SEGURAR deixa na serial o que não cabe na fila e STREAM_DESCARTAR lê e descarta;
+// - custo por frame do caminho serial -> analisador -> buffer triplo -> saída.
+//
+// Compilação no host:
+//   gcc -O2 -DPIO_MATRIX_TRACE=0 -DPIO_MATRIX_HOST=1 -I.. bench_stream.c ../stream.c ../protocolo.c ../animacao.c ../fila_spsc.c ../cor.c ../compacta.c ../layout.c -o bench_stream
+
+#include <stdbool.h>
+
+#include "animacao.h"
+#include "bench.h"
+#include "cor.h"
+#include "hal.h"
+#include "layout.h"
+#include "stream.h"
+
+#define NUM_PIXELS 25
+#define PACOTE PROTO_TAMANHO_PACOTE(NUM_PIXELS)
+#define FRAMES_MEDICAO 100000
+
+// ----- Serial, relógio e saída falsos -----
+
+static uint32_t agora_ms = 0;
+static bool em_tick = false;
+static uint32_t leituras = 0, leituras_no_tick = 0;
+
+static uint8_t serial[16384];
+static uint32_t serial_inicio = 0, serial_fim = 0;
+
+uint32_t hal_agora_ms(void) {
+    return agora_ms;
+}
+
+int hal_serial_ler(uint8_t *dados, uint32_t maximo) {
+    uint32_t n = serial_fim - serial_inicio;
+
+    leituras++;
+    if (em_tick) leituras_no_tick++;
+    if (n > maximo) n = maximo;
+    for (uint32_t i = 0; i < n; i++) dados[i] = serial[serial_inicio++];
+    return (int)n;
+}
+
+// Frames entregues à saída: de uma animação (ponteiro para um dos frames abaixo) ou da stream,
+// com o primeiro pixel (os frames gerados chegam no buffer do escalonador)
+typedef struct {
+    const uint32_t *frame;
+    uint32_t instante_ms;
+    uint32_t pixel0;
+} entrega_t;
+
+#define MAX_ENTREGAS 256
+static entrega_t entregas[MAX_ENTREGAS];
+static uint32_t num_entregas = 0;
+
+static bool saida(const uint32_t *frame) {
+    if (num_entregas < MAX_ENTREGAS) entregas[num_entregas++] = (entrega_t){frame, agora_ms, frame[0]};
+    return true;
+}
+
+static uint32_t relogio(void) {
+    return agora_ms;
+}
+
+// Tick de renderização, como timer_animacao_callback
+static void tick(void) {
+    em_tick = true;
+    anim_suspender(stream_tick());
+    anim_tick();
+    em_tick = false;
+}
+
+// Avança o relógio de 1 em 1 ms até fim_ms; a cada ms, uma passada do laço principal e um tick
+static void avancar_ate(uint32_t fim_ms) {
+    while (agora_ms < fim_ms) {
+        agora_ms++;
+        stream_processar();
+        tick();
+    }
+}
+
+// Coloca na serial um frame completo com todos os canais iguais a "valor"
+static void enviar_frame(uint8_t seq, uint8_t valor) {
+    uint8_t rgb[NUM_PIXELS * 3];
+
+    for (uint32_t i = 0; i < sizeof(rgb); i++) rgb[i] = valor;
+    serial_fim += proto_codificar(&serial[serial_fim], seq, true, 0, NUM_PIXELS, rgb);
+}
+
+static void reiniciar(stream_politica_t politica) {
+    agora_ms = 0;
+    num_entregas = 0;
+    leituras = leituras_no_tick = 0;
+    serial_inicio = serial_fim = 0;
+    anim_init(relogio, saida);
+    stream_init(NUM_PIXELS, saida, politica);
+}
+
+// ----- Sequências de teste -----
+
+static const uint32_t frame_a[NUM_PIXELS] = {1}, frame_b[NUM_PIXELS] = {2}, frame_x[NUM_PIXELS] = {3};
+
+static bool da_animacao(const uint32_t *frame) {
+    return frame == frame_a || frame == frame_b || frame == frame_x;
+}
+
+// A e B alternados a cada 10 ms por 2,5 s
+#define PASSOS_AB 250
+static anim_passo_t passos_ab[PASSOS_AB];
+static const anim_sequencia_t seq_ab = {.passos = passos_ab, .num_passos = PASSOS_AB};
+
+static const anim_passo_t passos_x[1] = {{frame_x, 10}};
+static const anim_sequencia_t seq_x = {.passos = passos_x, .num_passos = 1};
+
+// Imagem mantida renovada a cada 5 ms; o primeiro pixel a distingue de qualquer cor GRB da stream
+#define PIXEL_MANTIDO 0xA5000000u
+
+static bool gerador_mantido(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms) {
+    (void)contexto;
+    (void)passo;
+    frame[0] = PIXEL_MANTIDO;
+    *duracao_ms = 5;
+    return true;
+}
+
+static const anim_sequencia_t seq_mantida = {.gerador = gerador_mantido, .manter = true};
+
+// Índice da primeira entrega da animação a partir do instante informado (num_entregas se nenhuma)
+static uint32_t primeira_da_animacao(uint32_t desde_ms) {
+    for (uint32_t i = 0; i < num_entregas; i++) {
+        if (entregas[i].instante_ms >= desde_ms && da_animacao(entregas[i].frame)) return i;
+    }
+    return num_entregas;
+}
+
+static void conferir_posse(void) {
+    uint32_t ultimo_ms = 0, frames_stream = 0;
+
+    reiniciar(STREAM_SEGURAR);
+    anim_tocar(&seq_ab, ANIM_SUBSTITUIR);
+
+    // A animação exibe A em 1, B em 11, ..., A em 41; a stream chega em 50
+    avancar_ate(49);
+    conferir(num_entregas == 5 && entregas[4].frame == frame_a, "animação antes da stream");
+
+    // Um frame a cada 20 ms de 50 a 290
+    for (uint8_t seq = 0; agora_ms < 290; seq++) {
+        enviar_frame(seq, seq);
+        avancar_ate(agora_ms + 20);
+    }
+    for (uint32_t i = 5; i < num_entregas; i++) {
+        if (da_animacao(entregas[i].frame)) continue;
+        frames_stream++;
+        ultimo_ms = entregas[i].instante_ms;
+    }
+    conferir(frames_stream == 13, "frames da stream perdidos ou repetidos");
+    conferir(primeira_da_animacao(50) == num_entregas, "animação sobrescreveu a stream");
+
+    // Sem frames novos, a animação retoma em STREAM_POSSE_MS pelo passo em que parou (A),
+    // que volta a durar 10 ms
+    avancar_ate(ultimo_ms + STREAM_POSSE_MS + 100);
+    uint32_t i = primeira_da_animacao(50);
+    conferir(i < num_entregas && entregas[i].instante_ms == ultimo_ms + STREAM_POSSE_MS,
+             "animação não retomou STREAM_POSSE_MS depois do último frame");
+    conferir(i + 1 < num_entregas && entregas[i].frame == frame_a && entregas[i + 1].frame == frame_b &&
+             entregas[i + 1].instante_ms == entregas[i].instante_ms + 10,
+             "animação não retomou pelo passo interrompido");
+    conferir(leituras > 0 && leituras_no_tick == 0, "serial lida dentro do tick");
+}
+
+static void conferir_pedido_durante_stream(void) {
+    reiniciar(STREAM_SEGURAR);
+    enviar_frame(0, 7);
+    avancar_ate(10);
+    anim_tocar(&seq_x, ANIM_SUBSTITUIR);
+    avancar_ate(100);
+    conferir(num_entregas == 1 && !da_animacao(entregas[0].frame), "pedido de animação tocou durante a stream");
+
+    avancar_ate(1 + STREAM_POSSE_MS + 10);
+    conferir(num_entregas == 2 && entregas[1].frame == frame_x && entregas[1].instante_ms == 1 + STREAM_POSSE_MS,
+             "pedido feito durante a stream não tocou ao fim dela");
+}
+
+static void conferir_mantida_durante_stream(void) {
+    uint32_t ultimo_ms = 0, frames_stream = 0, renovadas = 0;
+
+    reiniciar(STREAM_SEGURAR);
+    anim_tocar(&seq_mantida, ANIM_SUBSTITUIR);
+    avancar_ate(49);
+    conferir(num_entregas == 10 && entregas[9].pixel0 == PIXEL_MANTIDO, "imagem mantida antes da stream");
+
+    // Um frame a cada 20 ms de 50 a 190: nenhuma renovação da imagem mantida entre eles
+    for (uint8_t seq = 0; agora_ms < 190; seq++) {
+        enviar_frame(seq, seq);
+        avancar_ate(agora_ms + 20);
+    }
+    for (uint32_t i = 10; i < num_entregas; i++) {
+        if (entregas[i].pixel0 == PIXEL_MANTIDO) {
+            renovadas++;
+        } else {
+            frames_stream++;
+            ultimo_ms = entregas[i].instante_ms;
+        }
+    }
+    conferir(frames_stream == 8 && renovadas == 0, "imagem mantida sobrescreveu a stream");
+    conferir(anim_mantendo(), "imagem mantida encerrada pela stream");
+
+    // Sem frames novos, a imagem volta em STREAM_POSSE_MS e segue renovada a cada 5 ms
+    uint32_t i = num_entregas;
+    avancar_ate(ultimo_ms + STREAM_POSSE_MS + 20);
+    conferir(i + 1 < num_entregas && entregas[i].pixel0 == PIXEL_MANTIDO &&
+             entregas[i].instante_ms == ultimo_ms + STREAM_POSSE_MS &&
+             entregas[i + 1].instante_ms == entregas[i].instante_ms + 5,
+             "imagem mantida não retomada depois da stream");
+}
+
+static void conferir_politicas(void) {
+    stream_estatisticas_t e;
+
+    // Rajada maior que a fila: cada passada lê no máximo o espaço livre e analisa STREAM_ANALISE_BYTES
+    reiniciar(STREAM_SEGURAR);
+    serial_fim = 10000;
+    stream_processar();
+    stream_obter_estatisticas(&e);
+    conferir(serial_inicio == STREAM_FILA_BYTES && e.bytes_descartados == 0, "STREAM_SEGURAR leu além da fila");
+    stream_processar();
+    conferir(serial_inicio == STREAM_FILA_BYTES + STREAM_ANALISE_BYTES, "STREAM_SEGURAR não leu o espaço liberado");
+
+    reiniciar(STREAM_DESCARTAR);
+    serial_fim = 10000;
+    stream_processar();
+    stream_obter_estatisticas(&e);
+    conferir(serial_inicio == serial_fim, "STREAM_DESCARTAR deixou bytes na serial");
+    conferir(e.bytes_descartados == 10000 - STREAM_FILA_BYTES, "bytes descartados");
+}
+
+static void medir(void) {
+    static uint8_t pacote[PACOTE];
+    uint8_t rgb[NUM_PIXELS * 3] = {0};
+    uint32_t n = proto_codificar(pacote, 0, true, 0, NUM_PIXELS, rgb);
+
+    reiniciar(STREAM_SEGURAR);
+    uint64_t c0 = bench_ciclos(), t0 = bench_ns();
+    for (uint32_t q = 0; q < FRAMES_MEDICAO; q++) {
+        serial_inicio = 0;
+        serial_fim = n;
+        for (uint32_t i = 0; i < n; i++) serial[i] = pacote[i];
+        stream_processar();
+        tick();
+    }
+    bench_relatar("serial -> saída (25 pixels)", bench_ciclos() - c0, bench_ns() - t0, FRAMES_MEDICAO);
+
+    stream_estatisticas_t e;
+    stream_obter_estatisticas(&e);
+    conferir(e.frames_exibidos == FRAMES_MEDICAO, "frames medidos não exibidos");
+}
+
+int main(void) {
+    for (uint32_t i = 0; i < PASSOS_AB; i++) passos_ab[i] = (anim_passo_t){(i & 1) ? frame_b : frame_a, 10};
+    cor_set_brilho(255);
+    layout_definir(&LAYOUT_PLACA);
+
+    conferir_posse();
+    conferir_pedido_durante_stream();
+    conferir_mantida_durante_stream();
+    conferir_politicas();
+    medir();
+
+    return bench_resultado();
+}
@@ -0,0 +1,27 @@
+#ifndef SDK_FALSO_HARDWARE_DMA_H
+#define SDK_FALSO_HARDWARE_DMA_H
+
+#include "pico/stdlib.h"
+
+enum dma_channel_transfer_size { DMA_SIZE_8, DMA_SIZE_16, DMA_SIZE_32 };
+
+typedef struct {
+    enum dma_channel_transfer_size tamanho;
+    bool incrementa_leitura, incrementa_escrita;
+    uint dreq;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool obrigatorio);
+dma_channel_config dma_channel_get_default_config(uint canal);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size tamanho);
+void channel_config_set_read_increment(dma_channel_config *c, bool incrementa);
+void channel_config_set_write_increment(dma_channel_config *c, bool incrementa);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void dma_channel_configure(uint canal, const dma_channel_config *c, volatile void *destino, const volatile void *origem,
+                           uint transferencias, bool iniciar);
+void dma_channel_set_irq0_enabled(uint canal, bool habilitar);
+bool dma_channel_get_irq0_status(uint canal);
+void dma_channel_acknowledge_irq0(uint canal);
+void dma_channel_transfer_from_buffer_now(uint canal, const volatile void *origem, uint transferencias);
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef SDK_FALSO_HARDWARE_IRQ_H
+#define SDK_FALSO_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+#define DMA_IRQ_0 11
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+typedef void (*irq_handler_t)(void);
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t prioridade);
+void irq_set_enabled(uint num, bool habilitar);
+
+#endif
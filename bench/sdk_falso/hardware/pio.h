@@ -0,0 +1,18 @@
+#ifndef SDK_FALSO_HARDWARE_PIO_H
+#define SDK_FALSO_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    volatile uint32_t txf[4];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+// DREQ de TX ou RX de uma state machine, numerado como na pio0 do RP2040
+static inline uint pio_get_dreq(PIO pio, uint sm, bool tx) {
+    (void)pio;
+    return sm + (tx ? 0u : 4u);
+}
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef SDK_FALSO_PICO_STDLIB_H
+#define SDK_FALSO_PICO_STDLIB_H
+
+// SDK falso para os benchmarks de host: só o que frame_dma.c usa; definido em bench_frame_dma.c
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pico/types.h"
+
+// Relógio simulado, em µs
+uint64_t time_us_64(void);
+
+// Espera ativa: no falso, avança o relógio e atende as interrupções que vencerem
+void tight_loop_contents(void);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef SDK_FALSO_PICO_TYPES_H
+#define SDK_FALSO_PICO_TYPES_H
+
+// SDK falso para os benchmarks de host: o tipo uint usado nos cabeçalhos do firmware
+
+typedef unsigned int uint;
+
+#endif
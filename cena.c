@@ -0,0 +1,55 @@
+#include "cena.h"
+
+#include <string.h>
+
+void cena_configurar(cena_t *c, efeito_t *fundo, rolagem_t *texto, uint16_t periodo_ms) {
+    c->fundo = fundo;
+    c->texto = texto;
+    c->periodo_ms = periodo_ms;
+    c->tamanho_texto = (uint32_t)strlen(texto->texto);
+}
+
+// Desenha a janela atual da rolagem e a barra com a fração do texto já exibida
+static void desenhar_texto(cena_t *c) {
+    rolagem_t *r = c->texto;
+    uint32_t largura = layout_matriz.largura, y = layout_matriz.altura - 1u;
+    uint32_t exibidos = c->tamanho_texto ? (uint32_t)(r->caractere - r->texto) * largura / c->tamanho_texto : 0;
+
+    comp_glifo(&c->comp, CENA_TEXTO, r->janela, COMP_ARGB(255, r->aceso[0], r->aceso[1], r->aceso[2]),
+               COMP_ARGB(CENA_SOMBRA, 0, 0, 0));
+    for (uint32_t x = 0; x < largura; x++) {
+        comp_definir(&c->comp.camadas[CENA_ESTADO], y * largura + x,
+                     x < exibidos ? COMP_ARGB(CENA_BARRA_ALFA, 0, 0, 255) : COMP_TRANSPARENTE);
+    }
+}
+
+bool cena_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms) {
+    cena_t *c = contexto;
+
+    if (passo == 0) {
+        comp_init(&c->comp, CENA_CAMADAS, layout_matriz.num_pixels);
+        comp_modo(&c->comp, CENA_ESTADO, COMP_SOMA);
+        efeito_reiniciar(c->fundo);
+        c->passo_texto = 0;
+        c->texto_ms = c->texto->periodo_ms;
+    }
+
+    // O fundo muda a cada frame; o texto anda uma coluna a cada periodo_ms da rolagem
+    efeito_camada(c->fundo, c->comp.camadas[CENA_FUNDO].pixels);
+    c->comp.camadas[CENA_FUNDO].alterada = true;
+
+    c->texto_ms += c->periodo_ms;
+    if (c->texto_ms >= c->texto->periodo_ms) {
+        c->texto_ms = 0;
+        if (!rolagem_avancar(c->texto, c->passo_texto++)) {
+            c->passo_texto = 0;
+            rolagem_avancar(c->texto, c->passo_texto++);
+        }
+        desenhar_texto(c);
+    }
+
+    // Sem mudança, o frame anterior (guardado pelo escalonador) continua valendo
+    if (comp_compor(&c->comp)) comp_codificar(&c->comp, frame);
+    *duracao_ms = c->periodo_ms;
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef CENA_H
+#define CENA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "compositor.h"
+#include "efeitos.h"
+#include "rolagem.h"
+
+/**
+ * @brief Cena em camadas: um efeito ao fundo, texto rolando por cima e uma barra de progresso.
+ *
+ * - CENA_FUNDO: o efeito procedural, opaco, recalculado a cada frame;
+ * - CENA_TEXTO: os pixels acesos da rolagem, opacos na cor do texto, e os apagados em preto
+ *   com alfa CENA_SOMBRA, que escurece o fundo para o texto se destacar;
+ * - CENA_ESTADO: a linha de baixo somada (COMP_SOMA) em azul até a fração do texto já exibida.
+ *
+ * O texto e a barra só mudam quando a rolagem anda uma coluna; nos outros frames o compositor
+ * não os toca, e nenhuma camada é refeita se o fundo também não mudar.
+ */
+
+enum { CENA_FUNDO, CENA_TEXTO, CENA_ESTADO, CENA_CAMADAS };
+
+// Alfa dos pixels apagados do texto sobre o fundo
+#define CENA_SOMBRA 160
+
+// Alfa da barra de progresso somada à linha de baixo
+#define CENA_BARRA_ALFA 160
+
+typedef struct {
+    compositor_t comp;
+    efeito_t *fundo;
+    rolagem_t *texto;
+    uint16_t periodo_ms;       // Intervalo entre frames
+
+    // Estado, reiniciado no passo 0
+    uint32_t passo_texto;
+    uint32_t texto_ms;         // Tempo acumulado desde o último deslocamento do texto
+    uint32_t tamanho_texto;
+} cena_t;
+
+/**
+ * @brief Associa o efeito de fundo e a rolagem (já configurada) a uma cena.
+ *
+ * O texto volta a entrar pela direita ao terminar; a cena não termina sozinha.
+ */
+void cena_configurar(cena_t *c, efeito_t *fundo, rolagem_t *texto, uint16_t periodo_ms);
+
+/**
+ * @brief Gerador de animação (anim_gerador_t): um frame composto a cada periodo_ms.
+ *
+ * Só escreve em frame quando a composição muda; nos outros passos o frame anterior do
+ * escalonador continua valendo.
+ */
+bool cena_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms);
+
+#endif
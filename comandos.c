@@ -0,0 +1,81 @@
+#include "comandos.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "roteiro.h"
+#include "trace.h"
+
+typedef struct {
+    bool ocupado;
+    comando_t comando;
+    uint8_t codigo[ROTEIRO_MAX_BYTES];
+    roteiro_t roteiro;
+    anim_sequencia_t sequencia;
+} instalado_t;
+
+static const comando_t *tabela_atual;
+static uint32_t num_comandos_atual;
+static void (*trocar_matriz_atual)(void);
+static instalado_t instalados[COMANDOS_ROTEIROS_RAM];
+
+void comandos_init(const comando_t *tabela, uint32_t num_comandos, void (*trocar_matriz)(void)) {
+    tabela_atual = tabela;
+    num_comandos_atual = num_comandos;
+    trocar_matriz_atual = trocar_matriz;
+    memset(instalados, 0, sizeof(instalados));
+}
+
+static instalado_t *procurar_instalado(char tecla, keypad_tipo_evento_t evento) {
+    for (int i = 0; i < COMANDOS_ROTEIROS_RAM; i++) {
+        instalado_t *p = &instalados[i];
+        if (p->ocupado && p->comando.tecla == tecla && p->comando.evento == evento) return p;
+    }
+    return NULL;
+}
+
+static const comando_t *procurar(char tecla, keypad_tipo_evento_t evento) {
+    instalado_t *p = procurar_instalado(tecla, evento);
+    if (p) return &p->comando;
+
+    for (uint32_t i = 0; i < num_comandos_atual; i++) {
+        if (tabela_atual[i].tecla == tecla && tabela_atual[i].evento == evento) return &tabela_atual[i];
+    }
+    return NULL;
+}
+
+bool comandos_executar(char tecla, keypad_tipo_evento_t evento) {
+    const comando_t *c = procurar(tecla, evento);
+    if (!c) return false;
+
+    TRACE(TRACE_COMANDO, tecla);
+    if (c->acao) c->acao(tecla);
+    if (c->sequencia) {
+        if (trocar_matriz_atual) trocar_matriz_atual();
+        anim_tocar(c->sequencia, ANIM_SUBSTITUIR);
+    }
+    if (c->mensagem) printf("%s\n", c->mensagem);
+    return true;
+}
+
+bool comandos_instalar(char tecla, keypad_tipo_evento_t evento, const uint8_t *codigo, uint32_t tamanho) {
+    instalado_t *p = procurar_instalado(tecla, evento);
+
+    if (tamanho == 0) {
+        if (p) p->ocupado = false;
+        return true;
+    }
+    if (!roteiro_validar(codigo, tamanho)) return false;
+    for (int i = 0; !p && i < COMANDOS_ROTEIROS_RAM; i++) {
+        if (!instalados[i].ocupado) p = &instalados[i];
+    }
+    if (!p) return false;
+
+    // Um roteiro em reprodução nesta entrada pode ver o programa trocado entre dois passos; o
+    // interpretador confere cada operando, então no pior caso o roteiro termina antes
+    memcpy(p->codigo, codigo, tamanho);
+    roteiro_init(&p->roteiro, p->codigo, (uint16_t)tamanho);
+    p->sequencia = (anim_sequencia_t){.gerador = roteiro_gerar, .contexto = &p->roteiro};
+    p->comando = (comando_t){.tecla = tecla, .evento = evento, .sequencia = &p->sequencia};
+    p->ocupado = true;
+    return true;
+}
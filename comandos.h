@@ -0,0 +1,55 @@
+#ifndef COMANDOS_H
+#define COMANDOS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "animacao.h"
+#include "debounce.h"
+
+/**
+ * @brief Tabela de comandos: o que cada evento de tecla faz, descrito como dados.
+ *
+ * Cada entrada associa uma tecla e um tipo de evento a uma sequência de animação (frames
+ * pré-codificados, contêiner compactado, gerador ou roteiro de roteiro.h), a uma ação em código
+ * para o que não é só animação, e a uma mensagem para o console. Comportamentos novos são uma
+ * linha da tabela, ou um roteiro recebido pela serial e instalado em RAM sobre a entrada da
+ * mesma tecla, sem regravar o firmware.
+ */
+
+// Roteiros recebidos pela serial guardados ao mesmo tempo
+#define COMANDOS_ROTEIROS_RAM 4
+
+typedef struct {
+    char tecla;
+    keypad_tipo_evento_t evento;
+    const anim_sequencia_t *sequencia;   // Tocada com ANIM_SUBSTITUIR; NULL se a ação cuida da matriz
+    void (*acao)(char tecla);            // Chamada antes da sequência; NULL se não houver
+    const char *mensagem;                // Impressa ao executar; NULL se não houver
+} comando_t;
+
+/**
+ * @brief Define a tabela consultada por comandos_executar e descarta os roteiros instalados.
+ *
+ * @param trocar_matriz Chamada antes de tocar qualquer sequência (ex.: desligar o que ocupava a
+ *                      matriz e algum periférico); pode ser NULL.
+ */
+void comandos_init(const comando_t *tabela, uint32_t num_comandos, void (*trocar_matriz)(void));
+
+/**
+ * @brief Executa o comando da tecla para o evento, se houver; os instalados têm prioridade.
+ *
+ * @return false se nenhum comando corresponder.
+ */
+bool comandos_executar(char tecla, keypad_tipo_evento_t evento);
+
+/**
+ * @brief Instala um roteiro em RAM para a tecla e o evento, validado por roteiro_validar.
+ *
+ * O programa é copiado. Um programa vazio remove o instalado e devolve a tecla à tabela.
+ *
+ * @return false se o programa for inválido ou não houver espaço para outro roteiro.
+ */
+bool comandos_instalar(char tecla, keypad_tipo_evento_t evento, const uint8_t *codigo, uint32_t tamanho);
+
+#endif
@@ -0,0 +1,79 @@
+#include "compacta.h"
+
+#include <stddef.h>
+#include "cor.h"
+
+static uint16_t ler16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+uint16_t compacta_num_quadros(const uint8_t *dados) {
+    if (!dados || dados[0] != COMPACTA_MAGICO1 || dados[1] != COMPACTA_MAGICO2) return 0;
+    return ler16(&dados[4]);
+}
+
+bool compacta_abrir(compacta_t *c, const uint8_t *dados) {
+    if (compacta_num_quadros(dados) == 0) return false;
+
+    uint16_t num_pixels = ler16(&dados[2]);
+    uint8_t num_cores = dados[6];
+    if (num_pixels == 0 || num_pixels > COMPACTA_MAX_PIXELS || num_cores == 0 || num_cores > COMPACTA_MAX_CORES) {
+        return false;
+    }
+
+    const uint8_t *rgb = &dados[COMPACTA_CABECALHO];
+    for (uint8_t i = 0; i < num_cores; i++, rgb += 3) {
+        c->paleta[i] = cor_grb(rgb[0], rgb[1], rgb[2]);
+    }
+    c->dados = dados;
+    c->cursor = rgb;
+    c->num_pixels = num_pixels;
+    c->num_quadros = ler16(&dados[4]);
+    c->num_cores = num_cores;
+    c->quadro = 0;
+    return true;
+}
+
+bool compacta_proximo(compacta_t *c, uint32_t *frame, uint32_t *duracao_ms) {
+    if (c->quadro >= c->num_quadros) return false;
+
+    const uint8_t *p = c->cursor;
+    uint8_t tipo = p[0];
+    if (tipo != COMPACTA_CHAVE && (tipo != COMPACTA_DELTA || c->quadro == 0)) return false;
+    if (duracao_ms) *duracao_ms = ler16(&p[1]);
+    p += 3;
+
+    // Corridas aplicadas direto sobre os índices: cópia no frame-chave, XOR no delta
+    uint8_t *indices = c->indices;
+    uint32_t i = 0;
+    while (i < c->num_pixels) {
+        uint8_t controle = *p++;
+        uint32_t n = (controle & 0x7Fu) + 1;
+        if (i + n > c->num_pixels) return false;
+
+        if (controle & 0x80u) {
+            uint8_t v = *p++;
+            if (tipo == COMPACTA_CHAVE) {
+                for (uint32_t k = 0; k < n; k++) indices[i + k] = v;
+            } else if (v != 0) {
+                for (uint32_t k = 0; k < n; k++) indices[i + k] ^= v;
+            }
+        } else if (tipo == COMPACTA_CHAVE) {
+            for (uint32_t k = 0; k < n; k++) indices[i + k] = p[k];
+            p += n;
+        } else {
+            for (uint32_t k = 0; k < n; k++) indices[i + k] ^= p[k];
+            p += n;
+        }
+        i += n;
+    }
+
+    // Expansão pela paleta; um índice fora dela indica dados corrompidos
+    for (i = 0; i < c->num_pixels; i++) {
+        if (indices[i] >= c->num_cores) return false;
+        frame[i] = c->paleta[indices[i]];
+    }
+    c->cursor = p;
+    c->quadro++;
+    return true;
+}
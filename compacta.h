@@ -0,0 +1,71 @@
+#ifndef COMPACTA_H
+#define COMPACTA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Formato compacto de animações, decodificado um frame por vez.
+ *
+ * Contêiner (inteiros de 16 bits em little-endian):
+ *   'A' 'Z'          identificação
+ *   num_pixels       pixels por frame (até COMPACTA_MAX_PIXELS)
+ *   num_quadros      frames da animação
+ *   num_cores        entradas da paleta (1 a COMPACTA_MAX_CORES)
+ *   paleta           num_cores * 3 bytes R, G, B
+ *   quadros          para cada frame:
+ *     tipo           COMPACTA_CHAVE (índices completos) ou COMPACTA_DELTA (XOR sobre o frame anterior)
+ *     duracao        tempo de exibição em ms
+ *     rle            índices de paleta em corridas até completar num_pixels:
+ *                    byte n < 0x80: seguem n + 1 bytes literais;
+ *                    byte n >= 0x80: o próximo byte se repete (n & 0x7F) + 1 vezes
+ *
+ * Num frame delta os pixels que não mudam valem 0, e longas corridas de zeros ocupam 2 bytes.
+ * Os frames ficam em flash; na RAM ficam só os índices do frame atual e a paleta já codificada.
+ */
+
+#define COMPACTA_MAGICO1 'A'
+#define COMPACTA_MAGICO2 'Z'
+#define COMPACTA_CHAVE 0
+#define COMPACTA_DELTA 1
+
+#define COMPACTA_MAX_PIXELS 256
+#define COMPACTA_MAX_CORES 32
+
+#define COMPACTA_CABECALHO 7   // identificação, num_pixels, num_quadros, num_cores
+#define COMPACTA_CORRIDA_MAX 128
+
+// Estado de decodificação de um contêiner: memória limitada, independente do tamanho da animação
+typedef struct {
+    const uint8_t *dados;
+    const uint8_t *cursor;      // Próximo frame a decodificar
+    uint16_t num_pixels;
+    uint16_t num_quadros;
+    uint16_t quadro;            // Frames já decodificados
+    uint8_t num_cores;
+    uint32_t paleta[COMPACTA_MAX_CORES];       // Cores já codificadas (cor_grb)
+    uint8_t indices[COMPACTA_MAX_PIXELS];      // Índices do último frame, base dos deltas
+} compacta_t;
+
+/**
+ * @brief Valida o cabeçalho de um contêiner e prepara a decodificação do primeiro frame.
+ *
+ * A paleta é codificada com cor_grb neste momento, com o brilho vigente.
+ *
+ * @return false se o contêiner for inválido ou exceder os limites do decodificador.
+ */
+bool compacta_abrir(compacta_t *c, const uint8_t *dados);
+
+/**
+ * @brief Decodifica o próximo frame.
+ *
+ * @param frame Destino com num_pixels palavras GRB.
+ * @param duracao_ms Recebe o tempo de exibição do frame (pode ser NULL).
+ * @return false ao fim da animação ou se os dados estiverem corrompidos.
+ */
+bool compacta_proximo(compacta_t *c, uint32_t *frame, uint32_t *duracao_ms);
+
+// Número de frames de um contêiner, lido do cabeçalho (0 se inválido)
+uint16_t compacta_num_quadros(const uint8_t *dados);
+
+#endif
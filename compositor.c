@@ -0,0 +1,118 @@
+#include "compositor.h"
+
+#include <string.h>
+#include "cor.h"
+#include "fonte.h"
+
+// Canais em pistas de 32 bits: vermelho e azul juntos (com 8 bits livres entre eles) e o verde
+#define PISTAS_RB 0x00FF00FFu
+#define PISTA_G 0x0000FF00u
+#define BITS_ALTOS 0x00808080u
+
+void comp_init(compositor_t *c, uint8_t num_camadas, uint16_t num_pixels) {
+    c->num_camadas = num_camadas <= COMP_MAX_CAMADAS ? num_camadas : COMP_MAX_CAMADAS;
+    c->num_pixels = num_pixels <= LAYOUT_MAX_PIXELS ? num_pixels : LAYOUT_MAX_PIXELS;
+    for (uint32_t i = 0; i < COMP_MAX_CAMADAS; i++) {
+        memset(c->camadas[i].pixels, 0, sizeof(c->camadas[i].pixels));
+        c->camadas[i].modo = COMP_MISTURA;
+        c->camadas[i].visivel = true;
+        c->camadas[i].alterada = true;
+    }
+    memset(&c->estatisticas, 0, sizeof(c->estatisticas));
+}
+
+void comp_modo(compositor_t *c, uint8_t camada, comp_modo_t modo) {
+    if (c->camadas[camada].modo == modo) return;
+    c->camadas[camada].modo = modo;
+    c->camadas[camada].alterada = true;
+}
+
+void comp_visivel(compositor_t *c, uint8_t camada, bool visivel) {
+    if (c->camadas[camada].visivel == visivel) return;
+    c->camadas[camada].visivel = visivel;
+    c->camadas[camada].alterada = true;
+}
+
+void comp_definir(comp_camada_t *camada, uint32_t indice, uint32_t argb) {
+    if (camada->pixels[indice] == argb) return;
+    camada->pixels[indice] = argb;
+    camada->alterada = true;
+}
+
+void comp_preencher(compositor_t *c, uint8_t camada, uint32_t argb) {
+    for (uint32_t i = 0; i < c->num_pixels; i++) comp_definir(&c->camadas[camada], i, argb);
+}
+
+void comp_glifo(compositor_t *c, uint8_t camada, uint32_t glifo, uint32_t argb_aceso, uint32_t argb_apagado) {
+    int bit = FONTE_PIXELS - 1;
+
+    for (uint32_t l = 0; l < FONTE_ALTURA; l++) {
+        for (uint32_t col = 0; col < FONTE_LARGURA; col++, bit--) {
+            uint32_t argb = (glifo >> bit) & 1u ? argb_aceso : argb_apagado;
+            comp_definir(&c->camadas[camada], l * layout_matriz.largura + col, argb);
+        }
+    }
+}
+
+uint32_t comp_misturar(uint32_t abaixo, uint32_t argb, comp_modo_t modo) {
+    // Alfa de 0 a 256, para que 255 copie a camada sem perda
+    uint32_t a = argb >> 24;
+    a += a >> 7;
+
+    // Camada escalada pelo alfa: vermelho e azul numa multiplicação, verde em outra
+    uint32_t rb = ((argb & PISTAS_RB) * a >> 8) & PISTAS_RB;
+    uint32_t g = ((argb & PISTA_G) * a >> 8) & PISTA_G;
+
+    if (modo == COMP_MISTURA) {
+        // As mesmas pistas para o que está abaixo, com o peso complementar; a soma não passa de 255
+        rb += ((abaixo & PISTAS_RB) * (256 - a) >> 8) & PISTAS_RB;
+        g += ((abaixo & PISTA_G) * (256 - a) >> 8) & PISTA_G;
+        return rb | g;
+    }
+
+    // Soma saturada dos três canais de uma vez: soma sem o bit alto de cada canal (nenhum vai-um
+    // cruza para o vizinho), recompõe o bit alto e transforma o vai-um de cada canal em 0xFF
+    uint32_t s = rb | g, d = abaixo & 0x00FFFFFFu;
+    uint32_t baixos = (s & ~BITS_ALTOS) + (d & ~BITS_ALTOS);
+    uint32_t soma = baixos ^ ((s ^ d) & BITS_ALTOS);
+    uint32_t vai_um = ((s & d) | ((s ^ d) & baixos)) & BITS_ALTOS;
+    return soma | ((vai_um >> 7) * 0xFFu);
+}
+
+bool comp_compor(compositor_t *c) {
+    uint32_t inicio = 0;
+
+    while (inicio < c->num_camadas && !c->camadas[inicio].alterada) inicio++;
+    if (inicio == c->num_camadas) {
+        c->estatisticas.ignoradas++;
+        return false;
+    }
+
+    for (uint32_t k = inicio; k < c->num_camadas; k++) {
+        comp_camada_t *camada = &c->camadas[k];
+        const uint32_t *abaixo = k > 0 ? c->parcial[k - 1] : NULL;
+        uint32_t *destino = c->parcial[k];
+
+        camada->alterada = false;
+        if (!camada->visivel) {
+            if (abaixo) memcpy(destino, abaixo, c->num_pixels * sizeof(uint32_t));
+            else memset(destino, 0, c->num_pixels * sizeof(uint32_t));
+            continue;
+        }
+        for (uint32_t i = 0; i < c->num_pixels; i++) {
+            destino[i] = comp_misturar(abaixo ? abaixo[i] : 0, camada->pixels[i], camada->modo);
+        }
+        c->estatisticas.camadas_misturadas++;
+    }
+    c->estatisticas.composicoes++;
+    return true;
+}
+
+void comp_codificar(const compositor_t *c, uint32_t *frame) {
+    const uint32_t *resultado = c->parcial[c->num_camadas - 1];
+
+    for (uint32_t i = 0; i < c->num_pixels; i++) {
+        uint32_t p = resultado[i];
+        frame[layout_matriz.fisico[i]] = cor_grb((uint8_t)(p >> 16), (uint8_t)(p >> 8), (uint8_t)p);
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "layout.h"
+
+/**
+ * @brief Compositor de camadas com transparência por pixel, sobre a imagem lógica de layout_matriz.
+ *
+ * Cada camada guarda pixels 0xAARRGGBB em ordem lógica (y * largura + x), com as intensidades
+ * antes da gama: a mistura é feita em 8 bits lineares e só o resultado passa por cor_grb. A camada
+ * 0 é o fundo; cada uma das seguintes é misturada sobre o resultado das anteriores.
+ *
+ * A mistura usa aritmética SWAR: vermelho e azul (0x00RR00BB) são escalados juntos numa única
+ * multiplicação de 32 bits, com o verde em outra, e a soma saturada trata os três canais de uma
+ * vez. O compositor guarda o resultado parcial até cada camada: só a camada alterada mais baixa
+ * e as de cima são refeitas, e sem alteração nenhum pixel é recalculado.
+ */
+
+// Camadas por compositor (fundo, texto ou glifo, sobreposição de estado e uma de folga)
+#define COMP_MAX_CAMADAS 4
+
+// Monta um pixel de camada; alfa 0 é transparente e 255 opaco
+#define COMP_ARGB(a, r, g, b) \
+    (((uint32_t)(a) << 24) | ((uint32_t)(r) << 16) | ((uint32_t)(g) << 8) | (uint32_t)(b))
+
+#define COMP_TRANSPARENTE 0u
+
+typedef enum {
+    COMP_MISTURA,  // Interpolação pelo alfa: camada * a + abaixo * (1 - a)
+    COMP_SOMA      // Camada * a somada ao que está abaixo, saturando em 255 (brilhos, realces)
+} comp_modo_t;
+
+typedef struct {
+    uint32_t pixels[LAYOUT_MAX_PIXELS];   // 0xAARRGGBB em ordem lógica
+    comp_modo_t modo;
+    bool visivel;
+    bool alterada;                        // Marcada pelas funções de escrita; quem grava em pixels direto deve marcá-la
+} comp_camada_t;
+
+typedef struct {
+    uint32_t composicoes;        // Chamadas de comp_compor que refizeram algum pixel
+    uint32_t ignoradas;          // Chamadas sem camada alterada
+    uint32_t camadas_misturadas; // Camadas refeitas, somadas em todas as composições
+} comp_estatisticas_t;
+
+typedef struct {
+    comp_camada_t camadas[COMP_MAX_CAMADAS];
+    uint8_t num_camadas;
+    uint16_t num_pixels;
+    uint32_t parcial[COMP_MAX_CAMADAS][LAYOUT_MAX_PIXELS];   // 0x00RRGGBB do fundo até cada camada
+    comp_estatisticas_t estatisticas;
+} compositor_t;
+
+/**
+ * @brief Prepara um compositor com todas as camadas transparentes, visíveis e em COMP_MISTURA.
+ *
+ * @param num_pixels Pixels da imagem lógica (normalmente layout_matriz.num_pixels).
+ */
+void comp_init(compositor_t *c, uint8_t num_camadas, uint16_t num_pixels);
+
+// Troca o modo de mistura de uma camada
+void comp_modo(compositor_t *c, uint8_t camada, comp_modo_t modo);
+
+// Mostra ou esconde uma camada sem apagar seu conteúdo
+void comp_visivel(compositor_t *c, uint8_t camada, bool visivel);
+
+// Grava um pixel lógico; a camada só é marcada como alterada se o valor mudar
+void comp_definir(comp_camada_t *camada, uint32_t indice, uint32_t argb);
+
+// Preenche uma camada inteira com um valor
+void comp_preencher(compositor_t *c, uint8_t camada, uint32_t argb);
+
+/**
+ * @brief Desenha um glifo de fonte.h no canto superior esquerdo de uma camada.
+ *
+ * Os demais pixels da camada não mudam.
+ */
+void comp_glifo(compositor_t *c, uint8_t camada, uint32_t glifo, uint32_t argb_aceso, uint32_t argb_apagado);
+
+/**
+ * @brief Refaz a composição a partir da camada alterada mais baixa.
+ *
+ * @return false se nenhuma camada mudou desde a última composição (o resultado é o mesmo).
+ */
+bool comp_compor(compositor_t *c);
+
+// Codifica o resultado da última composição em um frame na ordem da cadeia (gama e brilho de cor.h)
+void comp_codificar(const compositor_t *c, uint32_t *frame);
+
+/**
+ * @brief Mistura SWAR de um pixel 0xAARRGGBB sobre um 0x00RRGGBB, exposta para testes e benchmarks.
+ *
+ * @return Pixel 0x00RRGGBB.
+ */
+uint32_t comp_misturar(uint32_t abaixo, uint32_t argb, comp_modo_t modo);
+
+#endif
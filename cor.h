@@ -0,0 +1,48 @@
+#ifndef COR_H
+#define COR_H
+
+#include <stdint.h>
+#include "led_protocolo.h"
+
+// Brilho global padrão (0 a 255) aplicado sobre a correção de gama
+#define COR_BRILHO_PADRAO 255
+
+// Valor de cor_lut[255] para um brilho, disponível em tempo de compilação para frames pré-codificados
+#define COR_MAXIMA(brilho) ((255u * ((brilho) + 1u)) >> 8)
+
+/**
+ * @brief Tabela de conversão de intensidade (0 a 255) para o valor enviado ao LED.
+ *
+ * Combina a correção de gama com o brilho global; é recalculada por cor_set_brilho.
+ */
+extern uint8_t cor_lut[256];
+
+/**
+ * @brief Versão de cor_lut em ponto fixo 8.8 (0 a 0xFF00), para o pontilhado temporal (pontilhado.h).
+ *
+ * A parte inteira é o nível enviado ao LED e a parte fracionária é distribuída entre frames.
+ */
+extern uint16_t cor_lut16[256];
+
+/**
+ * @brief Recalcula cor_lut e cor_lut16 aplicando o brilho global sobre a curva de gama.
+ *
+ * Deve ser chamada na inicialização, antes da primeira codificação.
+ *
+ * @param brilho Brilho de 0 (apagado) a 255 (intensidade máxima).
+ */
+void cor_set_brilho(uint8_t brilho);
+
+/**
+ * @brief Codifica uma cor de 8 bits por canal na palavra enviada à PIO.
+ *
+ * Usa somente consultas à tabela e deslocamentos, sem ponto flutuante. O canal branco das
+ * variantes RGBW fica apagado.
+ *
+ * @return Palavra na ordem de canais de PIO_MATRIX_LED (G << 24 | R << 16 | B << 8 no WS2812).
+ */
+static inline uint32_t cor_grb(uint8_t r, uint8_t g, uint8_t b) {
+    return led_palavra(cor_lut[r], cor_lut[g], cor_lut[b], 0);
+}
+
+#endif
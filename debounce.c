@@ -0,0 +1,121 @@
+#include "debounce.h"
+
+#include "fila_spsc.h"
+#include "trace.h"
+
+typedef enum {
+    ESTADO_SOLTA,
+    ESTADO_PRESSIONANDO,
+    ESTADO_PRESSIONADA,
+    ESTADO_SOLTANDO
+} estado_tecla_t;
+
+typedef struct {
+    uint8_t estado;
+    bool segurada;
+    uint32_t desde_ms;    // Início da transição em curso ou da pressão confirmada
+    uint32_t proximo_ms;  // Próximo evento de segurar/repetir
+} tecla_t;
+
+static const char *mapa_teclas;
+static tecla_t teclas[DEBOUNCE_NUM_TECLAS];
+
+// Fila de eventos: produzida pela varredura (interrupção) e consumida pelo laço principal
+static keypad_evento_t eventos_buffer[DEBOUNCE_FILA_TAM];
+static fila_spsc_t eventos;
+static uint32_t perdidos = 0;
+
+void debounce_init(const char mapa[DEBOUNCE_NUM_TECLAS]) {
+    mapa_teclas = mapa;
+    for (int k = 0; k < DEBOUNCE_NUM_TECLAS; k++) {
+        teclas[k].estado = ESTADO_SOLTA;
+        teclas[k].segurada = false;
+    }
+    fila_spsc_init(&eventos, eventos_buffer, sizeof(keypad_evento_t), DEBOUNCE_FILA_TAM);
+    perdidos = 0;
+}
+
+static void emitir(int k, keypad_tipo_evento_t tipo, uint32_t tempo_ms) {
+    keypad_evento_t evento = {mapa_teclas[k], tipo, tempo_ms, debounce_pressionadas()};
+    if (tipo == KEYPAD_PRESSIONADA) TRACE(TRACE_TECLA, mapa_teclas[k]);
+    if (!fila_spsc_inserir(&eventos, &evento)) perdidos++;
+}
+
+// Comparação de instantes que tolera o estouro do contador de ms
+static inline bool alcancou(uint32_t agora_ms, uint32_t alvo_ms) {
+    return (int32_t)(agora_ms - alvo_ms) >= 0;
+}
+
+void debounce_atualizar(uint16_t bruto, uint32_t agora_ms) {
+    for (int k = 0; k < DEBOUNCE_NUM_TECLAS; k++) {
+        tecla_t *t = &teclas[k];
+        bool fechada = (bruto >> k) & 1u;
+
+        switch (t->estado) {
+            case ESTADO_SOLTA:
+                if (fechada) {
+                    t->estado = ESTADO_PRESSIONANDO;
+                    t->desde_ms = agora_ms;
+                }
+                break;
+
+            case ESTADO_PRESSIONANDO:
+                if (!fechada) {
+                    t->estado = ESTADO_SOLTA;  // Ruído: não chegou a estabilizar
+                } else if (alcancou(agora_ms, t->desde_ms + DEBOUNCE_MS)) {
+                    t->estado = ESTADO_PRESSIONADA;
+                    t->proximo_ms = t->desde_ms + DEBOUNCE_SEGURAR_MS;
+                    emitir(k, KEYPAD_PRESSIONADA, t->desde_ms);
+                }
+                break;
+
+            case ESTADO_PRESSIONADA:
+                if (!fechada) {
+                    t->estado = ESTADO_SOLTANDO;
+                    t->desde_ms = agora_ms;
+                } else if (alcancou(agora_ms, t->proximo_ms)) {
+                    emitir(k, t->segurada ? KEYPAD_REPETICAO : KEYPAD_SEGURADA, agora_ms);
+                    t->segurada = true;
+                    t->proximo_ms += DEBOUNCE_REPETIR_MS;
+                }
+                break;
+
+            case ESTADO_SOLTANDO:
+                if (fechada) {
+                    t->estado = ESTADO_PRESSIONADA;  // Repique durante a soltura
+                } else if (alcancou(agora_ms, t->desde_ms + DEBOUNCE_MS)) {
+                    t->estado = ESTADO_SOLTA;
+                    t->segurada = false;
+                    emitir(k, KEYPAD_SOLTA, t->desde_ms);
+                }
+                break;
+        }
+    }
+}
+
+uint16_t debounce_pressionadas(void) {
+    uint16_t pressionadas = 0;
+
+    // Soltando ainda conta: a soltura só se confirma depois de DEBOUNCE_MS
+    for (int k = 0; k < DEBOUNCE_NUM_TECLAS; k++) {
+        if (teclas[k].estado == ESTADO_PRESSIONADA || teclas[k].estado == ESTADO_SOLTANDO) {
+            pressionadas |= (uint16_t)(1u << k);
+        }
+    }
+    return pressionadas;
+}
+
+bool debounce_ocioso(void) {
+    for (int k = 0; k < DEBOUNCE_NUM_TECLAS; k++) {
+        if (teclas[k].estado != ESTADO_SOLTA) return false;
+    }
+    return true;
+}
+
+bool debounce_obter_evento(keypad_evento_t *evento) {
+    return fila_spsc_retirar(&eventos, evento);
+}
+
+uint32_t debounce_eventos_perdidos(void) {
+    return perdidos;
+}
@@ -0,0 +1,76 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Quantidade de teclas acompanhadas (teclado 4x4)
+#define DEBOUNCE_NUM_TECLAS 16
+
+// Tempo em que a leitura precisa ficar estável para confirmar uma mudança
+#define DEBOUNCE_MS 5
+
+// Tempo pressionada até gerar KEYPAD_SEGURADA e intervalo entre as repetições seguintes
+#define DEBOUNCE_SEGURAR_MS 600
+#define DEBOUNCE_REPETIR_MS 150
+
+// Capacidade da fila de eventos (potência de 2)
+#define DEBOUNCE_FILA_TAM 16
+
+typedef enum {
+    KEYPAD_PRESSIONADA,
+    KEYPAD_SOLTA,
+    KEYPAD_SEGURADA,
+    KEYPAD_REPETICAO
+} keypad_tipo_evento_t;
+
+/**
+ * @brief Evento de tecla já filtrado.
+ *
+ * tempo_ms marca a primeira borda da transição (antes do filtro), permitindo medir a latência.
+ * acorde tem em 1 o bit de cada tecla confirmada como pressionada no instante do evento,
+ * incluindo a do próprio evento enquanto ela estiver pressionada.
+ */
+typedef struct {
+    char tecla;
+    keypad_tipo_evento_t tipo;
+    uint32_t tempo_ms;
+    uint16_t acorde;
+} keypad_evento_t;
+
+/**
+ * @brief Reinicia as máquinas de estado e a fila de eventos.
+ *
+ * @param mapa Caractere de cada tecla, indexado pelo bit correspondente na leitura bruta.
+ */
+void debounce_init(const char mapa[DEBOUNCE_NUM_TECLAS]);
+
+/**
+ * @brief Processa uma leitura bruta do teclado.
+ *
+ * Cada tecla tem sua própria máquina de estados (solta, pressionando, pressionada, soltando);
+ * os eventos confirmados são colocados na fila. Não depende de hardware, podendo ser alimentada
+ * com sinais simulados.
+ *
+ * @param bruto Bit k em 1 quando a tecla k está fechada nesta leitura.
+ * @param agora_ms Instante da leitura.
+ */
+void debounce_atualizar(uint16_t bruto, uint32_t agora_ms);
+
+// Teclas confirmadas como pressionadas agora (bit k = tecla k do mapa)
+uint16_t debounce_pressionadas(void);
+
+// Indica se todas as teclas estão soltas e estáveis (a varredura pode ser suspensa)
+bool debounce_ocioso(void);
+
+/**
+ * @brief Retira o evento mais antigo da fila.
+ *
+ * @return false se a fila estiver vazia.
+ */
+bool debounce_obter_evento(keypad_evento_t *evento);
+
+// Eventos descartados por fila cheia
+uint32_t debounce_eventos_perdidos(void);
+
+#endif
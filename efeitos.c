@@ -0,0 +1,226 @@
+#include "efeitos.h"
+
+#include <string.h>
+#include "compositor.h"
+#include "cor.h"
+
+const uint8_t efeitos_seno8[256] = {
+    128, 131, 134, 137, 140, 144, 147, 150, 153, 156, 159, 162, 165, 168, 171, 174,
+    177, 179, 182, 185, 188, 191, 193, 196, 199, 201, 204, 206, 209, 211, 213, 216,
+    218, 220, 222, 224, 226, 228, 230, 232, 234, 235, 237, 239, 240, 241, 243, 244,
+    245, 246, 248, 249, 250, 250, 251, 252, 253, 253, 254, 254, 254, 255, 255, 255,
+    255, 255, 255, 255, 254, 254, 254, 253, 253, 252, 251, 250, 250, 249, 248, 246,
+    245, 244, 243, 241, 240, 239, 237, 235, 234, 232, 230, 228, 226, 224, 222, 220,
+    218, 216, 213, 211, 209, 206, 204, 201, 199, 196, 193, 191, 188, 185, 182, 179,
+    177, 174, 171, 168, 165, 162, 159, 156, 153, 150, 147, 144, 140, 137, 134, 131,
+    128, 125, 122, 119, 116, 112, 109, 106, 103, 100,  97,  94,  91,  88,  85,  82,
+     79,  77,  74,  71,  68,  65,  63,  60,  57,  55,  52,  50,  47,  45,  43,  40,
+     38,  36,  34,  32,  30,  28,  26,  24,  22,  21,  19,  17,  16,  15,  13,  12,
+     11,  10,   8,   7,   6,   6,   5,   4,   3,   3,   2,   2,   2,   1,   1,   1,
+      1,   1,   1,   1,   2,   2,   2,   3,   3,   4,   5,   6,   6,   7,   8,  10,
+     11,  12,  13,  15,  16,  17,  19,  21,  22,  24,  26,  28,  30,  32,  34,  36,
+     38,  40,  43,  45,  47,  50,  52,  55,  57,  60,  63,  65,  68,  71,  74,  77,
+     79,  82,  85,  88,  91,  94,  97, 100, 103, 106, 109, 112, 116, 119, 122, 125,
+};
+
+// Roda de matizes com saturação e valor máximos: vermelho, amarelo, verde, ciano, azul, magenta
+static uint8_t roda[256][3];
+
+// Fogo: esfriamento máximo por frame e chance (em 256) de uma faísca nas duas linhas de baixo
+#define FOGO_ESFRIAMENTO 40
+#define FOGO_FAISCAS 120
+
+// Brilhos: chance (em 256) de um ponto novo a cada 25 pixels por frame, e saturação dos pontos
+#define BRILHOS_CHANCE 64
+#define BRILHOS_SATURACAO 200
+
+static const char *const nomes[EFEITO_NUM] = {"plasma", "fogo", "arco-íris", "brilhos"};
+
+void efeitos_init(void) {
+    for (uint32_t h = 0; h < 256; h++) {
+        uint8_t setor = (uint8_t)((h * 6) >> 8), rampa = (uint8_t)(h * 6), desce = 255 - rampa;
+        static const uint8_t zero = 0, cheio = 255;
+        const uint8_t *r, *g, *b;
+
+        switch (setor) {
+            case 0:  r = &cheio; g = &rampa; b = &zero;  break;
+            case 1:  r = &desce; g = &cheio; b = &zero;  break;
+            case 2:  r = &zero;  g = &cheio; b = &rampa; break;
+            case 3:  r = &zero;  g = &desce; b = &cheio; break;
+            case 4:  r = &rampa; g = &zero;  b = &cheio; break;
+            default: r = &cheio; g = &zero;  b = &desce; break;
+        }
+        roda[h][0] = *r;
+        roda[h][1] = *g;
+        roda[h][2] = *b;
+    }
+}
+
+void efeitos_hsv(uint8_t matiz, uint8_t saturacao, uint8_t valor, uint8_t rgb[3]) {
+    for (int i = 0; i < 3; i++) {
+        // Mistura com o branco pela saturação e escala pelo valor; 255 preserva a roda exata
+        uint32_t c = (roda[matiz][i] * (saturacao + 1u) + 255u * (255u - saturacao)) >> 8;
+        rgb[i] = (uint8_t)((c * (valor + 1u)) >> 8);
+    }
+}
+
+// Preto, vermelho, amarelo e branco conforme o calor sobe
+static void cor_calor(uint8_t calor, uint8_t rgb[3]) {
+    uint8_t t = (uint8_t)((calor * 191u) >> 8);
+    uint8_t rampa = (uint8_t)((t & 63) << 2);
+
+    rgb[0] = t >= 64 ? 255 : rampa;
+    rgb[1] = t >= 128 ? 255 : t >= 64 ? rampa : 0;
+    rgb[2] = t >= 128 ? rampa : 0;
+}
+
+static uint32_t aleatorio(efeito_t *e) {
+    uint32_t x = e->aleatorio;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return e->aleatorio = x;
+}
+
+// Inteiro de 0 a n - 1, sem divisão
+static uint32_t aleatorio_ate(efeito_t *e, uint32_t n) {
+    return ((aleatorio(e) & 0xFFFFu) * n) >> 16;
+}
+
+// Destino de um frame: palavras já codificadas na ordem da cadeia ou pixels de camada em ordem lógica
+typedef struct {
+    uint32_t *frame;
+    uint32_t *camada;
+} destino_t;
+
+static inline void gravar(destino_t d, uint32_t x, uint32_t y, const uint8_t rgb[3]) {
+    if (d.camada) d.camada[y * layout_matriz.largura + x] = COMP_ARGB(255, rgb[0], rgb[1], rgb[2]);
+    else d.frame[layout_fisico(&layout_matriz, (uint16_t)x, (uint16_t)y)] = cor_grb(rgb[0], rgb[1], rgb[2]);
+}
+
+static void reiniciar(efeito_t *e) {
+    e->t = 0;
+    e->aleatorio = 0x2545F491u;
+    memset(e->nivel, 0, sizeof(e->nivel));
+    memset(e->matiz, 0, sizeof(e->matiz));
+}
+
+void efeito_init(efeito_t *e, efeito_tipo_t tipo, uint16_t periodo_ms) {
+    e->tipo = tipo;
+    e->periodo_ms = periodo_ms;
+    reiniciar(e);
+}
+
+static void plasma(efeito_t *e, destino_t d) {
+    uint32_t t = e->t;
+    uint8_t rgb[3];
+
+    for (uint32_t y = 0; y < layout_matriz.altura; y++) {
+        for (uint32_t x = 0; x < layout_matriz.largura; x++) {
+            uint32_t v = efeitos_seno8[(uint8_t)(x * 40 + t * 3)] + efeitos_seno8[(uint8_t)(y * 48 - t * 2)] +
+                         efeitos_seno8[(uint8_t)((x + y) * 28 + t * 5)];
+            // Média das três ondas (x 85/256 ≈ 1/3) deslocada no tempo pela roda de matizes
+            efeitos_hsv((uint8_t)(((v * 85) >> 8) + t), 255, 255, rgb);
+            gravar(d, x, y, rgb);
+        }
+    }
+}
+
+static void fogo(efeito_t *e, destino_t d) {
+    uint32_t w = layout_matriz.largura, h = layout_matriz.altura;
+    uint8_t rgb[3];
+
+    // Calor de cada coluna com a base em yb = 0: nivel[x + yb * w]
+    for (uint32_t x = 0; x < w; x++) {
+        uint8_t *n = &e->nivel[x];
+
+        for (uint32_t yb = 0; yb < h; yb++) {
+            uint32_t queda = aleatorio_ate(e, FOGO_ESFRIAMENTO + 1);
+            n[yb * w] = n[yb * w] > queda ? (uint8_t)(n[yb * w] - queda) : 0;
+        }
+        // O calor sobe: cada pixel recebe a média ponderada dos dois de baixo (x 85/256 ≈ 1/3)
+        for (uint32_t yb = h - 1; yb >= 2; yb--) {
+            n[yb * w] = (uint8_t)(((n[(yb - 1) * w] + 2u * n[(yb - 2) * w]) * 85u) >> 8);
+        }
+        if (aleatorio_ate(e, 256) < FOGO_FAISCAS) {
+            uint32_t yb = h > 1 ? aleatorio_ate(e, 2) : 0;
+            uint32_t calor = n[yb * w] + 160 + aleatorio_ate(e, 96);
+            n[yb * w] = calor > 255 ? 255 : (uint8_t)calor;
+        }
+
+        for (uint32_t yb = 0; yb < h; yb++) {
+            cor_calor(n[yb * w], rgb);
+            gravar(d, x, h - 1 - yb, rgb);
+        }
+    }
+}
+
+static void arco_iris(efeito_t *e, destino_t d) {
+    // Uma volta da roda ao longo da diagonal, qualquer que seja o tamanho da imagem
+    uint32_t passo = 256 / (layout_matriz.largura + layout_matriz.altura);
+    uint8_t rgb[3];
+
+    for (uint32_t y = 0; y < layout_matriz.altura; y++) {
+        for (uint32_t x = 0; x < layout_matriz.largura; x++) {
+            efeitos_hsv((uint8_t)((x + y) * passo + e->t * 2), 255, 255, rgb);
+            gravar(d, x, y, rgb);
+        }
+    }
+}
+
+static void brilhos(efeito_t *e, destino_t d) {
+    uint32_t num_pixels = layout_matriz.num_pixels;
+    uint8_t rgb[3];
+
+    for (uint32_t tentativa = 0; tentativa < (num_pixels + 24) / 25; tentativa++) {
+        if (aleatorio_ate(e, 256) >= BRILHOS_CHANCE) continue;
+        uint32_t i = aleatorio_ate(e, num_pixels);
+        e->nivel[i] = 255;
+        e->matiz[i] = (uint8_t)aleatorio(e);
+    }
+
+    for (uint32_t y = 0; y < layout_matriz.altura; y++) {
+        for (uint32_t x = 0; x < layout_matriz.largura; x++) {
+            uint32_t i = y * layout_matriz.largura + x;
+            efeitos_hsv(e->matiz[i], BRILHOS_SATURACAO, e->nivel[i], rgb);
+            gravar(d, x, y, rgb);
+            // Apaga 1/8 por frame e some de vez abaixo de 8
+            e->nivel[i] = e->nivel[i] > 8 ? (uint8_t)(e->nivel[i] - (e->nivel[i] >> 3) - 1) : 0;
+        }
+    }
+}
+
+static void calcular(efeito_t *e, destino_t d) {
+    switch (e->tipo) {
+        case EFEITO_PLASMA:    plasma(e, d);    break;
+        case EFEITO_FOGO:      fogo(e, d);      break;
+        case EFEITO_ARCO_IRIS: arco_iris(e, d); break;
+        default:               brilhos(e, d);   break;
+    }
+    e->t++;
+}
+
+void efeito_quadro(efeito_t *e, uint32_t *frame) {
+    calcular(e, (destino_t){.frame = frame});
+}
+
+void efeito_camada(efeito_t *e, uint32_t *argb) {
+    calcular(e, (destino_t){.camada = argb});
+}
+
+void efeito_reiniciar(efeito_t *e) {
+    reiniciar(e);
+}
+
+bool efeito_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms) {
+    efeito_t *e = contexto;
+
+    if (passo == 0) reiniciar(e);
+    efeito_quadro(e, frame);
+    *duracao_ms = e->periodo_ms;
+    return true;
+}
+
+const char *efeito_nome(efeito_tipo_t tipo) {
+    return tipo < EFEITO_NUM ? nomes[tipo] : "?";
+}
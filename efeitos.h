@@ -0,0 +1,82 @@
+#ifndef EFEITOS_H
+#define EFEITOS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "layout.h"
+
+/**
+ * @brief Efeitos procedurais calculados a cada frame sobre a imagem lógica de layout_matriz.
+ *
+ * Toda a matemática é inteira: ondas vêm de uma tabela de seno de 8 bits em flash e as cores de
+ * uma roda de matizes de 256 entradas montada uma vez por efeitos_init, com saturação e valor
+ * aplicados por multiplicação. Não há math.h nem ponto flutuante. O tempo de cada efeito é a
+ * contagem de frames, de modo que a velocidade acompanha periodo_ms.
+ */
+
+typedef enum {
+    EFEITO_PLASMA,     // Soma de três ondas senoidais que deslizam pela matriz, vista como matiz
+    EFEITO_FOGO,       // Calor que sobe das duas linhas de baixo, esfriando ao acaso
+    EFEITO_ARCO_IRIS,  // Arco-íris diagonal girando
+    EFEITO_BRILHOS,    // Pontos de cor que acendem ao acaso e se apagam devagar
+    EFEITO_NUM
+} efeito_tipo_t;
+
+typedef struct {
+    efeito_tipo_t tipo;
+    uint16_t periodo_ms;                  // Duração de cada frame quando usado como gerador
+
+    // Estado, reiniciado no passo 0
+    uint32_t t;                           // Frames desde o início
+    uint32_t aleatorio;                   // Estado do xorshift32
+    uint8_t nivel[LAYOUT_MAX_PIXELS];     // Calor (fogo) ou brilho (brilhos) de cada pixel lógico
+    uint8_t matiz[LAYOUT_MAX_PIXELS];     // Cor de cada ponto dos brilhos
+} efeito_t;
+
+/**
+ * @brief Onda senoidal de 8 bits: 128 + 127·sen(2π·fase/256).
+ */
+extern const uint8_t efeitos_seno8[256];
+
+/**
+ * @brief Monta a roda de matizes; chamada uma vez na inicialização, antes do primeiro frame.
+ */
+void efeitos_init(void);
+
+/**
+ * @brief Converte matiz, saturação e valor (0 a 255 cada) em RGB de 8 bits pela roda de matizes.
+ */
+void efeitos_hsv(uint8_t matiz, uint8_t saturacao, uint8_t valor, uint8_t rgb[3]);
+
+/**
+ * @brief Prepara um efeito; o estado começa do zero a cada reprodução.
+ *
+ * @param periodo_ms Intervalo entre frames quando usado como gerador.
+ */
+void efeito_init(efeito_t *e, efeito_tipo_t tipo, uint16_t periodo_ms);
+
+/**
+ * @brief Calcula o próximo frame do efeito, com layout_matriz.num_pixels palavras.
+ */
+void efeito_quadro(efeito_t *e, uint32_t *frame);
+
+/**
+ * @brief Calcula o próximo frame do efeito como pixels opacos de uma camada (compositor.h), em ordem lógica.
+ */
+void efeito_camada(efeito_t *e, uint32_t *argb);
+
+// Recomeça o efeito do primeiro frame (feito pelo gerador no passo 0)
+void efeito_reiniciar(efeito_t *e);
+
+/**
+ * @brief Gerador de animação (anim_gerador_t): um frame novo a cada periodo_ms.
+ *
+ * A sequência não termina; permanece na matriz até ser substituída.
+ */
+bool efeito_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms);
+
+// Nome do efeito, para as mensagens do console
+const char *efeito_nome(efeito_tipo_t tipo);
+
+#endif
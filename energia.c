@@ -0,0 +1,88 @@
+#include "energia.h"
+
+#include <stddef.h>
+
+static uint32_t clock_normal_khz;
+static bool clock_variavel = false;
+static energia_modo_t modo_atual = NULL;
+
+static bool em_economia = false;
+static uint64_t ultima_atividade_us;
+static uint64_t despertar_us;        // Início do trecho acordado atual
+static uint64_t economia_desde_us;
+
+static energia_estatisticas_t estatisticas_atuais;
+
+void energia_init(uint32_t clock_khz, bool trocar_clock, energia_modo_t ao_trocar) {
+    clock_normal_khz = clock_khz;
+    clock_variavel = trocar_clock && ENERGIA_CLOCK_ECONOMIA_KHZ != 0;
+    modo_atual = ao_trocar;
+
+    em_economia = false;
+    ultima_atividade_us = despertar_us = hal_agora_us();
+    estatisticas_atuais = (energia_estatisticas_t){0};
+    estatisticas_atuais.clock_khz = clock_khz;
+}
+
+// O clock só muda com a PIO parada. Com uma imagem renovada a cada tick, o laço sempre acorda
+// com um frame saindo: espera o fio ficar livre (menos de 1 ms) em vez de adiar para um despertar
+// que nunca o encontraria livre; se outro frame começar antes da troca, tenta no próximo
+static bool ajustar_clock(uint32_t khz) {
+    while (hal_leds_ocupado()) hal_espera_us(10);
+    return hal_sistema_ajustar_clock(khz);
+}
+
+static void entrar_economia(void) {
+    if (clock_variavel) {
+        if (!ajustar_clock(ENERGIA_CLOCK_ECONOMIA_KHZ)) return;
+        estatisticas_atuais.clock_khz = ENERGIA_CLOCK_ECONOMIA_KHZ;
+    }
+    if (modo_atual) modo_atual(true);
+
+    em_economia = true;
+    economia_desde_us = hal_agora_us();
+    estatisticas_atuais.entradas_economia++;
+}
+
+static void sair_economia(void) {
+    if (clock_variavel) {
+        if (!ajustar_clock(clock_normal_khz)) return;
+        estatisticas_atuais.clock_khz = clock_normal_khz;
+    }
+    if (modo_atual) modo_atual(false);
+
+    em_economia = false;
+    estatisticas_atuais.economia_us += hal_agora_us() - economia_desde_us;
+}
+
+void energia_atividade(void) {
+    ultima_atividade_us = hal_agora_us();
+    if (em_economia) sair_economia();
+}
+
+void energia_ociosa(void) {
+    uint64_t agora = hal_agora_us();
+
+    if (!em_economia && agora - ultima_atividade_us >= ENERGIA_OCIOSO_MS * 1000ull) {
+        entrar_economia();
+    } else if (em_economia && agora - ultima_atividade_us < ENERGIA_OCIOSO_MS * 1000ull) {
+        // Saída adiada por um frame em transmissão
+        sair_economia();
+    }
+
+    uint64_t dormir_us = hal_agora_us();
+    estatisticas_atuais.acordado_us += dormir_us - despertar_us;
+    hal_aguardar_interrupcao();
+    despertar_us = hal_agora_us();
+    estatisticas_atuais.dormindo_us += despertar_us - dormir_us;
+    estatisticas_atuais.despertares++;
+}
+
+bool energia_economia(void) {
+    return em_economia;
+}
+
+void energia_obter_estatisticas(energia_estatisticas_t *estatisticas) {
+    *estatisticas = estatisticas_atuais;
+    if (em_economia) estatisticas->economia_us += hal_agora_us() - economia_desde_us;
+}
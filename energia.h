@@ -0,0 +1,67 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hal.h"
+
+/**
+ * @brief Modo ocioso de baixo consumo: o laço principal dorme (WFI) quando não há trabalho.
+ *
+ * O processador só acorda por interrupção: borda de uma coluna do teclado, timers, fim do DMA
+ * ou USB. Depois de ENERGIA_OCIOSO_MS sem tecla, animação em andamento ou bytes da serial, o
+ * sistema entra em economia: o clock cai para ENERGIA_CLOCK_ECONOMIA_KHZ, com o divisor da PIO
+ * recalculado, e quem usa o módulo é avisado para espaçar seus timers (ENERGIA_TICK_ECONOMIA_MS).
+ * Qualquer atividade restaura o clock e os timers antes de o próximo frame ser transmitido.
+ */
+
+// Tempo sem atividade até entrar em economia
+#define ENERGIA_OCIOSO_MS 1000
+
+// Período sugerido para os timers em economia: limita a espera pelo primeiro frame vindo do PC
+#define ENERGIA_TICK_ECONOMIA_MS 50
+
+// Clock do sistema em economia (0 mantém o clock normal); 48 MHz divide exatamente o clock da PIO
+#ifndef ENERGIA_CLOCK_ECONOMIA_KHZ
+#define ENERGIA_CLOCK_ECONOMIA_KHZ 48000
+#endif
+
+typedef struct {
+    uint64_t dormindo_us;         // Tempo parado em WFI
+    uint64_t acordado_us;         // Tempo executando entre um despertar e o próximo WFI
+    uint64_t economia_us;         // Tempo em economia (incluído nos dois anteriores)
+    uint32_t despertares;
+    uint32_t entradas_economia;
+    uint32_t clock_khz;           // Clock atual do sistema
+} energia_estatisticas_t;
+
+// Avisa a entrada (true) ou a saída (false) da economia, já com o clock trocado
+typedef void (*energia_modo_t)(bool economia);
+
+/**
+ * @brief Prepara a contabilidade e o controle da economia.
+ *
+ * @param clock_khz Clock normal do sistema, restaurado ao sair da economia.
+ * @param trocar_clock false mantém o clock em economia (modo de dois núcleos: o núcleo 1
+ *                     transmite no seu próprio ritmo e a troca não pode ser coordenada daqui).
+ * @param ao_trocar Chamada nas trocas de modo, para ajustar os timers (pode ser NULL).
+ */
+void energia_init(uint32_t clock_khz, bool trocar_clock, energia_modo_t ao_trocar);
+
+// Registra trabalho (tecla, animação, serial): adia a economia e sai dela se estiver ativa
+void energia_atividade(void);
+
+/**
+ * @brief Chamada pelo laço principal sem trabalho pendente: dorme até a próxima interrupção.
+ *
+ * Um evento que chegue entre a última verificação e o WFI espera, no máximo, o próximo tick.
+ */
+void energia_ociosa(void);
+
+// Indica se o sistema está em economia
+bool energia_economia(void);
+
+void energia_obter_estatisticas(energia_estatisticas_t *estatisticas);
+
+#endif
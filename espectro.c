@@ -0,0 +1,164 @@
+#include "espectro.h"
+
+#include "cor.h"
+#include "layout.h"
+
+// Primeiro quarto de seno(2πk/ESPECTRO_N) em Q15, k = 0 a ESPECTRO_N/4; o resto do círculo sai por simetria
+static const int16_t seno_quarto[ESPECTRO_N / 4 + 1] = {
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,  6393,  7179,  7962,  8739,
+     9512, 10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279, 24811,
+    25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521,
+    32609, 32678, 32728, 32757, 32767,
+};
+
+// Maior amostra após remover o nível médio e converter para Q15: deixa um bit de folga para a FFT
+#define AMOSTRA_MAXIMA 16383
+
+static inline int32_t seno_q15(uint32_t k) {
+    k &= ESPECTRO_N - 1;
+    if (k >= ESPECTRO_N / 2) return -seno_q15(k - ESPECTRO_N / 2);
+    return seno_quarto[k <= ESPECTRO_N / 4 ? k : ESPECTRO_N / 2 - k];
+}
+
+static inline int32_t cosseno_q15(uint32_t k) {
+    return seno_q15(k + ESPECTRO_N / 4);
+}
+
+void espectro_init(espectro_t *e, uint32_t taxa_hz, uint16_t periodo_ms) {
+    static const uint32_t limites[ESPECTRO_BANDAS + 1] = ESPECTRO_LIMITES_HZ;
+
+    for (int b = 0; b < ESPECTRO_BANDAS; b++) {
+        uint32_t inicio = limites[b] * ESPECTRO_N / taxa_hz;
+        uint32_t fim = limites[b + 1] * ESPECTRO_N / taxa_hz;
+
+        // A raia 0 é o nível médio e as acima de ESPECTRO_N/2 espelham as de baixo
+        if (inicio < 1) inicio = 1;
+        if (fim > ESPECTRO_N / 2) fim = ESPECTRO_N / 2;
+        e->raia_inicio[b] = (uint16_t)inicio;
+        e->raia_fim[b] = (uint16_t)(fim > inicio ? fim - 1 : inicio);
+        e->nivel[b] = 0;
+        e->log2_modulo[b] = 0;
+    }
+    e->periodo_ms = periodo_ms;
+    e->blocos = 0;
+}
+
+void espectro_fft(int16_t *re, int16_t *im) {
+    // Permutação por inversão de bits dos índices
+    for (uint32_t i = 1, j = 0; i < ESPECTRO_N; i++) {
+        uint32_t bit = ESPECTRO_N >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            int16_t t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    // Borboletas de dizimação no tempo; o fator W = cos - j·sen é o mesmo para todo o grupo k
+    for (uint32_t tam = 2, passo = ESPECTRO_N / 2; tam <= ESPECTRO_N; tam <<= 1, passo >>= 1) {
+        uint32_t meio = tam >> 1;
+        for (uint32_t k = 0; k < meio; k++) {
+            int32_t wr = cosseno_q15(k * passo), wi = seno_q15(k * passo);
+            for (uint32_t i = k; i < ESPECTRO_N; i += tam) {
+                uint32_t j = i + meio;
+                int32_t tr = (wr * re[j] + wi * im[j]) >> 15;
+                int32_t ti = (wr * im[j] - wi * re[j]) >> 15;
+                int32_t ar = re[i], ai = im[i];
+                re[j] = (int16_t)((ar - tr) >> 1);
+                im[j] = (int16_t)((ai - ti) >> 1);
+                re[i] = (int16_t)((ar + tr) >> 1);
+                im[i] = (int16_t)((ai + ti) >> 1);
+            }
+        }
+    }
+}
+
+// log2 em 1/16 de oitava: posição do bit mais alto e os 4 bits seguintes (0 para m = 0)
+static uint16_t log2_q4(uint32_t m) {
+    uint32_t p = 0;
+
+    if (m == 0) return 0;
+    while (m >> (p + 1)) p++;
+    uint32_t fracao = p >= 4 ? m >> (p - 4) : m << (4 - p);
+    return (uint16_t)(p * 16 + (fracao & 15));
+}
+
+void espectro_bloco(espectro_t *e, const uint16_t *amostras) {
+    uint32_t soma = 0;
+
+    for (uint32_t n = 0; n < ESPECTRO_N; n++) soma += amostras[n];
+    int32_t media = (int32_t)(soma >> ESPECTRO_LOG2_N);
+
+    // 12 bits sem o nível médio, em Q15 (x8), pela janela de Hann: (1 - cos) / 2
+    for (uint32_t n = 0; n < ESPECTRO_N; n++) {
+        int32_t x = ((int32_t)amostras[n] - media) * 8;
+        if (x > AMOSTRA_MAXIMA) x = AMOSTRA_MAXIMA;
+        if (x < -AMOSTRA_MAXIMA) x = -AMOSTRA_MAXIMA;
+        int32_t janela = (32767 - cosseno_q15(n)) >> 1;
+        e->re[n] = (int16_t)((x * janela) >> 15);
+        e->im[n] = 0;
+    }
+
+    espectro_fft(e->re, e->im);
+
+    for (int b = 0; b < ESPECTRO_BANDAS; b++) {
+        // Módulo aproximado de cada raia: maior componente + 3/8 da menor (erro abaixo de 7%)
+        uint32_t maior = 0;
+        for (uint32_t k = e->raia_inicio[b]; k <= e->raia_fim[b]; k++) {
+            uint32_t a = (uint32_t)(e->re[k] < 0 ? -e->re[k] : e->re[k]);
+            uint32_t c = (uint32_t)(e->im[k] < 0 ? -e->im[k] : e->im[k]);
+            uint32_t m = a > c ? a + ((c * 3) >> 3) : c + ((a * 3) >> 3);
+            if (m > maior) maior = m;
+        }
+
+        uint16_t l = log2_q4(maior);
+        int32_t alvo = ((int32_t)l - ESPECTRO_PISO_LOG2) * 255 / (ESPECTRO_TOPO_LOG2 - ESPECTRO_PISO_LOG2);
+        if (alvo < 0) alvo = 0;
+        if (alvo > 255) alvo = 255;
+
+        // Sobe de imediato e cai devagar, para que batidas curtas continuem visíveis
+        int32_t nivel = e->nivel[b];
+        if (alvo >= nivel) nivel = alvo;
+        else nivel = nivel - ESPECTRO_QUEDA > alvo ? nivel - ESPECTRO_QUEDA : alvo;
+
+        e->log2_modulo[b] = l;
+        e->nivel[b] = (uint8_t)nivel;
+    }
+    e->blocos++;
+}
+
+void espectro_quadro(const espectro_t *e, uint32_t *frame) {
+    // Cores por terço da altura, da base para o topo
+    static const uint8_t cores[3][3] = {{0, 255, 0}, {255, 160, 0}, {255, 0, 0}};
+    uint32_t altura = layout_matriz.altura;
+
+    uint32_t apagado = cor_grb(0, 0, 0);
+    for (uint32_t i = 0; i < layout_matriz.num_pixels; i++) frame[i] = apagado;
+
+    for (uint32_t x = 0; x < ESPECTRO_BANDAS && x < layout_matriz.largura; x++) {
+        // Altura em 1/256 de LED (x 257/256: o nível 255 enche a coluna)
+        uint32_t total = (e->nivel[x] * altura * 257u) >> 8;
+        uint32_t cheios = total >> 8, fracao = total & 255;
+
+        for (uint32_t i = 0; i < altura && i <= cheios; i++) {
+            uint32_t intensidade = i < cheios ? 256 : fracao;
+            if (intensidade == 0) break;
+            const uint8_t *c = cores[i * 3 / altura];
+            frame[layout_fisico(&layout_matriz, (uint16_t)x, (uint16_t)(altura - 1 - i))] =
+                cor_grb((uint8_t)((c[0] * intensidade) >> 8), (uint8_t)((c[1] * intensidade) >> 8),
+                        (uint8_t)((c[2] * intensidade) >> 8));
+        }
+    }
+}
+
+bool espectro_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms) {
+    espectro_t *e = contexto;
+
+    (void)passo;
+    espectro_quadro(e, frame);
+    *duracao_ms = e->periodo_ms;
+    return true;
+}
@@ -0,0 +1,87 @@
+#ifndef ESPECTRO_H
+#define ESPECTRO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Analisador de espectro em ponto fixo para o visualizador de áudio (tecla '*').
+ *
+ * Cada bloco de ESPECTRO_N amostras de 12 bits do ADC tem o nível médio removido, passa por uma
+ * janela de Hann e por uma FFT radix-2 em Q15 que divide por 2 a cada estágio (o resultado é a
+ * DFT / ESPECTRO_N, sem risco de estouro em 16 bits). O maior módulo entre as raias de cada uma
+ * das ESPECTRO_BANDAS faixas de frequência vira um nível logarítmico de 0 a 255, exibido como a
+ * altura de uma coluna da matriz. As colunas sobem de imediato e caem ESPECTRO_QUEDA por bloco.
+ *
+ * Só usa inteiros: a tabela de senos fica em flash e não há math.h nem ponto flutuante.
+ */
+
+// Amostras por bloco (potência de 2) e taxa de amostragem: 256 / 16 kHz = 16 ms, 62,5 blocos/s
+#define ESPECTRO_N 256
+#define ESPECTRO_LOG2_N 8
+#define ESPECTRO_TAXA_HZ 16000
+
+// Faixas de frequência, uma por coluna da matriz
+#define ESPECTRO_BANDAS 5
+
+// Níveis de log2 do módulo (em 1/16 de oitava) mapeados para coluna vazia e coluna cheia:
+// o piso fica pouco acima do ruído de quantização da FFT e o topo num seno de meia escala (±1024 no ADC)
+#define ESPECTRO_PISO_LOG2 (3 * 16)
+#define ESPECTRO_TOPO_LOG2 (11 * 16)
+
+// Queda de cada coluna por bloco (de 0 a 255): uma coluna cheia esvazia em ~0,5 s
+#define ESPECTRO_QUEDA 8
+
+// Limites das faixas em Hz (graves, médio-graves, médios, médio-agudos e agudos)
+#define ESPECTRO_LIMITES_HZ {60, 250, 500, 1000, 2000, 8000}
+
+typedef struct {
+    // Raias da FFT de cada faixa, de inicio a fim (inclusive)
+    uint16_t raia_inicio[ESPECTRO_BANDAS], raia_fim[ESPECTRO_BANDAS];
+
+    // Nível exibido de cada faixa (0 a 255) e o log2 do maior módulo do último bloco
+    volatile uint8_t nivel[ESPECTRO_BANDAS];
+    uint16_t log2_modulo[ESPECTRO_BANDAS];
+
+    uint16_t periodo_ms;    // Duração de cada frame quando usado como gerador
+    uint32_t blocos;        // Blocos analisados desde espectro_init
+
+    // Área de trabalho da FFT
+    int16_t re[ESPECTRO_N], im[ESPECTRO_N];
+} espectro_t;
+
+/**
+ * @brief Prepara o analisador com as colunas vazias.
+ *
+ * @param taxa_hz Taxa de amostragem, usada para converter ESPECTRO_LIMITES_HZ em raias.
+ * @param periodo_ms Intervalo entre frames quando usado como gerador (normalmente o tick das animações).
+ */
+void espectro_init(espectro_t *e, uint32_t taxa_hz, uint16_t periodo_ms);
+
+/**
+ * @brief FFT complexa in-place de ESPECTRO_N pontos em Q15, com divisão por 2 a cada estágio.
+ *
+ * Exposta para os testes e o benchmark do host; com entradas de módulo até 2^14 nenhum estágio estoura.
+ */
+void espectro_fft(int16_t *re, int16_t *im);
+
+/**
+ * @brief Analisa um bloco de ESPECTRO_N amostras de 12 bits e atualiza os níveis das colunas.
+ */
+void espectro_bloco(espectro_t *e, const uint16_t *amostras);
+
+/**
+ * @brief Desenha as colunas: verde na base, amarelo no meio e vermelho no topo.
+ *
+ * O LED mais alto de cada coluna acende com a fração do nível que não completa um LED.
+ */
+void espectro_quadro(const espectro_t *e, uint32_t *frame);
+
+/**
+ * @brief Gerador de animação (anim_gerador_t): desenha os níveis atuais a cada periodo_ms.
+ *
+ * A sequência não termina; os níveis são atualizados por espectro_bloco fora da interrupção.
+ */
+bool espectro_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms);
+
+#endif
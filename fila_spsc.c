@@ -0,0 +1,66 @@
+#include "fila_spsc.h"
+
+#include <string.h>
+
+void fila_spsc_init(fila_spsc_t *fila, void *buffer, uint32_t tamanho_elemento, uint32_t capacidade) {
+    fila->dados = buffer;
+    fila->tamanho_elemento = tamanho_elemento;
+    fila->mascara = capacidade - 1;
+    fila->cabeca = 0;
+    fila->cauda = 0;
+}
+
+bool fila_spsc_inserir(fila_spsc_t *fila, const void *elemento) {
+    uint32_t c = fila->cabeca;
+    if (c - __atomic_load_n(&fila->cauda, __ATOMIC_ACQUIRE) > fila->mascara) return false;
+
+    memcpy(fila->dados + (c & fila->mascara) * fila->tamanho_elemento, elemento, fila->tamanho_elemento);
+    __atomic_store_n(&fila->cabeca, c + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool fila_spsc_retirar(fila_spsc_t *fila, void *elemento) {
+    uint32_t t = fila->cauda;
+    if (t == __atomic_load_n(&fila->cabeca, __ATOMIC_ACQUIRE)) return false;
+
+    memcpy(elemento, fila->dados + (t & fila->mascara) * fila->tamanho_elemento, fila->tamanho_elemento);
+    __atomic_store_n(&fila->cauda, t + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+uint32_t fila_spsc_inserir_varios(fila_spsc_t *fila, const void *elementos, uint32_t quantidade) {
+    uint32_t c = fila->cabeca;
+    uint32_t livres = fila->mascara + 1 - (c - __atomic_load_n(&fila->cauda, __ATOMIC_ACQUIRE));
+    if (quantidade > livres) quantidade = livres;
+
+    // Até duas cópias: do índice atual ao fim do buffer e, se preciso, a partir do início
+    uint32_t inicio = c & fila->mascara;
+    uint32_t ate_o_fim = fila->mascara + 1 - inicio;
+    uint32_t primeiro = quantidade < ate_o_fim ? quantidade : ate_o_fim;
+    memcpy(fila->dados + inicio * fila->tamanho_elemento, elementos, primeiro * fila->tamanho_elemento);
+    memcpy(fila->dados, (const uint8_t *)elementos + primeiro * fila->tamanho_elemento,
+           (quantidade - primeiro) * fila->tamanho_elemento);
+
+    __atomic_store_n(&fila->cabeca, c + quantidade, __ATOMIC_RELEASE);
+    return quantidade;
+}
+
+uint32_t fila_spsc_retirar_varios(fila_spsc_t *fila, void *elementos, uint32_t maximo) {
+    uint32_t t = fila->cauda;
+    uint32_t quantidade = __atomic_load_n(&fila->cabeca, __ATOMIC_ACQUIRE) - t;
+    if (quantidade > maximo) quantidade = maximo;
+
+    uint32_t inicio = t & fila->mascara;
+    uint32_t ate_o_fim = fila->mascara + 1 - inicio;
+    uint32_t primeiro = quantidade < ate_o_fim ? quantidade : ate_o_fim;
+    memcpy(elementos, fila->dados + inicio * fila->tamanho_elemento, primeiro * fila->tamanho_elemento);
+    memcpy((uint8_t *)elementos + primeiro * fila->tamanho_elemento, fila->dados,
+           (quantidade - primeiro) * fila->tamanho_elemento);
+
+    __atomic_store_n(&fila->cauda, t + quantidade, __ATOMIC_RELEASE);
+    return quantidade;
+}
+
+uint32_t fila_spsc_ocupacao(const fila_spsc_t *fila) {
+    return __atomic_load_n(&fila->cabeca, __ATOMIC_ACQUIRE) - __atomic_load_n(&fila->cauda, __ATOMIC_ACQUIRE);
+}
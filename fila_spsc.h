@@ -0,0 +1,46 @@
+#ifndef FILA_SPSC_H
+#define FILA_SPSC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Fila circular sem travas para um único produtor e um único consumidor.
+ *
+ * O produtor só escreve cabeca e o consumidor só escreve cauda; a publicação usa semântica
+ * acquire/release, então a fila é segura entre interrupção e laço principal ou entre os dois
+ * núcleos do RP2040. Os índices crescem livremente e são reduzidos pela máscara da capacidade.
+ */
+typedef struct {
+    uint8_t *dados;
+    uint32_t tamanho_elemento;
+    uint32_t mascara;
+    uint32_t cabeca;
+    uint32_t cauda;
+} fila_spsc_t;
+
+/**
+ * @brief Inicializa a fila sobre um buffer fornecido pelo chamador.
+ *
+ * @param buffer Área com capacidade * tamanho_elemento bytes.
+ * @param tamanho_elemento Tamanho de cada elemento em bytes.
+ * @param capacidade Número de elementos; deve ser potência de 2.
+ */
+void fila_spsc_init(fila_spsc_t *fila, void *buffer, uint32_t tamanho_elemento, uint32_t capacidade);
+
+// Copia um elemento para a fila (lado produtor); retorna false se estiver cheia
+bool fila_spsc_inserir(fila_spsc_t *fila, const void *elemento);
+
+// Copia o elemento mais antigo para o destino (lado consumidor); retorna false se estiver vazia
+bool fila_spsc_retirar(fila_spsc_t *fila, void *elemento);
+
+// Copia até "quantidade" elementos consecutivos para a fila (lado produtor); retorna quantos couberam
+uint32_t fila_spsc_inserir_varios(fila_spsc_t *fila, const void *elementos, uint32_t quantidade);
+
+// Copia até "maximo" elementos para o destino (lado consumidor); retorna quantos foram retirados
+uint32_t fila_spsc_retirar_varios(fila_spsc_t *fila, void *elementos, uint32_t maximo);
+
+// Quantidade de elementos pendentes (aproximada se consultada durante operações do outro lado)
+uint32_t fila_spsc_ocupacao(const fila_spsc_t *fila);
+
+#endif
@@ -0,0 +1,79 @@
+#include "fonte.h"
+
+#include "layout.h"
+
+const uint32_t fonte5x5[FONTE_NUM_GLIFOS] = {
+    [' ' - FONTE_PRIMEIRO] = GLIFO(0b00000, 0b00000, 0b00000, 0b00000, 0b00000),
+    ['!' - FONTE_PRIMEIRO] = GLIFO(0b00100, 0b00100, 0b00100, 0b00000, 0b00100),
+    ['#' - FONTE_PRIMEIRO] = GLIFO(0b01010, 0b11111, 0b01010, 0b11111, 0b01010),
+    ['\'' - FONTE_PRIMEIRO] = GLIFO(0b00100, 0b00100, 0b00000, 0b00000, 0b00000),
+    ['(' - FONTE_PRIMEIRO] = GLIFO(0b00010, 0b00100, 0b00100, 0b00100, 0b00010),
+    [')' - FONTE_PRIMEIRO] = GLIFO(0b01000, 0b00100, 0b00100, 0b00100, 0b01000),
+    ['*' - FONTE_PRIMEIRO] = GLIFO(0b10101, 0b01110, 0b11111, 0b01110, 0b10101),
+    ['+' - FONTE_PRIMEIRO] = GLIFO(0b00000, 0b00100, 0b01110, 0b00100, 0b00000),
+    [',' - FONTE_PRIMEIRO] = GLIFO(0b00000, 0b00000, 0b00000, 0b00100, 0b01000),
+    ['-' - FONTE_PRIMEIRO] = GLIFO(0b00000, 0b00000, 0b01110, 0b00000, 0b00000),
+    ['.' - FONTE_PRIMEIRO] = GLIFO(0b00000, 0b00000, 0b00000, 0b00000, 0b00100),
+    ['/' - FONTE_PRIMEIRO] = GLIFO(0b00001, 0b00010, 0b00100, 0b01000, 0b10000),
+    ['0' - FONTE_PRIMEIRO] = GLIFO(0b01110, 0b10011, 0b10101, 0b11001, 0b01110),
+    ['1' - FONTE_PRIMEIRO] = GLIFO(0b00100, 0b01100, 0b00100, 0b00100, 0b01110),
+    ['2' - FONTE_PRIMEIRO] = GLIFO(0b01110, 0b10001, 0b00110, 0b01000, 0b11111),
+    ['3' - FONTE_PRIMEIRO] = GLIFO(0b01110, 0b10001, 0b00110, 0b10001, 0b01110),
+    ['4' - FONTE_PRIMEIRO] = GLIFO(0b00100, 0b01100, 0b11110, 0b00100, 0b00100),
+    ['5' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b10000, 0b11111, 0b00001, 0b11111),
+    ['6' - FONTE_PRIMEIRO] = GLIFO(0b11110, 0b10000, 0b11111, 0b10001, 0b11111),
+    ['7' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b00001, 0b00010, 0b00100, 0b01000),
+    ['8' - FONTE_PRIMEIRO] = GLIFO(0b01110, 0b10001, 0b01110, 0b10001, 0b01110),
+    ['9' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b10001, 0b11111, 0b00001, 0b11111),
+    [':' - FONTE_PRIMEIRO] = GLIFO(0b00000, 0b00100, 0b00000, 0b00100, 0b00000),
+    ['<' - FONTE_PRIMEIRO] = GLIFO(0b00010, 0b00100, 0b01000, 0b00100, 0b00010),
+    ['=' - FONTE_PRIMEIRO] = GLIFO(0b00000, 0b01110, 0b00000, 0b01110, 0b00000),
+    ['>' - FONTE_PRIMEIRO] = GLIFO(0b01000, 0b00100, 0b00010, 0b00100, 0b01000),
+    ['?' - FONTE_PRIMEIRO] = GLIFO(0b01110, 0b10001, 0b00110, 0b00000, 0b00100),
+    ['A' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b10001, 0b11111, 0b10001, 0b10001),
+    ['B' - FONTE_PRIMEIRO] = GLIFO(0b11110, 0b10001, 0b11110, 0b10001, 0b11110),
+    ['C' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b10000, 0b10000, 0b10000, 0b11111),
+    ['D' - FONTE_PRIMEIRO] = GLIFO(0b11110, 0b10001, 0b10001, 0b10001, 0b11110),
+    ['E' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b10000, 0b11110, 0b10000, 0b11111),
+    ['F' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b10000, 0b11111, 0b10000, 0b10000),
+    ['G' - FONTE_PRIMEIRO] = GLIFO(0b01110, 0b10000, 0b10111, 0b10001, 0b01111),
+    ['H' - FONTE_PRIMEIRO] = GLIFO(0b10001, 0b10001, 0b11111, 0b10001, 0b10001),
+    ['I' - FONTE_PRIMEIRO] = GLIFO(0b01110, 0b00100, 0b00100, 0b00100, 0b01110),
+    ['J' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b00100, 0b00100, 0b10100, 0b11100),
+    ['K' - FONTE_PRIMEIRO] = GLIFO(0b10010, 0b10100, 0b11000, 0b10100, 0b10010),
+    ['L' - FONTE_PRIMEIRO] = GLIFO(0b10000, 0b10000, 0b10000, 0b10000, 0b11111),
+    ['M' - FONTE_PRIMEIRO] = GLIFO(0b10001, 0b11011, 0b10101, 0b10001, 0b10001),
+    ['N' - FONTE_PRIMEIRO] = GLIFO(0b10001, 0b11001, 0b10101, 0b10011, 0b10001),
+    ['O' - FONTE_PRIMEIRO] = GLIFO(0b01110, 0b10001, 0b10001, 0b10001, 0b01110),
+    ['P' - FONTE_PRIMEIRO] = GLIFO(0b11110, 0b10001, 0b11110, 0b10000, 0b10000),
+    ['Q' - FONTE_PRIMEIRO] = GLIFO(0b01110, 0b10001, 0b10101, 0b10011, 0b01111),
+    ['R' - FONTE_PRIMEIRO] = GLIFO(0b11110, 0b10001, 0b11110, 0b10100, 0b10010),
+    ['S' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b10000, 0b11111, 0b00001, 0b11111),
+    ['T' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b00100, 0b00100, 0b00100, 0b00100),
+    ['U' - FONTE_PRIMEIRO] = GLIFO(0b10001, 0b10001, 0b10001, 0b10001, 0b11111),
+    ['V' - FONTE_PRIMEIRO] = GLIFO(0b10001, 0b10001, 0b10001, 0b01010, 0b00100),
+    ['W' - FONTE_PRIMEIRO] = GLIFO(0b10001, 0b10001, 0b10101, 0b11011, 0b10001),
+    ['X' - FONTE_PRIMEIRO] = GLIFO(0b10001, 0b01010, 0b00100, 0b01010, 0b10001),
+    ['Y' - FONTE_PRIMEIRO] = GLIFO(0b10001, 0b10001, 0b01110, 0b00100, 0b00100),
+    ['Z' - FONTE_PRIMEIRO] = GLIFO(0b11111, 0b00010, 0b00100, 0b01000, 0b11111),
+};
+
+uint32_t fonte_glifo(char c) {
+    if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+    if (c < FONTE_PRIMEIRO || c > FONTE_ULTIMO) return 0;
+    return fonte5x5[c - FONTE_PRIMEIRO];
+}
+
+void fonte_desenhar(uint32_t glifo, uint32_t cor_acesa, uint32_t cor_apagada, uint32_t *frame) {
+    uint32_t diferenca = cor_acesa ^ cor_apagada;
+    int bit = FONTE_PIXELS - 1;
+    for (int l = 0; l < FONTE_ALTURA; l++) {
+        // Posições físicas da linha, já na tabela do layout
+        const uint16_t *fisico = &layout_matriz.fisico[l * layout_matriz.largura];
+        for (int c = 0; c < FONTE_LARGURA; c++, bit--) {
+            // Máscara com todos os bits em 1 quando o pixel está aceso
+            uint32_t aceso = 0u - ((glifo >> bit) & 1u);
+            frame[fisico[c]] = cor_apagada ^ (diferenca & aceso);
+        }
+    }
+}
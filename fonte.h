@@ -0,0 +1,50 @@
+#ifndef FONTE_H
+#define FONTE_H
+
+#include <stdint.h>
+
+// Dimensões de um glifo da fonte (igual à matriz de LEDs)
+#define FONTE_LARGURA 5
+#define FONTE_ALTURA 5
+#define FONTE_PIXELS (FONTE_LARGURA * FONTE_ALTURA)
+
+// Faixa de caracteres ASCII presentes na fonte (espaço até 'Z'); minúsculas usam o glifo maiúsculo
+#define FONTE_PRIMEIRO ' '
+#define FONTE_ULTIMO 'Z'
+#define FONTE_NUM_GLIFOS (FONTE_ULTIMO - FONTE_PRIMEIRO + 1)
+
+/**
+ * @brief Monta um glifo de 25 bits a partir de suas 5 linhas, de cima para baixo.
+ *
+ * Cada linha é um valor de 5 bits com a coluna da esquerda no bit mais significativo,
+ * de modo que o pixel (linha, coluna) ocupa o bit 24 - (linha * 5 + coluna).
+ */
+#define GLIFO(l0, l1, l2, l3, l4) \
+    (((uint32_t)(l0) << 20) | ((uint32_t)(l1) << 15) | ((uint32_t)(l2) << 10) | ((uint32_t)(l3) << 5) | (uint32_t)(l4))
+
+// Tabela de glifos em flash, indexada por (caractere - FONTE_PRIMEIRO)
+extern const uint32_t fonte5x5[FONTE_NUM_GLIFOS];
+
+/**
+ * @brief Retorna o glifo de um caractere.
+ *
+ * @param c Caractere ASCII; letras minúsculas são convertidas para maiúsculas.
+ * @return Máscara de 25 bits do glifo, ou um glifo vazio se o caractere não existir na fonte.
+ */
+uint32_t fonte_glifo(char c);
+
+/**
+ * @brief Expande um glifo em um frame pronto para envio à matriz.
+ *
+ * Cada pixel recebe uma das duas palavras já codificadas, sem desvios por pixel, e é gravado
+ * na posição física que layout_matriz (layout.h) atribui ao pixel lógico; com um mosaico, o
+ * glifo ocupa o canto superior esquerdo da imagem.
+ *
+ * @param glifo Máscara de 25 bits do glifo.
+ * @param cor_acesa Palavra GRB dos pixels acesos.
+ * @param cor_apagada Palavra GRB dos pixels apagados.
+ * @param frame Destino com FONTE_PIXELS palavras.
+ */
+void fonte_desenhar(uint32_t glifo, uint32_t cor_acesa, uint32_t cor_apagada, uint32_t *frame);
+
+#endif
@@ -0,0 +1,69 @@
+#include "frame_dma.h"
+
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "trace.h"
+
+static int canal_dma = -1;
+
+// Estado da transferência atual, compartilhado com a interrupção do DMA
+static volatile bool transferindo = false;
+static volatile uint64_t liberado_em_us = 0;
+static volatile uint32_t frames_concluidos = 0;
+static frame_dma_callback_t callback_atual = NULL;
+static void *contexto_atual = NULL;
+
+// Tratador da interrupção DMA_IRQ_0, compartilhada com outros canais
+static void frame_dma_irq_handler(void) {
+    if (canal_dma < 0 || !dma_channel_get_irq0_status(canal_dma)) return;
+    dma_channel_acknowledge_irq0(canal_dma);
+
+    // A última palavra entrou na FIFO; a matriz só aceita outro frame após esvaziá-la e receber o reset
+    liberado_em_us = time_us_64() + FRAME_DMA_LATCH_US;
+    transferindo = false;
+    frames_concluidos++;
+    TRACE(TRACE_FIFO_VAZIA, 0);
+
+    if (callback_atual) callback_atual(contexto_atual);
+}
+
+void frame_dma_init(PIO pio, uint sm) {
+    canal_dma = dma_claim_unused_channel(true);
+
+    // Palavras de 32 bits, lendo o buffer de forma incremental e escrevendo sempre na FIFO TX
+    dma_channel_config c = dma_channel_get_default_config(canal_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(canal_dma, &c, &pio->txf[sm], NULL, 0, false);
+
+    dma_channel_set_irq0_enabled(canal_dma, true);
+    irq_add_shared_handler(DMA_IRQ_0, frame_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+bool frame_dma_enviar(const uint32_t *frame, uint num_palavras, frame_dma_callback_t callback, void *contexto) {
+    if (frame_dma_ocupado()) return false;
+
+    callback_atual = callback;
+    contexto_atual = contexto;
+    transferindo = true;
+    dma_channel_transfer_from_buffer_now(canal_dma, frame, num_palavras);
+    return true;
+}
+
+bool frame_dma_ocupado(void) {
+    return transferindo || time_us_64() < liberado_em_us;
+}
+
+void frame_dma_aguardar(void) {
+    while (frame_dma_ocupado()) {
+        tight_loop_contents();
+    }
+}
+
+uint32_t frame_dma_frames_concluidos(void) {
+    return frames_concluidos;
+}
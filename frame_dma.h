@@ -0,0 +1,53 @@
+#ifndef FRAME_DMA_H
+#define FRAME_DMA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/pio.h"
+#include "led_protocolo.h"
+
+// Tempo mínimo (em µs) entre o fim da transferência DMA e o próximo frame: esvaziamento da FIFO
+// TX (8 palavras) e da OSR (1) mais o pulso de reset do protocolo (320 µs no WS2812)
+#define FRAME_DMA_LATCH_US (9u * LED_US_POR_PIXEL + LED_RESET_US)
+
+/**
+ * @brief Função chamada, em contexto de interrupção, quando o DMA termina de entregar um frame à FIFO.
+ *
+ * @param contexto Ponteiro fornecido em frame_dma_enviar.
+ */
+typedef void (*frame_dma_callback_t)(void *contexto);
+
+/**
+ * @brief Reserva um canal DMA e o associa à FIFO TX da state machine da matriz.
+ *
+ * O canal é pautado pelo DREQ de TX da state machine, de modo que cada palavra só é
+ * escrita quando há espaço na FIFO. Deve ser chamada após pio_matrix_program_init.
+ *
+ * @param pio Controlador PIO que executa o programa pio_matrix.
+ * @param sm State machine do programa pio_matrix.
+ */
+void frame_dma_init(PIO pio, uint sm);
+
+/**
+ * @brief Inicia a transmissão de um frame já codificado (palavras de led_palavra, uma por LED).
+ *
+ * Retorna imediatamente; o buffer não pode ser alterado até a conclusão (ver frame_dma_ocupado).
+ *
+ * @param frame Palavras a serem enviadas, uma por LED.
+ * @param num_palavras Quantidade de palavras do frame.
+ * @param callback Função chamada ao fim da transferência (pode ser NULL).
+ * @param contexto Valor repassado ao callback.
+ * @return true se a transferência foi iniciada, false se um frame ainda está em andamento.
+ */
+bool frame_dma_enviar(const uint32_t *frame, uint num_palavras, frame_dma_callback_t callback, void *contexto);
+
+// Indica se há um frame em transmissão (DMA ativo ou aguardando o reset dos LEDs)
+bool frame_dma_ocupado(void);
+
+// Bloqueia até que o frame em andamento termine e a matriz esteja pronta para o próximo
+void frame_dma_aguardar(void);
+
+// Número de frames concluídos desde a inicialização
+uint32_t frame_dma_frames_concluidos(void);
+
+#endif
@@ -0,0 +1,60 @@
+#include "framebuffer.h"
+
+#include <string.h>
+
+static uint32_t buffers[2][FB_MAX_PALAVRAS];
+static uint8_t frente = 0;
+static bool frente_valida = false;
+static uint32_t palavras = 0;
+static fb_saida_t saida_atual;
+static fb_estatisticas_t estatisticas_atuais;
+
+void fb_init(fb_saida_t saida, uint32_t num_palavras) {
+    saida_atual = saida;
+    palavras = num_palavras <= FB_MAX_PALAVRAS ? num_palavras : FB_MAX_PALAVRAS;
+    frente = 0;
+    frente_valida = false;
+    memset(buffers, 0, sizeof(buffers));
+    memset(&estatisticas_atuais, 0, sizeof(estatisticas_atuais));
+}
+
+uint32_t *fb_traseiro(void) {
+    return buffers[frente ^ 1];
+}
+
+// Compara dois frames parando na primeira palavra diferente (frames estáticos costumam ser iguais do início ao fim)
+static bool frames_iguais(const uint32_t *a, const uint32_t *b) {
+    for (uint32_t i = 0; i < palavras; i++) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+fb_resultado_t fb_apresentar(void) {
+    uint32_t *traseiro = buffers[frente ^ 1];
+
+    if (frente_valida && frames_iguais(traseiro, buffers[frente])) {
+        estatisticas_atuais.ignorados++;
+        return FB_IGNORADO;
+    }
+
+    // A saída só aceita um frame quando terminou o anterior, então o antigo buffer da frente já está livre
+    if (!saida_atual(traseiro)) return FB_OCUPADO;
+
+    frente ^= 1;
+    frente_valida = true;
+    estatisticas_atuais.apresentados++;
+    estatisticas_atuais.bytes_enviados += palavras * sizeof(uint32_t);
+
+    memcpy(buffers[frente ^ 1], buffers[frente], palavras * sizeof(uint32_t));
+    return FB_APRESENTADO;
+}
+
+bool fb_enviar(const uint32_t *frame) {
+    memcpy(buffers[frente ^ 1], frame, palavras * sizeof(uint32_t));
+    return fb_apresentar() != FB_OCUPADO;
+}
+
+void fb_obter_estatisticas(fb_estatisticas_t *estatisticas) {
+    *estatisticas = estatisticas_atuais;
+}
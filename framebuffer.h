@@ -0,0 +1,59 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Maior frame (em palavras da FIFO) que o framebuffer comporta
+#define FB_MAX_PALAVRAS 256
+
+// Envia um frame à matriz sem bloquear; retorna false se a saída ainda estiver ocupada
+typedef bool (*fb_saida_t)(const uint32_t *frame);
+
+typedef enum {
+    FB_APRESENTADO,  // Frame diferente do exibido: enviado e trocado com o buffer da frente
+    FB_IGNORADO,     // Igual ao último frame transmitido: nada foi enviado
+    FB_OCUPADO       // Saída ocupada: o buffer de trás permanece como está, tente novamente
+} fb_resultado_t;
+
+typedef struct {
+    uint32_t apresentados;
+    uint32_t ignorados;
+    uint32_t bytes_enviados;  // Bytes entregues à FIFO (4 por palavra)
+} fb_estatisticas_t;
+
+/**
+ * @brief Inicializa o framebuffer duplo.
+ *
+ * O buffer da frente é o último frame transmitido e só é lido pela saída (DMA); o de trás é
+ * desenhado pelo programa. O primeiro fb_apresentar sempre transmite.
+ *
+ * @param saida Função que entrega o frame à matriz (ex.: enviar_frame).
+ * @param num_palavras Palavras por frame, até FB_MAX_PALAVRAS.
+ */
+void fb_init(fb_saida_t saida, uint32_t num_palavras);
+
+// Buffer de trás, onde o próximo frame é desenhado; começa com o conteúdo do último frame exibido
+uint32_t *fb_traseiro(void);
+
+/**
+ * @brief Compara o buffer de trás com o último frame transmitido e o envia apenas se mudou.
+ *
+ * A comparação é palavra a palavra e para na primeira diferença. Após um envio os buffers são
+ * trocados e o novo buffer de trás recebe uma cópia do frame exibido, permitindo desenho incremental.
+ */
+fb_resultado_t fb_apresentar(void);
+
+/**
+ * @brief Copia um frame pronto para o buffer de trás e o apresenta.
+ *
+ * Tem a assinatura de anim_saida_t, para ser usada como saída do escalonador de animações.
+ *
+ * @return false somente se a saída estiver ocupada; um frame repetido conta como exibido.
+ */
+bool fb_enviar(const uint32_t *frame);
+
+// Copia os contadores de frames apresentados, ignorados e bytes enviados
+void fb_obter_estatisticas(fb_estatisticas_t *estatisticas);
+
+#endif
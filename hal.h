@@ -0,0 +1,166 @@
+#ifndef HAL_H
+#define HAL_H
+
+/**
+ * @brief Camada fina de abstração de hardware (GPIO, saída dos LEDs, tempo, timers e stdio).
+ *
+ * O firmware usa apenas estas funções; hal_pico.c as implementa com o SDK da Raspberry Pi Pico
+ * e host/hal_host.c com um backend simulado que grava as operações, permitindo compilar e
+ * executar a mesma lógica de varredura, renderização e comandos no Linux.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef PIO_MATRIX_HOST
+typedef unsigned int uint;
+#else
+#include "pico/stdlib.h"
+#endif
+
+// ----- Sistema -----
+
+/**
+ * @brief Ajusta o clock do sistema e inicializa a stdio (UART/USB).
+ *
+ * @param khz Frequência desejada do clock do sistema.
+ * @return Frequência efetiva em Hz, ou 0 se não foi possível ajustá-la.
+ */
+uint32_t hal_sistema_iniciar(uint32_t khz);
+
+/**
+ * @brief Troca o clock do sistema em funcionamento e recalcula o divisor da PIO dos LEDs.
+ *
+ * A UART da stdio tem o baud rate refeito, pois seu clock segue o do sistema.
+ *
+ * @return false se um frame estiver em transmissão (a troca alteraria os bits no fio) ou se a
+ *         frequência não puder ser gerada.
+ */
+bool hal_sistema_ajustar_clock(uint32_t khz);
+
+// ----- GPIO -----
+
+void hal_gpio_saida(uint pino);
+void hal_gpio_entrada_pullup(uint pino);
+void hal_gpio_escrever(uint pino, bool valor);
+bool hal_gpio_ler(uint pino);
+
+// Função chamada, em contexto de interrupção, na borda de descida de um pino habilitado
+typedef void (*hal_gpio_irq_t)(uint pino);
+
+// Registra a função de interrupção de GPIO (uma para todos os pinos)
+void hal_gpio_irq_callback(hal_gpio_irq_t callback);
+
+// Habilita ou desabilita a interrupção de borda de descida de um pino
+void hal_gpio_irq_descida(uint pino, bool habilitar);
+
+// ----- Teclado matricial (varredura pela PIO) -----
+
+// Função chamada, em contexto de interrupção, com cada leitura do teclado que difere da anterior
+typedef void (*hal_teclado_leitura_t)(uint16_t bruto);
+
+/**
+ * @brief Entrega a varredura do teclado 4x4 ao hardware, sem a CPU.
+ *
+ * A leitura tem o bit linha * 4 + coluna em 1 quando a tecla está fechada e só é entregue quando
+ * muda, de modo que várias teclas ao mesmo tempo aparecem juntas. Configura os pinos das linhas
+ * e das colunas.
+ *
+ * @return false se a disposição dos pinos não for suportada; quem chama faz a varredura pelos GPIOs.
+ */
+bool hal_teclado_iniciar(const uint linhas[4], const uint colunas[4], hal_teclado_leitura_t callback);
+
+// ----- Tempo -----
+
+uint32_t hal_agora_ms(void);
+uint64_t hal_agora_us(void);
+
+// Espera ativa curta, usada para acomodação de sinais
+void hal_espera_us(uint32_t us);
+
+// Dorme até o instante absoluto informado
+void hal_dormir_ate_us(uint64_t instante_us);
+
+// Suspende o núcleo até a próxima interrupção (WFI)
+void hal_aguardar_interrupcao(void);
+
+// ----- Timers -----
+
+// Callback de timer periódico; retorna false para encerrar o timer
+typedef bool (*hal_timer_callback_t)(void *contexto);
+
+typedef struct {
+    hal_timer_callback_t callback;
+    void *contexto;
+#ifdef PIO_MATRIX_HOST
+    uint32_t periodo_ms;
+    uint64_t proximo_us;
+    bool ativo;
+#else
+    repeating_timer_t timer;
+#endif
+} hal_timer_t;
+
+/**
+ * @brief Inicia um timer periódico cujo callback roda em contexto de interrupção.
+ *
+ * @return false se não houver recursos para o timer.
+ */
+bool hal_timer_iniciar(hal_timer_t *timer, uint32_t periodo_ms, hal_timer_callback_t callback, void *contexto);
+
+// Troca o período de um timer em andamento; o próximo callback ocorre um novo período após a chamada
+void hal_timer_periodo(hal_timer_t *timer, uint32_t periodo_ms);
+
+// ----- Saída dos LEDs (programa pio_matrix + DMA) -----
+
+// Carrega o programa PIO da matriz no pino indicado e prepara o envio dos frames
+void hal_leds_iniciar(uint pino);
+
+// Variante paralela: 8 cadeias em pinos consecutivos a partir de pino_base (programa pio_matrix_paralelo);
+// os frames enviados devem vir de paralelo_transpor
+void hal_leds_iniciar_paralelo(uint pino_base);
+
+/**
+ * @brief Inicia o envio de um frame já codificado, sem bloquear.
+ *
+ * @return false se o frame anterior ainda estiver sendo transmitido.
+ */
+bool hal_leds_enviar(const uint32_t *frame, uint num_palavras);
+
+// Indica se um frame ainda está em transmissão
+bool hal_leds_ocupado(void);
+
+// ----- Microfone (ADC + DMA) -----
+
+// Função chamada, em contexto de interrupção, quando um bloco de amostras de 12 bits fica completo
+typedef void (*hal_adc_bloco_t)(const uint16_t *amostras, uint num_amostras);
+
+/**
+ * @brief Amostra continuamente um canal do ADC, alternando entre dois buffers.
+ *
+ * Enquanto o callback informa um buffer completo, o outro já está sendo preenchido: quem o usa
+ * tem o tempo de um bloco para processá-lo antes de ser sobrescrito. O pino do canal passa ao
+ * modo analógico e volta à função anterior em hal_adc_parar.
+ *
+ * @return false se o canal (0 a 2, GPIO 26 a 28) ou a taxa forem inválidos.
+ */
+bool hal_adc_iniciar(uint canal, uint32_t taxa_hz, uint16_t *buffer_a, uint16_t *buffer_b, uint num_amostras,
+                     hal_adc_bloco_t callback);
+
+// Interrompe a amostragem; nenhum callback ocorre após o retorno
+void hal_adc_parar(void);
+
+// ----- Serial (stdio: USB CDC ou UART) -----
+
+// Lê sem bloquear até "maximo" bytes já recebidos; retorna quantos foram lidos. Não deve ser
+// chamada em interrupção: a stdio do SDK trava um mutex que pode estar com o laço principal
+int hal_serial_ler(uint8_t *dados, uint32_t maximo);
+
+// ----- Núcleos -----
+
+#if PIO_MATRIX_DUAL_CORE
+// Executa a função no núcleo 1
+void hal_nucleo1_executar(void (*funcao)(void));
+#endif
+
+#endif
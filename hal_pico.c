@@ -0,0 +1,187 @@
+#include "hal.h"
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "hardware/uart.h"
+
+#if PIO_MATRIX_DUAL_CORE
+#include "pico/multicore.h"
+#endif
+
+// Arquivo .pio
+#include "pio_matrix.pio.h"
+
+// Transmissão dos frames via DMA
+#include "frame_dma.h"
+
+// Amostragem do microfone via DMA
+#include "adc_dma.h"
+
+// Varredura do teclado numa state machine da pio1
+#include "keypad_pio.h"
+
+static hal_gpio_irq_t gpio_irq_atual = NULL;
+
+// Máquina de estados dos LEDs, para refazer o divisor quando o clock do sistema muda
+static PIO leds_pio = NULL;
+static uint leds_sm;
+
+uint32_t hal_sistema_iniciar(uint32_t khz) {
+    bool ok = set_sys_clock_khz(khz, false);
+    stdio_init_all();
+    return ok ? clock_get_hz(clk_sys) : 0;
+}
+
+bool hal_sistema_ajustar_clock(uint32_t khz) {
+    // Sem interrupções, nenhum frame começa entre a verificação e a troca
+    uint32_t estado = save_and_disable_interrupts();
+    if (frame_dma_ocupado()) {
+        restore_interrupts(estado);
+        return false;
+    }
+
+    bool ok = set_sys_clock_khz(khz, false);
+    if (ok) {
+        // clk_peri acompanha clk_sys: a PIO e a UART voltam às suas frequências
+        if (leds_pio) pio_sm_set_clkdiv(leds_pio, leds_sm, clock_get_hz(clk_sys) / (float)LED_FREQ_PIO_HZ);
+        keypad_pio_ajustar_clock();
+#if LIB_PICO_STDIO_UART && defined(uart_default)
+        uart_set_baudrate(uart_default, PICO_DEFAULT_UART_BAUD_RATE);
+#endif
+    }
+    restore_interrupts(estado);
+    return ok;
+}
+
+void hal_gpio_saida(uint pino) {
+    gpio_init(pino);
+    gpio_set_dir(pino, GPIO_OUT);
+}
+
+void hal_gpio_entrada_pullup(uint pino) {
+    gpio_init(pino);
+    gpio_set_dir(pino, GPIO_IN);
+    gpio_pull_up(pino);
+}
+
+void hal_gpio_escrever(uint pino, bool valor) {
+    gpio_put(pino, valor);
+}
+
+bool hal_gpio_ler(uint pino) {
+    return gpio_get(pino);
+}
+
+static void gpio_irq_handler(uint pino, uint32_t eventos) {
+    if (gpio_irq_atual) gpio_irq_atual(pino);
+}
+
+void hal_gpio_irq_callback(hal_gpio_irq_t callback) {
+    gpio_irq_atual = callback;
+}
+
+void hal_gpio_irq_descida(uint pino, bool habilitar) {
+    // O SDK mantém um único callback por núcleo; registrá-lo a cada chamada é inofensivo
+    gpio_set_irq_enabled_with_callback(pino, GPIO_IRQ_EDGE_FALL, habilitar, gpio_irq_handler);
+}
+
+bool hal_teclado_iniciar(const uint linhas[4], const uint colunas[4], hal_teclado_leitura_t callback) {
+    return keypad_pio_iniciar(linhas, colunas, callback);
+}
+
+uint32_t hal_agora_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+uint64_t hal_agora_us(void) {
+    return time_us_64();
+}
+
+void hal_espera_us(uint32_t us) {
+    busy_wait_us_32(us);
+}
+
+void hal_dormir_ate_us(uint64_t instante_us) {
+    sleep_until(from_us_since_boot(instante_us));
+}
+
+void hal_aguardar_interrupcao(void) {
+    __wfi();
+}
+
+static bool timer_handler(repeating_timer_t *t) {
+    hal_timer_t *timer = (hal_timer_t *)t->user_data;
+    return timer->callback(timer->contexto);
+}
+
+bool hal_timer_iniciar(hal_timer_t *timer, uint32_t periodo_ms, hal_timer_callback_t callback, void *contexto) {
+    timer->callback = callback;
+    timer->contexto = contexto;
+    // Período negativo: intervalo contado entre inícios de callback, sem acumular atraso
+    return add_repeating_timer_ms(-(int32_t)periodo_ms, timer_handler, timer, &timer->timer);
+}
+
+void hal_timer_periodo(hal_timer_t *timer, uint32_t periodo_ms) {
+    // Reagendado do zero: alterar delay_us só valeria depois do vencimento já marcado
+    cancel_repeating_timer(&timer->timer);
+    add_repeating_timer_ms(-(int32_t)periodo_ms, timer_handler, timer, &timer->timer);
+}
+
+void hal_leds_iniciar(uint pino) {
+    PIO pio = pio0;
+
+    //configurações da PIO
+    uint offset = pio_add_program(pio, &pio_matrix_program);
+    uint sm = pio_claim_unused_sm(pio, true);
+    pio_matrix_program_init(pio, sm, offset, pino);
+    frame_dma_init(pio, sm);
+    leds_pio = pio;
+    leds_sm = sm;
+}
+
+void hal_leds_iniciar_paralelo(uint pino_base) {
+    PIO pio = pio0;
+
+    uint offset = pio_add_program(pio, &pio_matrix_paralelo_program);
+    uint sm = pio_claim_unused_sm(pio, true);
+    pio_matrix_paralelo_program_init(pio, sm, offset, pino_base);
+    frame_dma_init(pio, sm);
+    leds_pio = pio;
+    leds_sm = sm;
+}
+
+bool hal_leds_enviar(const uint32_t *frame, uint num_palavras) {
+    return frame_dma_enviar(frame, num_palavras, NULL, NULL);
+}
+
+bool hal_leds_ocupado(void) {
+    return frame_dma_ocupado();
+}
+
+bool hal_adc_iniciar(uint canal, uint32_t taxa_hz, uint16_t *buffer_a, uint16_t *buffer_b, uint num_amostras,
+                     hal_adc_bloco_t callback) {
+    return adc_dma_iniciar(canal, taxa_hz, buffer_a, buffer_b, num_amostras, callback);
+}
+
+void hal_adc_parar(void) {
+    adc_dma_parar();
+}
+
+int hal_serial_ler(uint8_t *dados, uint32_t maximo) {
+    uint32_t n = 0;
+
+    while (n < maximo) {
+        int c = getchar_timeout_us(0);
+        if (c == PICO_ERROR_TIMEOUT) break;
+        dados[n++] = (uint8_t)c;
+    }
+    return (int)n;
+}
+
+#if PIO_MATRIX_DUAL_CORE
+void hal_nucleo1_executar(void (*funcao)(void)) {
+    multicore_launch_core1(funcao);
+}
+#endif
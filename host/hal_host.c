@@ -0,0 +1,360 @@
+#include "hal_host.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "trace.h"
+
+#define NUM_PINOS 30
+#define MAX_TIMERS 8
+
+// ----- Estado simulado -----
+
+static uint64_t agora_us = 0;
+
+static bool pino_saida[NUM_PINOS];
+static bool pino_nivel[NUM_PINOS];     // Valor escrito nas saídas
+static bool pino_pullup[NUM_PINOS];
+static bool pino_irq[NUM_PINOS];
+static bool pino_lido[NUM_PINOS];      // Último nível observado nas entradas, para detectar bordas
+static bool conexao[NUM_PINOS][NUM_PINOS];
+static hal_gpio_irq_t gpio_irq_atual = NULL;
+
+// Varredura do teclado pela PIO: pinos, callback e a última leitura entregue
+static uint teclado_linhas[4], teclado_colunas[4];
+static hal_teclado_leitura_t teclado_callback = NULL;
+static uint16_t teclado_leitura = 0;
+
+static hal_timer_t *timers[MAX_TIMERS];
+static uint64_t espera_limite_us = 0;   // hal_aguardar_interrupcao não avança além deste instante
+static uint num_timers = 0;
+
+// Microfone: buffers em pingue-pongue, amostras já convertidas e o tom simulado
+static bool adc_ativo = false;
+static uint32_t adc_taxa_hz;
+static uint16_t *adc_buffers[2];
+static uint adc_num_amostras;
+static uint adc_buffer_atual;
+static hal_adc_bloco_t adc_callback;
+static uint64_t adc_inicio_us, adc_amostras;
+static uint32_t microfone_freq_hz = 0;
+static uint16_t microfone_amplitude = 0;
+
+static uint8_t serial_buffer[HAL_HOST_SERIAL_BYTES];
+static uint32_t serial_inicio = 0, serial_fim = 0;
+
+static uint32_t frame_gravado[HAL_HOST_MAX_PALAVRAS];
+static uint palavras_gravadas = 0;
+static uint32_t frames_enviados = 0;
+static uint32_t palavras_enviadas = 0;
+static uint64_t leds_livre_us = 0;
+static uint64_t fifo_vazia_us = 0;     // Quando a última palavra do frame entra na FIFO (fim do DMA)
+static bool transmitindo = false;
+
+// ----- Sistema -----
+
+uint32_t hal_sistema_iniciar(uint32_t khz) {
+    return khz * 1000u;
+}
+
+// Como no dispositivo, a troca é recusada com um frame em transmissão
+bool hal_sistema_ajustar_clock(uint32_t khz) {
+    (void)khz;
+    return !hal_leds_ocupado();
+}
+
+// ----- GPIO -----
+
+// Nível de uma entrada: LOW se alguma saída em LOW estiver conectada a ela, senão o pull-up
+static bool nivel_entrada(uint pino) {
+    for (uint outro = 0; outro < NUM_PINOS; outro++) {
+        if (conexao[pino][outro] && pino_saida[outro] && !pino_nivel[outro]) return false;
+    }
+    return pino_pullup[pino];
+}
+
+// Reavalia as entradas após qualquer mudança e dispara a interrupção nas bordas de descida
+static void propagar(void) {
+    for (uint pino = 0; pino < NUM_PINOS; pino++) {
+        if (pino_saida[pino]) continue;
+        bool nivel = nivel_entrada(pino);
+        bool borda = pino_lido[pino] && !nivel;
+        pino_lido[pino] = nivel;
+        if (borda && pino_irq[pino] && gpio_irq_atual) gpio_irq_atual(pino);
+    }
+}
+
+void hal_gpio_saida(uint pino) {
+    pino_saida[pino] = true;
+    pino_nivel[pino] = false;
+    propagar();
+}
+
+void hal_gpio_entrada_pullup(uint pino) {
+    pino_saida[pino] = false;
+    pino_pullup[pino] = true;
+    pino_lido[pino] = nivel_entrada(pino);
+}
+
+void hal_gpio_escrever(uint pino, bool valor) {
+    pino_nivel[pino] = valor;
+    propagar();
+}
+
+bool hal_gpio_ler(uint pino) {
+    return pino_saida[pino] ? pino_nivel[pino] : nivel_entrada(pino);
+}
+
+void hal_gpio_irq_callback(hal_gpio_irq_t callback) {
+    gpio_irq_atual = callback;
+}
+
+void hal_gpio_irq_descida(uint pino, bool habilitar) {
+    pino_irq[pino] = habilitar;
+}
+
+// Como a state machine, que varre sem parar: cada mudança nas conexões vira uma leitura nova
+static void varrer_teclado(void) {
+    uint16_t bruto = 0;
+
+    if (!teclado_callback) return;
+    for (uint r = 0; r < 4; r++) {
+        for (uint c = 0; c < 4; c++) {
+            if (conexao[teclado_linhas[r]][teclado_colunas[c]]) bruto |= (uint16_t)(1u << (r * 4 + c));
+        }
+    }
+    if (bruto == teclado_leitura) return;
+    teclado_leitura = bruto;
+    teclado_callback(bruto);
+}
+
+bool hal_teclado_iniciar(const uint linhas[4], const uint colunas[4], hal_teclado_leitura_t callback) {
+    for (int i = 0; i < 4; i++) {
+        teclado_linhas[i] = linhas[i];
+        teclado_colunas[i] = colunas[i];
+        hal_gpio_entrada_pullup(colunas[i]);
+    }
+    teclado_leitura = 0;
+    teclado_callback = callback;
+    return true;
+}
+
+void hal_host_conectar(uint pino_a, uint pino_b, bool fechado) {
+    conexao[pino_a][pino_b] = fechado;
+    conexao[pino_b][pino_a] = fechado;
+    propagar();
+    varrer_teclado();
+}
+
+// ----- Tempo -----
+
+uint32_t hal_agora_ms(void) {
+    return (uint32_t)(agora_us / 1000u);
+}
+
+uint64_t hal_agora_us(void) {
+    return agora_us;
+}
+
+void hal_espera_us(uint32_t us) {
+    agora_us += us;
+}
+
+void hal_dormir_ate_us(uint64_t instante_us) {
+    if (instante_us > agora_us) agora_us = instante_us;
+}
+
+// ----- Timers -----
+
+bool hal_timer_iniciar(hal_timer_t *timer, uint32_t periodo_ms, hal_timer_callback_t callback, void *contexto) {
+    uint i;
+
+    for (i = 0; i < num_timers && timers[i] != timer; i++);
+    if (i == num_timers) {
+        if (num_timers == MAX_TIMERS) return false;
+        timers[num_timers++] = timer;
+    }
+
+    timer->callback = callback;
+    timer->contexto = contexto;
+    timer->periodo_ms = periodo_ms;
+    timer->proximo_us = agora_us + (uint64_t)periodo_ms * 1000u;
+    timer->ativo = true;
+    return true;
+}
+
+// Equivalente à interrupção de fim do DMA: registrada no instante simulado em que ocorreria
+static void concluir_transmissao(uint64_t ate_us) {
+    if (transmitindo && fifo_vazia_us <= ate_us) {
+        transmitindo = false;
+        TRACE_EM(fifo_vazia_us, TRACE_FIFO_VAZIA, 0);
+    }
+}
+
+// Timer ativo com o vencimento mais próximo, ou NULL
+static hal_timer_t *proximo_timer(void) {
+    hal_timer_t *proximo = NULL;
+
+    for (uint i = 0; i < num_timers; i++) {
+        if (timers[i]->ativo && (!proximo || timers[i]->proximo_us < proximo->proximo_us)) {
+            proximo = timers[i];
+        }
+    }
+    return proximo;
+}
+
+// Executa um timer vencido, como sua interrupção
+static void disparar(hal_timer_t *timer) {
+    concluir_transmissao(timer->proximo_us);
+    if (timer->proximo_us > agora_us) agora_us = timer->proximo_us;
+    // Como no SDK com período negativo, o próximo vencimento conta a partir do início do callback
+    timer->proximo_us += (uint64_t)timer->periodo_ms * 1000u;
+    if (!timer->callback(timer->contexto)) timer->ativo = false;
+}
+
+// Instante em que o bloco do ADC em andamento fica completo
+static uint64_t adc_fim_bloco_us(void) {
+    return adc_inicio_us + (adc_amostras + adc_num_amostras) * 1000000u / adc_taxa_hz;
+}
+
+// Equivalente à interrupção do DMA do ADC: preenche e entrega os blocos completos até o instante informado
+static void concluir_blocos_adc(uint64_t ate_us) {
+    while (adc_ativo && adc_fim_bloco_us() <= ate_us) {
+        uint16_t *buffer = adc_buffers[adc_buffer_atual];
+        for (uint i = 0; i < adc_num_amostras; i++) {
+            double t = (double)(adc_amostras + i) / adc_taxa_hz;
+            buffer[i] = (uint16_t)lround(2048.0 + microfone_amplitude * sin(2.0 * M_PI * microfone_freq_hz * t));
+        }
+        adc_amostras += adc_num_amostras;
+        adc_buffer_atual ^= 1;
+        adc_callback(buffer, adc_num_amostras);
+    }
+}
+
+void hal_host_limitar_espera(uint64_t instante_us) {
+    espera_limite_us = instante_us;
+}
+
+void hal_timer_periodo(hal_timer_t *timer, uint32_t periodo_ms) {
+    timer->periodo_ms = periodo_ms;
+    timer->proximo_us = agora_us + (uint64_t)periodo_ms * 1000u;
+}
+
+void hal_aguardar_interrupcao(void) {
+    hal_timer_t *timer = proximo_timer();
+    uint64_t despertar_us = espera_limite_us;
+
+    // Interrupções possíveis: fim do DMA (LEDs e ADC) e vencimento de timer (as teclas chegam entre as esperas)
+    if (transmitindo && fifo_vazia_us < despertar_us) despertar_us = fifo_vazia_us;
+    if (timer && timer->proximo_us < despertar_us) despertar_us = timer->proximo_us;
+    if (adc_ativo && adc_fim_bloco_us() < despertar_us) despertar_us = adc_fim_bloco_us();
+    if (despertar_us > agora_us) agora_us = despertar_us;
+
+    // Interrupções pendentes no mesmo instante são todas atendidas antes de o laço voltar
+    concluir_transmissao(agora_us);
+    concluir_blocos_adc(agora_us);
+    while ((timer = proximo_timer()) != NULL && timer->proximo_us <= agora_us) disparar(timer);
+}
+
+// ----- Saída dos LEDs -----
+
+void hal_leds_iniciar(uint pino) {
+    (void)pino;
+    palavras_gravadas = 0;
+    leds_livre_us = agora_us;
+}
+
+// O gravador guarda as palavras como chegariam à FIFO, seja qual for o programa
+void hal_leds_iniciar_paralelo(uint pino_base) {
+    hal_leds_iniciar(pino_base);
+}
+
+bool hal_leds_enviar(const uint32_t *frame, uint num_palavras) {
+    if (hal_leds_ocupado()) return false;
+    if (num_palavras > HAL_HOST_MAX_PALAVRAS) num_palavras = HAL_HOST_MAX_PALAVRAS;
+
+    memcpy(frame_gravado, frame, num_palavras * sizeof(uint32_t));
+    palavras_gravadas = num_palavras;
+    frames_enviados++;
+    palavras_enviadas += num_palavras;
+    fifo_vazia_us = agora_us + (uint64_t)num_palavras * HAL_HOST_US_POR_PALAVRA;
+    leds_livre_us = fifo_vazia_us + HAL_HOST_LATCH_US;
+    transmitindo = true;
+    return true;
+}
+
+bool hal_leds_ocupado(void) {
+    return agora_us < leds_livre_us;
+}
+
+const uint32_t *hal_host_ultimo_frame(uint *num_palavras) {
+    if (num_palavras) *num_palavras = palavras_gravadas;
+    return frames_enviados ? frame_gravado : NULL;
+}
+
+uint32_t hal_host_frames_enviados(void) {
+    return frames_enviados;
+}
+
+uint32_t hal_host_palavras_enviadas(void) {
+    return palavras_enviadas;
+}
+
+// ----- Microfone -----
+
+bool hal_adc_iniciar(uint canal, uint32_t taxa_hz, uint16_t *buffer_a, uint16_t *buffer_b, uint num_amostras,
+                     hal_adc_bloco_t callback) {
+    if (canal > 2 || taxa_hz == 0 || num_amostras == 0) return false;
+
+    adc_taxa_hz = taxa_hz;
+    adc_buffers[0] = buffer_a;
+    adc_buffers[1] = buffer_b;
+    adc_num_amostras = num_amostras;
+    adc_buffer_atual = 0;
+    adc_callback = callback;
+    adc_inicio_us = agora_us;
+    adc_amostras = 0;
+    adc_ativo = true;
+    return true;
+}
+
+void hal_adc_parar(void) {
+    adc_ativo = false;
+}
+
+void hal_host_microfone(uint32_t freq_hz, uint16_t amplitude) {
+    microfone_freq_hz = freq_hz;
+    microfone_amplitude = amplitude > 2047 ? 2047 : amplitude;
+}
+
+// ----- Serial -----
+
+uint32_t hal_host_serial_injetar(const uint8_t *dados, uint32_t tamanho) {
+    // Compacta o que já foi lido antes de acrescentar
+    if (serial_inicio > 0) {
+        memmove(serial_buffer, serial_buffer + serial_inicio, serial_fim - serial_inicio);
+        serial_fim -= serial_inicio;
+        serial_inicio = 0;
+    }
+    if (tamanho > HAL_HOST_SERIAL_BYTES - serial_fim) tamanho = HAL_HOST_SERIAL_BYTES - serial_fim;
+    memcpy(serial_buffer + serial_fim, dados, tamanho);
+    serial_fim += tamanho;
+    return tamanho;
+}
+
+int hal_serial_ler(uint8_t *dados, uint32_t maximo) {
+    uint32_t n = serial_fim - serial_inicio;
+
+    if (n > maximo) n = maximo;
+    memcpy(dados, serial_buffer + serial_inicio, n);
+    serial_inicio += n;
+    return (int)n;
+}
+
+#if PIO_MATRIX_DUAL_CORE
+// Sem um segundo núcleo no host; o modo de dois núcleos não é suportado nesta compilação
+void hal_nucleo1_executar(void (*funcao)(void)) {
+    (void)funcao;
+}
+#endif
@@ -0,0 +1,62 @@
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+/**
+ * @brief Controles e observação do backend simulado (apenas no host).
+ *
+ * O tempo só avança por hal_aguardar_interrupcao (o WFI do laço principal), que dispara os
+ * timers na ordem em que vencem; as teclas são simuladas conectando pinos, e os frames enviados
+ * à matriz ficam gravados para inspeção.
+ */
+
+#include "hal.h"
+#include "led_protocolo.h"
+
+// Tempo de transmissão de uma palavra (30 µs no WS2812: 24 bits a 800 kHz) e pausa de latch ao fim do frame
+#define HAL_HOST_US_POR_PALAVRA LED_US_POR_PIXEL
+#define HAL_HOST_LATCH_US (9u * LED_US_POR_PIXEL + LED_RESET_US)
+
+// Maior frame que o gravador guarda
+#define HAL_HOST_MAX_PALAVRAS 256
+
+/**
+ * @brief Instante máximo até o qual hal_aguardar_interrupcao pode dormir.
+ *
+ * A espera avança o relógio até a próxima interrupção simulada (timer ou fim do DMA) ou até este
+ * limite, quando quem conduz a simulação volta a ter o controle para injetar teclas e bytes.
+ */
+void hal_host_limitar_espera(uint64_t instante_us);
+
+/**
+ * @brief Liga ou desliga dois pinos, como uma tecla fechando o contato entre linha e coluna.
+ *
+ * Uma entrada com pull-up lê LOW enquanto estiver conectada a uma saída em LOW; bordas de
+ * descida resultantes disparam a interrupção de GPIO, se habilitada. Com a varredura pela PIO
+ * (hal_teclado_iniciar), a leitura do teclado é refeita na hora e entregue se tiver mudado.
+ */
+void hal_host_conectar(uint pino_a, uint pino_b, bool fechado);
+
+// Tamanho da área que guarda os bytes injetados na serial simulada
+#define HAL_HOST_SERIAL_BYTES 65536
+
+// Acrescenta bytes à serial simulada, como se chegassem do PC; retorna quantos couberam
+uint32_t hal_host_serial_injetar(const uint8_t *dados, uint32_t tamanho);
+
+/**
+ * @brief Define o som captado pelo microfone simulado: um tom puro em torno da meia escala do ADC.
+ *
+ * Enquanto hal_adc_iniciar estiver ativo, cada bloco completa no instante simulado em que a
+ * última amostra seria convertida, como a interrupção do DMA. Frequência ou amplitude 0 é silêncio.
+ *
+ * @param amplitude Pico do tom em unidades do ADC de 12 bits (até 2047).
+ */
+void hal_host_microfone(uint32_t freq_hz, uint16_t amplitude);
+
+// Último frame entregue a hal_leds_enviar (NULL se nenhum) e seu tamanho em palavras
+const uint32_t *hal_host_ultimo_frame(uint *num_palavras);
+
+// Frames e palavras entregues desde o início
+uint32_t hal_host_frames_enviados(void);
+uint32_t hal_host_palavras_enviadas(void);
+
+#endif
@@ -0,0 +1,275 @@
+/**
+ * @brief Executável de simulação no Linux: mesma lógica do firmware sobre o backend hal_host.
+ *
+ * Lê da entrada padrão uma sequência de comandos separados por espaço ou linha:
+ *   <tecla>   pressiona e solta uma tecla do keypad (1-9, 0, A-D, *, #)
+ *   h<tecla>  segura uma tecla por TECLA_SEGURADA_MS (ex.: h1 troca a animação do '1' pelo plasma)
+ *   c<t1><t2> acorde: pressiona t1, pressiona t2 com t1 ainda fechada e solta as duas (ex.: c*5 ajusta o brilho)
+ *   w<ms>     avança o relógio simulado em <ms> milissegundos (ex.: w2000)
+ *   m<hz>     toca um tom de <hz> no microfone simulado (m0 silencia), para o visualizador da tecla '*'
+ *   f         imprime o frame atual
+ *   e         imprime os contadores do framebuffer, da recepção pela serial e do modo ocioso
+ *   x         imprime as palavras do frame atual, como entram na FIFO da PIO (entrada de tools/pio_emu)
+ *   t         imprime o registro de eventos (entrada de tools/trace_dec)
+ *   q         encerra
+ * Cada frame novo enviado à matriz é impresso como uma grade 5x5, com a letra do canal dominante.
+ *
+ * Opções:
+ *   --pty          cria um pseudo-terminal ligado à serial simulada e imprime seu caminho; o tempo
+ *                  simulado passa a acompanhar o real, para receber frames de tools/stream_tx
+ *   --silencioso   não imprime cada frame novo
+ */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "energia.h"
+#include "framebuffer.h"
+#include "hal_host.h"
+#include "keypad.h"
+#include "layout.h"
+#include "pio_matrix.h"
+#include "stream.h"
+#include "trace.h"
+
+// Amplitude do tom do microfone simulado, em unidades do ADC de 12 bits
+#define MICROFONE_AMPLITUDE 1000
+
+// Tempo que a tecla simulada permanece pressionada e o intervalo até o próximo comando
+#define TECLA_PRESSIONADA_MS 60
+#define TECLA_INTERVALO_MS 60
+
+// Tempo da tecla segurada (comando h), além do limiar de DEBOUNCE_SEGURAR_MS
+#define TECLA_SEGURADA_MS 1000
+
+static const char teclas[4][4] = {
+    {'1', '2', '3', 'A'},
+    {'4', '5', '6', 'B'},
+    {'7', '8', '9', 'C'},
+    {'*', '0', '#', 'D'}
+};
+
+static const uint linhas[4] = {ROW1, ROW2, ROW3, ROW4};
+static const uint colunas[4] = {COL1, COL2, COL3, COL4};
+
+static uint32_t frames_impressos = 0;
+static bool silencioso = false;
+
+// Lado mestre do pseudo-terminal (--pty), ou -1
+static int pty_mestre = -1;
+
+// Caractere de um pixel: '.' apagado, senão o canal mais intenso (ou W se os três empatarem)
+static char caractere_pixel(uint32_t palavra) {
+    uint8_t g = LED_CANAL(palavra, LED_DESLOC_G), r = LED_CANAL(palavra, LED_DESLOC_R), b = LED_CANAL(palavra, LED_DESLOC_B);
+
+    if ((r | g | b) == 0) return '.';
+    if (r == g && g == b) return 'W';
+    if (r >= g && r >= b) return 'R';
+    if (g >= b) return 'G';
+    return 'B';
+}
+
+static void imprimir_frame(void) {
+    uint num_palavras;
+    const uint32_t *frame = hal_host_ultimo_frame(&num_palavras);
+
+    if (!frame || num_palavras < layout_matriz.num_pixels) {
+        printf("[%6lu ms] (nenhum frame)\n", (unsigned long)hal_agora_ms());
+        return;
+    }
+    printf("[%6lu ms] frame %lu\n", (unsigned long)hal_agora_ms(), (unsigned long)hal_host_frames_enviados());
+    // Grade na orientação lógica, lida pela mesma tabela que o firmware usa para gravar os frames
+    for (uint y = 0; y < layout_matriz.altura; y++) {
+        printf("  ");
+        for (uint x = 0; x < layout_matriz.largura; x++) {
+            putchar(caractere_pixel(frame[layout_fisico(&layout_matriz, x, y)]));
+        }
+        putchar('\n');
+    }
+}
+
+static void imprimir_palavras(void) {
+    uint num_palavras;
+    const uint32_t *frame = hal_host_ultimo_frame(&num_palavras);
+
+    printf("fifo:");
+    for (uint i = 0; frame && i < num_palavras; i++) printf(" 0x%08lx", (unsigned long)frame[i]);
+    printf("\n");
+}
+
+static bool abrir_pty(void) {
+    struct termios modo;
+
+    pty_mestre = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty_mestre < 0 || grantpt(pty_mestre) != 0 || unlockpt(pty_mestre) != 0) return false;
+
+    // Modo bruto: os bytes do protocolo passam sem eco nem tradução de fim de linha
+    if (tcgetattr(pty_mestre, &modo) == 0) {
+        cfmakeraw(&modo);
+        tcsetattr(pty_mestre, TCSANOW, &modo);
+    }
+    fcntl(pty_mestre, F_SETFL, fcntl(pty_mestre, F_GETFL) | O_NONBLOCK);
+    printf("serial: %s\n", ptsname(pty_mestre));
+    return true;
+}
+
+// Repassa à serial simulada o que chegou pelo pseudo-terminal
+static void ler_pty(void) {
+    uint8_t bloco[4096];
+    ssize_t n;
+
+    while ((n = read(pty_mestre, bloco, sizeof(bloco))) > 0) {
+        hal_host_serial_injetar(bloco, (uint32_t)n);
+    }
+}
+
+// Avança o relógio de 1 em 1 ms, tratando os eventos como o laço principal do firmware
+// Imprime o frame mais recente, se a matriz recebeu algum desde a última impressão
+static void imprimir_frame_novo(void) {
+    if (hal_host_frames_enviados() != frames_impressos) {
+        frames_impressos = hal_host_frames_enviados();
+        if (!silencioso) imprimir_frame();
+    }
+}
+
+static void avancar(uint32_t ms) {
+    struct timespec proximo;
+    clock_gettime(CLOCK_MONOTONIC, &proximo);
+
+    // Sem o pseudo-terminal nada chega durante a espera: o firmware dorme de interrupção em interrupção até o fim
+    uint32_t passo_ms = pty_mestre >= 0 ? 1 : ms;
+
+    while (ms) {
+        if (pty_mestre >= 0) {
+            // Com o pseudo-terminal, 1 ms simulado corresponde a 1 ms real
+            proximo.tv_nsec += 1000000;
+            if (proximo.tv_nsec >= 1000000000) { proximo.tv_nsec -= 1000000000; proximo.tv_sec++; }
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &proximo, NULL);
+            ler_pty();
+        }
+        // Como no laço do firmware: trata os eventos e dorme até a próxima interrupção simulada
+        uint64_t fim_us = hal_agora_us() + (uint64_t)passo_ms * 1000u;
+        hal_host_limitar_espera(fim_us);
+        do {
+            pio_matrix_processar_eventos();
+            imprimir_frame_novo();
+            if (!stream_pendente()) energia_ociosa();
+        } while (hal_agora_us() < fim_us);
+        imprimir_frame_novo();
+        ms -= passo_ms;
+    }
+}
+
+static void imprimir_estatisticas(void) {
+    fb_estatisticas_t e;
+    stream_estatisticas_t s;
+    energia_estatisticas_t en;
+
+    fb_obter_estatisticas(&e);
+    printf("framebuffer: %lu apresentados, %lu ignorados, %lu bytes enviados\n",
+           (unsigned long)e.apresentados, (unsigned long)e.ignorados, (unsigned long)e.bytes_enviados);
+
+    stream_obter_estatisticas(&s);
+    printf("serial: %lu bytes recebidos, %lu descartados; %lu pacotes, %lu frames recebidos, %lu exibidos, "
+           "%lu substituídos; erros: %lu CRC, %lu formato, %lu perdidos, %lu bytes ignorados\n",
+           (unsigned long)s.bytes_recebidos, (unsigned long)s.bytes_descartados, (unsigned long)s.protocolo.pacotes,
+           (unsigned long)s.protocolo.frames, (unsigned long)s.frames_exibidos, (unsigned long)s.frames_substituidos,
+           (unsigned long)s.protocolo.erros_crc, (unsigned long)s.protocolo.erros_formato,
+           (unsigned long)s.protocolo.perdidos, (unsigned long)s.protocolo.bytes_ignorados);
+
+    // O tempo simulado só avança nas esperas (WFI incluído): o código não consome tempo, então a
+    // divisão dormindo/acordado não diz nada aqui e só os despertares e a economia são comparáveis
+    energia_obter_estatisticas(&en);
+    printf("energia: %lu despertares (dormindo/acordado sem significado na simulação); "
+           "economia: %lu entradas, %llu ms, clock atual %lu kHz\n",
+           (unsigned long)en.despertares, (unsigned long)en.entradas_economia,
+           (unsigned long long)(en.economia_us / 1000u), (unsigned long)en.clock_khz);
+}
+
+// Fecha ou abre o contato de uma tecla; retorna false se ela não existir
+static bool conectar_tecla(char tecla, bool fechada) {
+    for (uint l = 0; l < 4; l++) {
+        for (uint c = 0; c < 4; c++) {
+            if (teclas[l][c] != tecla) continue;
+            hal_host_conectar(linhas[l], colunas[c], fechada);
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool tocar_tecla(char tecla, uint32_t pressionada_ms) {
+    if (!conectar_tecla(tecla, true)) return false;
+    avancar(pressionada_ms);
+    conectar_tecla(tecla, false);
+    avancar(TECLA_INTERVALO_MS);
+    return true;
+}
+
+static bool tocar_acorde(char primeira, char segunda) {
+    if (primeira == segunda || !conectar_tecla(primeira, true)) return false;
+    avancar(TECLA_PRESSIONADA_MS);
+    if (!conectar_tecla(segunda, true)) {
+        conectar_tecla(primeira, false);
+        return false;
+    }
+    avancar(TECLA_PRESSIONADA_MS);
+    conectar_tecla(segunda, false);
+    conectar_tecla(primeira, false);
+    avancar(TECLA_INTERVALO_MS);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    char comando[32];
+
+    // Saída sem buffer para intercalar corretamente com os printf do firmware
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--silencioso") == 0) {
+            silencioso = true;
+        } else if (strcmp(argv[i], "--pty") == 0) {
+            if (!abrir_pty()) {
+                perror("pseudo-terminal");
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "uso: %s [--pty] [--silencioso] < comandos\n", argv[0]);
+            return 1;
+        }
+    }
+
+    pio_matrix_iniciar();
+
+    while (scanf("%31s", comando) == 1) {
+        if (strcmp(comando, "q") == 0) break;
+        if (strcmp(comando, "f") == 0) {
+            imprimir_frame();
+        } else if (strcmp(comando, "e") == 0) {
+            imprimir_estatisticas();
+        } else if (strcmp(comando, "x") == 0) {
+            imprimir_palavras();
+        } else if (strcmp(comando, "t") == 0) {
+            trace_despejar();
+        } else if (comando[0] == 'w' && comando[1] != '\0') {
+            avancar((uint32_t)strtoul(comando + 1, NULL, 10));
+        } else if (comando[0] == 'm' && comando[1] != '\0') {
+            hal_host_microfone((uint32_t)strtoul(comando + 1, NULL, 10), MICROFONE_AMPLITUDE);
+        } else if (comando[0] == 'c' && comando[1] != '\0' && comando[2] != '\0' && comando[3] == '\0') {
+            if (!tocar_acorde(comando[1], comando[2])) printf("Comando desconhecido: %s\n", comando);
+        } else if (comando[0] == 'h' && comando[1] != '\0' && comando[2] == '\0') {
+            if (!tocar_tecla(comando[1], TECLA_SEGURADA_MS)) printf("Comando desconhecido: %s\n", comando);
+        } else if (comando[1] != '\0' || !tocar_tecla(comando[0], TECLA_PRESSIONADA_MS)) {
+            printf("Comando desconhecido: %s\n", comando);
+        }
+    }
+    return 0;
+}
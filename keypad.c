@@ -0,0 +1,175 @@
+#include "keypad.h"
+
+#include <stddef.h>
+#include "hal.h"
+#include "trace.h"
+
+/**
+ * @brief Mapeamento das teclas do Keypad
+ * 
+ * A matriz de teclas representa a organização do teclado matricial 4x4;
+ * a tecla (linha, coluna) corresponde ao bit linha * 4 + coluna da leitura bruta.
+ */
+static const char keys[DEBOUNCE_NUM_TECLAS] = {
+    '1', '2', '3', 'A',
+    '4', '5', '6', 'B',
+    '7', '8', '9', 'C',
+    '*', '0', '#', 'D'
+};
+
+static const uint linhas[4] = {ROW1, ROW2, ROW3, ROW4};
+static const uint colunas[4] = {COL1, COL2, COL3, COL4};
+
+static hal_timer_t timer_varredura;
+static volatile bool varrendo = false;
+
+// Varredura pela PIO: a leitura mais recente entregue pela interrupção
+static bool varredura_pio = false;
+static volatile uint16_t leitura_pio = 0;
+
+// Última leitura sem ambiguidade, usada no lugar das ambíguas
+static uint16_t leitura_valida = 0;
+
+static void habilitar_irq_colunas(bool habilitar) {
+    for (int c = 0; c < 4; c++) {
+        hal_gpio_irq_descida(colunas[c], habilitar);
+    }
+}
+
+// Todas as linhas em LOW: estado de repouso, em que qualquer tecla puxa sua coluna para baixo
+static void linhas_em_repouso(void) {
+    for (int r = 0; r < 4; r++) {
+        hal_gpio_escrever(linhas[r], 0);
+    }
+}
+
+static bool alguma_coluna_ativa(void) {
+    for (int c = 0; c < 4; c++) {
+        if (!hal_gpio_ler(colunas[c])) return true;
+    }
+    return false;
+}
+
+// Lê as 16 teclas de uma vez, ativando uma linha por vez
+static uint16_t ler_matriz(void) {
+    uint16_t bruto = 0;
+
+    for (int row = 0; row < 4; row++) {
+        // Definir a linha atual como LOW e as outras como HIGH
+        for (int r = 0; r < 4; r++) {
+            hal_gpio_escrever(linhas[r], r != row);
+        }
+        hal_espera_us(KEYPAD_ACOMODACAO_US);
+
+        for (int col = 0; col < 4; col++) {
+            if (!hal_gpio_ler(colunas[col])) bruto |= (uint16_t)(1u << (row * 4 + col));
+        }
+    }
+
+    linhas_em_repouso();
+    return bruto;
+}
+
+/**
+ * @brief Indica se a leitura pode conter teclas fantasmas.
+ *
+ * O teclado não tem diodos: com três cantos de um retângulo fechados, a linha ativa alcança a
+ * coluna do quarto canto pelas outras três teclas e ele também aparece fechado. Duas linhas com
+ * duas ou mais colunas em comum não permitem saber quais teclas são reais.
+ */
+static bool leitura_ambigua(uint16_t bruto) {
+    for (int a = 0; a < 3; a++) {
+        for (int b = a + 1; b < 4; b++) {
+            uint32_t comuns = (bruto >> (a * 4)) & (bruto >> (b * 4)) & 0xFu;
+            if (comuns & (comuns - 1)) return true;
+        }
+    }
+    return false;
+}
+
+static bool varredura_callback(void *contexto) {
+    uint16_t bruto = varredura_pio ? leitura_pio : ler_matriz();
+
+    (void)contexto;
+    if (!leitura_ambigua(bruto)) leitura_valida = bruto;
+    debounce_atualizar(leitura_valida, hal_agora_ms());
+    if (!debounce_ocioso()) return true;
+
+    if (varredura_pio) {
+        // A PIO só avisa nas mudanças: uma tecla que fechou desde a última leitura mantém o timer
+        varrendo = false;
+        if (!leitura_pio) return false;
+        varrendo = true;
+        return true;
+    }
+
+    // Volta a esperar por interrupção; uma tecla fechada durante a troca não gera borda, então é conferida aqui
+    habilitar_irq_colunas(true);
+    if (alguma_coluna_ativa()) {
+        habilitar_irq_colunas(false);
+        return true;
+    }
+    varrendo = false;
+    return false;
+}
+
+static void coluna_irq_callback(uint pino) {
+    if (varrendo) return;
+    TRACE(TRACE_TECLA_BORDA, pino);
+    varrendo = true;
+    habilitar_irq_colunas(false);
+    hal_timer_iniciar(&timer_varredura, KEYPAD_PERIODO_MS, varredura_callback, NULL);
+}
+
+// Leitura nova da PIO (interrupção): inicia a varredura por timer, que alimenta o debounce
+static void leitura_pio_callback(uint16_t bruto) {
+    leitura_pio = bruto;
+    if (varrendo) return;
+    TRACE(TRACE_TECLA_BORDA, bruto);
+    varrendo = true;
+    hal_timer_iniciar(&timer_varredura, KEYPAD_PERIODO_MS, varredura_callback, NULL);
+}
+
+void keypad_init(void) {
+    debounce_init(keys);
+    leitura_valida = 0;
+
+#if KEYPAD_VARREDURA_PIO
+    varredura_pio = hal_teclado_iniciar(linhas, colunas, leitura_pio_callback);
+    if (varredura_pio) return;
+#endif
+
+    // Configurando as linhas (ROW) como saídas
+    for (int r = 0; r < 4; r++) {
+        hal_gpio_saida(linhas[r]);
+    }
+    linhas_em_repouso();
+
+    // Configurando as colunas (COL) como entradas com pull-up, com interrupção na borda de descida
+    for (int c = 0; c < 4; c++) {
+        hal_gpio_entrada_pullup(colunas[c]);
+    }
+    hal_gpio_irq_callback(coluna_irq_callback);
+    habilitar_irq_colunas(true);
+}
+
+bool keypad_obter_evento(keypad_evento_t *evento) {
+    return debounce_obter_evento(evento);
+}
+
+bool keypad_acorde(const keypad_evento_t *evento, char tecla) {
+    for (int k = 0; k < DEBOUNCE_NUM_TECLAS; k++) {
+        if (keys[k] == tecla) return (evento->acorde >> k) & 1u;
+    }
+    return false;
+}
+
+bool keypad_teclas_do_pino(uint32_t pino, char teclas[5]) {
+    for (int i = 0; i < 4; i++) {
+        if (pino != linhas[i] && pino != colunas[i]) continue;
+        for (int j = 0; j < 4; j++) teclas[j] = pino == linhas[i] ? keys[i * 4 + j] : keys[j * 4 + i];
+        teclas[4] = '\0';
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,65 @@
+#ifndef KEYPAD_H
+#define KEYPAD_H
+
+#include <stdbool.h>
+#include "debounce.h"
+
+// Definição dos pinos do Keypad
+#define ROW1 28
+#define ROW2 27
+#define ROW3 26
+#define ROW4 22
+#define COL1 21
+#define COL2 20
+#define COL3 19
+#define COL4 18
+
+// Varredura pela PIO (1) ou pelos GPIOs, na CPU (0)
+#ifndef KEYPAD_VARREDURA_PIO
+#define KEYPAD_VARREDURA_PIO 1
+#endif
+
+// Período da varredura enquanto há teclas em transição ou pressionadas
+#define KEYPAD_PERIODO_MS 1
+
+// Tempo de acomodação das colunas após trocar a linha ativa
+#define KEYPAD_ACOMODACAO_US 5
+
+/**
+ * @brief Configura o teclado matricial e a detecção de teclas.
+ *
+ * Com KEYPAD_VARREDURA_PIO, uma state machine da PIO varre a matriz continuamente e só
+ * interrompe a CPU quando a leitura muda (hal_teclado_iniciar). Sem ela, ou se a disposição dos
+ * pinos não for suportada, as linhas ficam em LOW em repouso, de modo que qualquer tecla gera uma
+ * borda de descida em sua coluna, e a CPU varre as linhas uma a uma.
+ *
+ * Em ambos os casos a detecção inicia um timer que alimenta o debounce com a leitura das 16 teclas
+ * e é suspenso quando todas voltam a ficar soltas. Cada tecla é filtrada por conta própria, de
+ * modo que várias podem estar pressionadas ao mesmo tempo; leituras com teclas fantasmas (três
+ * cantos de um retângulo fechados) são descartadas.
+ */
+void keypad_init(void);
+
+/**
+ * @brief Retira o próximo evento (pressionada, solta, segurada ou repetição) da fila.
+ *
+ * @return false se não houver eventos pendentes.
+ */
+bool keypad_obter_evento(keypad_evento_t *evento);
+
+/**
+ * @brief Indica se a tecla estava pressionada no instante do evento.
+ *
+ * Um acorde como '*' + dígito chega como a pressão do dígito com '*' em evento->acorde.
+ */
+bool keypad_acorde(const keypad_evento_t *evento, char tecla);
+
+/**
+ * @brief Teclas da linha ou coluna ligada a um pino (ex.: um pino tomado pelo ADC do microfone).
+ *
+ * @param teclas Recebe as 4 teclas terminadas em '\0'.
+ * @return false se o pino não for do teclado.
+ */
+bool keypad_teclas_do_pino(uint32_t pino, char teclas[5]);
+
+#endif
@@ -0,0 +1,69 @@
+#include "keypad_pio.h"
+
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+
+#include "pio_matrix.pio.h"
+
+// A pio0 fica com os programas dos LEDs; o teclado usa a outra
+#define KEYPAD_PIO pio1
+#define KEYPAD_PIO_IRQ PIO1_IRQ_0
+
+static int sm = -1;
+static keypad_pio_callback_t callback_atual = NULL;
+
+static float divisor(void) {
+    return clock_get_hz(clk_sys) / (1000000.0f / KEYPAD_PIO_CICLO_US);
+}
+
+// Tratador da interrupção de FIFO RX não vazia
+static void keypad_pio_irq_handler(void) {
+    if (sm < 0 || pio_sm_is_rx_fifo_empty(KEYPAD_PIO, (uint)sm)) return;
+
+    // Leituras acumuladas já foram superadas pela mais recente
+    uint32_t leitura;
+    do {
+        leitura = pio_sm_get(KEYPAD_PIO, (uint)sm);
+    } while (!pio_sm_is_rx_fifo_empty(KEYPAD_PIO, (uint)sm));
+    if (callback_atual) callback_atual(keypad_pio_converter(leitura));
+}
+
+static bool disposicao_suportada(const uint linhas[4], const uint colunas[4]) {
+    for (int c = 0; c < 4; c++) {
+        if (colunas[c] != colunas[3] + 3u - (uint)c) return false;
+    }
+    if (linhas[1] != linhas[2] + 1u || linhas[0] != linhas[2] + 2u) return false;
+    return linhas[3] < linhas[2] || linhas[3] > linhas[0];
+}
+
+bool keypad_pio_iniciar(const uint linhas[4], const uint colunas[4], keypad_pio_callback_t callback) {
+    if (sm >= 0 || !disposicao_suportada(linhas, colunas)) return false;
+
+    // Colunas pelo GPIO, com pull-up; a state machine só as lê
+    for (int c = 0; c < 4; c++) {
+        gpio_init(colunas[c]);
+        gpio_set_dir(colunas[c], GPIO_IN);
+        gpio_pull_up(colunas[c]);
+    }
+    // Linhas em alta impedância fora do seu turno: o pull-up mantém o nível definido
+    for (int r = 0; r < 4; r++) {
+        gpio_pull_up(linhas[r]);
+    }
+
+    uint offset = pio_add_program(KEYPAD_PIO, &keypad_varredura_program);
+    sm = pio_claim_unused_sm(KEYPAD_PIO, true);
+    callback_atual = callback;
+
+    irq_add_shared_handler(KEYPAD_PIO_IRQ, keypad_pio_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    pio_set_irq0_source_enabled(KEYPAD_PIO, pio_get_rx_fifo_not_empty_interrupt_source((uint)sm), true);
+    irq_set_enabled(KEYPAD_PIO_IRQ, true);
+
+    keypad_varredura_program_init(KEYPAD_PIO, (uint)sm, offset, linhas[2], linhas[3], colunas[3], divisor());
+    return true;
+}
+
+void keypad_pio_ajustar_clock(void) {
+    if (sm >= 0) pio_sm_set_clkdiv(KEYPAD_PIO, (uint)sm, divisor());
+}
@@ -0,0 +1,54 @@
+#ifndef KEYPAD_PIO_H
+#define KEYPAD_PIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/types.h"
+
+// Ciclo da state machine: cada linha fica ativa um ciclo antes da leitura das colunas, o mesmo
+// tempo de acomodação da varredura pela CPU (KEYPAD_ACOMODACAO_US); a varredura completa leva 11 ciclos
+#define KEYPAD_PIO_CICLO_US 5
+
+/**
+ * @brief Função chamada, em contexto de interrupção, com cada leitura que difere da anterior.
+ *
+ * @param bruto Bit linha * 4 + coluna em 1 quando a tecla está fechada.
+ */
+typedef void (*keypad_pio_callback_t)(uint16_t bruto);
+
+/**
+ * @brief Converte a leitura da state machine para a do teclado.
+ *
+ * A ROW1 entra primeiro e termina nos bits 12 a 15, e em cada linha o bit 0 é o pino mais baixo
+ * (COL4): a tecla (linha, coluna) fica no bit 15 - (linha * 4 + coluna), em nível baixo. Basta
+ * inverter os níveis e a ordem dos 16 bits.
+ */
+static inline uint16_t keypad_pio_converter(uint32_t leitura) {
+    uint32_t v = ~leitura & 0xFFFFu;
+
+    v = ((v >> 1) & 0x5555u) | ((v & 0x5555u) << 1);
+    v = ((v >> 2) & 0x3333u) | ((v & 0x3333u) << 2);
+    v = ((v >> 4) & 0x0F0Fu) | ((v & 0x0F0Fu) << 4);
+    return (uint16_t)((v >> 8) | (v << 8));
+}
+
+/**
+ * @brief Passa a varredura do teclado ao programa keypad_varredura, numa state machine da pio1.
+ *
+ * A state machine ativa as linhas em sequência, lê as quatro colunas e só coloca a leitura na
+ * FIFO RX quando ela muda; a interrupção de FIFO não vazia (PIO1_IRQ_0, compartilhada) converte
+ * a leitura para a ordem linha/coluna do teclado e a entrega ao callback. A CPU não participa da
+ * varredura e só é acordada quando alguma tecla muda.
+ *
+ * O programa exige a disposição da placa: colunas consecutivas com COL1 no pino mais alto (GPIO
+ * 21 a 18), ROW1 a ROW3 consecutivas em ordem decrescente (GPIO 28 a 26, o grupo de set) e ROW4
+ * em qualquer outro pino (GPIO 22, o pino de side-set).
+ *
+ * @return false se os pinos não tiverem essa disposição.
+ */
+bool keypad_pio_iniciar(const uint linhas[4], const uint colunas[4], keypad_pio_callback_t callback);
+
+// Refaz o divisor da state machine após uma troca do clock do sistema
+void keypad_pio_ajustar_clock(void);
+
+#endif
@@ -0,0 +1,53 @@
+#include "layout.h"
+
+layout_t layout_matriz;
+
+// Índice de (x, y) numa grade percorrida linha a linha, invertendo as linhas ímpares em serpentina
+static uint32_t indice_grade(uint32_t x, uint32_t y, uint32_t largura, layout_fiacao_t fiacao) {
+    if (fiacao == LAYOUT_SERPENTINA && (y & 1)) x = largura - 1 - x;
+    return y * largura + x;
+}
+
+bool layout_montar(layout_t *layout, const layout_config_t *config) {
+    uint32_t largura = config->largura, altura = config->altura;
+    if (largura == 0 || altura == 0 || config->paineis_x == 0 || config->paineis_y == 0 || config->rotacao > 3) {
+        return false;
+    }
+    uint32_t pixels_painel = largura * altura;
+    uint32_t total = pixels_painel * config->paineis_x * config->paineis_y;
+    if (total > LAYOUT_MAX_PIXELS) return false;
+
+    // Dimensões do painel na imagem lógica: um quarto de volta troca largura e altura
+    uint32_t lw = (config->rotacao & 1) ? altura : largura;
+    uint32_t lh = (config->rotacao & 1) ? largura : altura;
+
+    layout->largura = (uint16_t)(lw * config->paineis_x);
+    layout->altura = (uint16_t)(lh * config->paineis_y);
+    layout->num_pixels = (uint16_t)total;
+
+    for (uint32_t y = 0; y < layout->altura; y++) {
+        for (uint32_t x = 0; x < layout->largura; x++) {
+            uint32_t px = x % lw, py = y % lh;
+            if (config->espelhar_x) px = lw - 1 - px;
+            if (config->espelhar_y) py = lh - 1 - py;
+
+            // Rotação no sentido horário de uma imagem lw x lh até a orientação da fiação
+            uint32_t nx, ny;
+            switch (config->rotacao) {
+                case 1: nx = lh - 1 - py; ny = px; break;
+                case 2: nx = lw - 1 - px; ny = lh - 1 - py; break;
+                case 3: nx = py; ny = lw - 1 - px; break;
+                default: nx = px; ny = py; break;
+            }
+
+            uint32_t painel = indice_grade(x / lw, y / lh, config->paineis_x, config->fiacao_paineis);
+            layout->fisico[y * layout->largura + x] =
+                (uint16_t)(painel * pixels_painel + indice_grade(nx, ny, largura, config->fiacao));
+        }
+    }
+    return true;
+}
+
+bool layout_definir(const layout_config_t *config) {
+    return layout_montar(&layout_matriz, config);
+}
@@ -0,0 +1,65 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Tabela de remapeamento da imagem lógica para a ordem dos LEDs na cadeia.
+ *
+ * A imagem lógica é lida linha a linha a partir do canto superior esquerdo: o pixel (x, y)
+ * tem índice lógico y * largura + x. Cada painel é descrito na orientação da sua fiação (a
+ * cadeia entra pelo canto superior esquerdo e percorre as linhas, em serpentina ou sempre no
+ * mesmo sentido); a imagem é espelhada e depois girada em quartos de volta até essa orientação.
+ * Painéis iguais podem formar um mosaico, encadeados linha a linha ou em serpentina.
+ *
+ * A tabela é montada uma vez; quem codifica um frame grava cada pixel lógico direto na
+ * posição física (frame[fisico[i]] = cor), sem cálculo adicional por pixel.
+ */
+
+// Maior cadeia suportada (mosaicos incluídos)
+#define LAYOUT_MAX_PIXELS 256
+
+typedef enum {
+    LAYOUT_LINHAS,     // Todas as linhas no mesmo sentido
+    LAYOUT_SERPENTINA  // Linhas ímpares no sentido inverso
+} layout_fiacao_t;
+
+typedef struct {
+    uint8_t largura, altura;          // Painel na orientação da fiação
+    layout_fiacao_t fiacao;
+    uint8_t rotacao;                  // Quartos de volta, no sentido horário, da imagem até a fiação (0 a 3)
+    bool espelhar_x, espelhar_y;      // Espelhamentos da imagem, aplicados antes da rotação
+    uint8_t paineis_x, paineis_y;     // Mosaico de painéis (1 x 1 para um painel só)
+    layout_fiacao_t fiacao_paineis;   // Ordem dos painéis na cadeia
+} layout_config_t;
+
+typedef struct {
+    uint16_t largura, altura;         // Imagem lógica completa
+    uint16_t num_pixels;
+    uint16_t fisico[LAYOUT_MAX_PIXELS];   // Posição na cadeia de cada pixel lógico
+} layout_t;
+
+// Matriz da placa: painel 5x5 em serpentina que começa no canto inferior direito (imagem girada 180°)
+#define LAYOUT_PLACA ((layout_config_t){ \
+    .largura = 5, .altura = 5, .fiacao = LAYOUT_SERPENTINA, .rotacao = 2, .paineis_x = 1, .paineis_y = 1})
+
+// Layout em uso pela fonte, pela serial e pela simulação (definido por layout_definir)
+extern layout_t layout_matriz;
+
+/**
+ * @brief Monta a tabela de um layout.
+ *
+ * @return false se a configuração for inválida ou passar de LAYOUT_MAX_PIXELS.
+ */
+bool layout_montar(layout_t *layout, const layout_config_t *config);
+
+// Monta layout_matriz; chamada na inicialização, antes de codificar qualquer frame
+bool layout_definir(const layout_config_t *config);
+
+// Posição na cadeia do pixel lógico (x, y)
+static inline uint16_t layout_fisico(const layout_t *layout, uint16_t x, uint16_t y) {
+    return layout->fisico[y * layout->largura + x];
+}
+
+#endif
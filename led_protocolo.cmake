@@ -0,0 +1,33 @@
+# Protocolo dos LEDs (led_protocolo.h), escolhido na configuração: -DPIO_MATRIX_LED=WS2812|SK6812_RGBW|WS2811
+#
+# O C recebe PIO_MATRIX_LED como definição; a temporização do programa PIO vem dos mesmos
+# descritores: pio_matrix_gerar_pio copia pio_matrix.pio trocando os valores das diretivas
+# .define LED_CICLOS_* pelos da variante (LED_<variante>_CICLOS_* em led_protocolo.h).
+
+set(LED_PROTOCOLO_DIR ${CMAKE_CURRENT_LIST_DIR})
+set(PIO_MATRIX_LED WS2812 CACHE STRING "LED protocol: WS2812, SK6812_RGBW or WS2811")
+set_property(CACHE PIO_MATRIX_LED PROPERTY STRINGS WS2812 SK6812_RGBW WS2811)
+
+file(STRINGS ${LED_PROTOCOLO_DIR}/led_protocolo.h LED_PROTOCOLO_CICLOS
+     REGEX "^#define LED_${PIO_MATRIX_LED}_CICLOS_[A-Z0-9]+ [0-9]+$")
+if (NOT LED_PROTOCOLO_CICLOS)
+    message(FATAL_ERROR "PIO_MATRIX_LED=${PIO_MATRIX_LED} não está em led_protocolo.h")
+endif()
+add_compile_definitions(PIO_MATRIX_LED=${PIO_MATRIX_LED})
+message(STATUS "pio_matrix: protocolo de LED ${PIO_MATRIX_LED}")
+
+# Gera em saida uma cópia de pio_matrix.pio com a temporização da variante escolhida
+function(pio_matrix_gerar_pio saida)
+    file(READ ${LED_PROTOCOLO_DIR}/pio_matrix.pio conteudo)
+    foreach(linha ${LED_PROTOCOLO_CICLOS})
+        string(REGEX REPLACE "^#define LED_${PIO_MATRIX_LED}_(CICLOS_[A-Z0-9]+) ([0-9]+)$" "\\1;\\2" campo "${linha}")
+        list(GET campo 0 nome)
+        list(GET campo 1 valor)
+        string(REGEX REPLACE "\\.define LED_${nome} [0-9]+" ".define LED_${nome} ${valor}" conteudo "${conteudo}")
+    endforeach()
+    # A cópia só é reescrita quando muda, para não remontar o programa a cada configuração
+    file(WRITE ${saida}.tmp "${conteudo}")
+    configure_file(${saida}.tmp ${saida} COPYONLY)
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS
+                 ${LED_PROTOCOLO_DIR}/pio_matrix.pio ${LED_PROTOCOLO_DIR}/led_protocolo.h)
+endfunction()
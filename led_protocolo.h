@@ -0,0 +1,104 @@
+#ifndef LED_PROTOCOLO_H
+#define LED_PROTOCOLO_H
+
+#include <stdint.h>
+
+/**
+ * @brief Descritores dos protocolos de LED endereçável suportados, escolhidos na compilação.
+ *
+ * PIO_MATRIX_LED (WS2812, SK6812_RGBW ou WS2811) seleciona um dos blocos abaixo; cada campo
+ * LED_<variante>_<campo> vira LED_<campo>. Os tempos estão em ciclos da PIO, que roda a
+ * LED_FREQ_BIT_HZ * LED_CICLOS_BIT: o CMake copia LED_CICLOS_* para as diretivas .define de
+ * pio_matrix.pio (led_protocolo.cmake), e pio_matrix_program_init usa a frequência e LED_BITS.
+ *
+ * Cada canal ocupa 8 bits da palavra enviada à FIFO, a partir do bit 31 (a PIO desloca para a
+ * esquerda): LED_DESLOC_<canal> é a posição do byte. Variantes sem branco não enviam o byte W.
+ */
+
+// WS2812/WS2812B: 800 kHz, GRB. T0H 375 ns e T1H 750 ns (especificação 250..550 e 650..950)
+#define LED_WS2812_NOME "WS2812"
+#define LED_WS2812_FREQ_BIT_HZ 800000
+#define LED_WS2812_CICLOS_BIT 10
+#define LED_WS2812_CICLOS_T0H 3
+#define LED_WS2812_CICLOS_T1H 6
+#define LED_WS2812_BITS 24
+#define LED_WS2812_DESLOC_G 24
+#define LED_WS2812_DESLOC_R 16
+#define LED_WS2812_DESLOC_B 8
+#define LED_WS2812_DESLOC_W 0
+#define LED_WS2812_RESET_US 50
+
+// SK6812 RGBW: 800 kHz, GRBW. T0H 375 ns e T1H 625 ns (especificação 150..450 e 450..750)
+#define LED_SK6812_RGBW_NOME "SK6812 RGBW"
+#define LED_SK6812_RGBW_FREQ_BIT_HZ 800000
+#define LED_SK6812_RGBW_CICLOS_BIT 10
+#define LED_SK6812_RGBW_CICLOS_T0H 3
+#define LED_SK6812_RGBW_CICLOS_T1H 5
+#define LED_SK6812_RGBW_BITS 32
+#define LED_SK6812_RGBW_DESLOC_G 24
+#define LED_SK6812_RGBW_DESLOC_R 16
+#define LED_SK6812_RGBW_DESLOC_B 8
+#define LED_SK6812_RGBW_DESLOC_W 0
+#define LED_SK6812_RGBW_RESET_US 80
+
+// WS2811 (modo de 400 kHz): RGB. T0H 500 ns e T1H 1250 ns (especificação 350..650 e 1050..1350)
+#define LED_WS2811_NOME "WS2811"
+#define LED_WS2811_FREQ_BIT_HZ 400000
+#define LED_WS2811_CICLOS_BIT 10
+#define LED_WS2811_CICLOS_T0H 2
+#define LED_WS2811_CICLOS_T1H 5
+#define LED_WS2811_BITS 24
+#define LED_WS2811_DESLOC_G 16
+#define LED_WS2811_DESLOC_R 24
+#define LED_WS2811_DESLOC_B 8
+#define LED_WS2811_DESLOC_W 0
+#define LED_WS2811_RESET_US 50
+
+#ifndef PIO_MATRIX_LED
+#define PIO_MATRIX_LED WS2812
+#endif
+
+#define LED_CAMPO_(variante, campo) LED_##variante##_##campo
+#define LED_CAMPO(variante, campo) LED_CAMPO_(variante, campo)
+
+#define LED_NOME        LED_CAMPO(PIO_MATRIX_LED, NOME)
+#define LED_FREQ_BIT_HZ LED_CAMPO(PIO_MATRIX_LED, FREQ_BIT_HZ)
+#define LED_CICLOS_BIT  LED_CAMPO(PIO_MATRIX_LED, CICLOS_BIT)
+#define LED_CICLOS_T0H  LED_CAMPO(PIO_MATRIX_LED, CICLOS_T0H)
+#define LED_CICLOS_T1H  LED_CAMPO(PIO_MATRIX_LED, CICLOS_T1H)
+#define LED_BITS        LED_CAMPO(PIO_MATRIX_LED, BITS)
+#define LED_DESLOC_G    LED_CAMPO(PIO_MATRIX_LED, DESLOC_G)
+#define LED_DESLOC_R    LED_CAMPO(PIO_MATRIX_LED, DESLOC_R)
+#define LED_DESLOC_B    LED_CAMPO(PIO_MATRIX_LED, DESLOC_B)
+#define LED_DESLOC_W    LED_CAMPO(PIO_MATRIX_LED, DESLOC_W)
+#define LED_RESET_US    LED_CAMPO(PIO_MATRIX_LED, RESET_US)
+
+// Clock da PIO e tempo de uma palavra no fio
+#define LED_FREQ_PIO_HZ (LED_FREQ_BIT_HZ * LED_CICLOS_BIT)
+#define LED_US_POR_PIXEL ((LED_BITS * 1000000u + LED_FREQ_BIT_HZ - 1) / LED_FREQ_BIT_HZ)
+
+// Canal branco presente (32 bits por LED): multiplica o byte W, que some das variantes RGB
+#define LED_TEM_BRANCO (LED_BITS == 32)
+
+// O programa PIO precisa de dois ciclos antes do pulso e um depois (ver pio_matrix.pio)
+#if LED_CICLOS_T0H < 1 || LED_CICLOS_T1H <= LED_CICLOS_T0H || LED_CICLOS_T1H + 3 > LED_CICLOS_BIT
+#error "temporização de PIO_MATRIX_LED incompatível com o programa pio_matrix"
+#endif
+
+/**
+ * @brief Palavra da FIFO para canais já corrigidos (gama e brilho), como expressão constante.
+ *
+ * Os deslocamentos são constantes da variante: nenhum desvio por pixel.
+ */
+#define LED_PALAVRA(r, g, b, w) \
+    (((uint32_t)(g) << LED_DESLOC_G) | ((uint32_t)(r) << LED_DESLOC_R) | ((uint32_t)(b) << LED_DESLOC_B) | \
+     ((uint32_t)(w) * LED_TEM_BRANCO << LED_DESLOC_W))
+
+static inline uint32_t led_palavra(uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+    return LED_PALAVRA(r, g, b, w);
+}
+
+// Canal de uma palavra codificada (para inspeção no host)
+#define LED_CANAL(palavra, desloc) ((uint8_t)((palavra) >> (desloc)))
+
+#endif
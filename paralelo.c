@@ -0,0 +1,45 @@
+#include "paralelo.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Transpõe uma matriz de 8x8 bits guardada em duas palavras (transpose8 de Hacker's Delight).
+ *
+ * Entrada: linha i no byte i, do mais alto de x (i = 0) ao mais baixo de y (i = 7).
+ * Saída: coluna j (bit 7 - j de cada linha) no byte j, na mesma disposição.
+ */
+static inline void transpor8x8(uint32_t *px, uint32_t *py) {
+    uint32_t x = *px, y = *py, t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AAu;  x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AAu;  y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCCu; x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCCu; y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0u) | ((y >> 4) & 0x0F0F0F0Fu);
+    y = ((x << 4) & 0xF0F0F0F0u) | (y & 0x0F0F0F0Fu);
+
+    *px = t;
+    *py = y;
+}
+
+void paralelo_transpor(const uint32_t *const pistas[PARALELO_PISTAS], uint32_t num_pixels, uint32_t *saida) {
+    for (uint32_t i = 0; i < num_pixels; i++) {
+        uint32_t p[PARALELO_PISTAS];
+
+        for (int n = 0; n < PARALELO_PISTAS; n++) {
+            p[n] = pistas[n] ? pistas[n][i] : 0;
+        }
+
+        // Linha i da matriz = cadeia 7 - i, para que a cadeia n termine no bit n de cada byte
+        for (int deslocamento = 24; deslocamento >= 32 - LED_BITS; deslocamento -= 8) {
+            uint32_t x = ((p[7] >> deslocamento) & 0xFF) << 24 | ((p[6] >> deslocamento) & 0xFF) << 16 |
+                         ((p[5] >> deslocamento) & 0xFF) << 8 | ((p[4] >> deslocamento) & 0xFF);
+            uint32_t y = ((p[3] >> deslocamento) & 0xFF) << 24 | ((p[2] >> deslocamento) & 0xFF) << 16 |
+                         ((p[1] >> deslocamento) & 0xFF) << 8 | ((p[0] >> deslocamento) & 0xFF);
+
+            transpor8x8(&x, &y);
+            *saida++ = x;   // Bits 7..4 do canal
+            *saida++ = y;   // Bits 3..0 do canal
+        }
+    }
+}
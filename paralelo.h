@@ -0,0 +1,27 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <stdint.h>
+#include "led_protocolo.h"
+
+// Cadeias de LEDs acionadas em paralelo pelo programa pio_matrix_paralelo
+#define PARALELO_PISTAS 8
+
+// Cada pixel de LED_BITS bits vira LED_BITS bytes (um por bit, um bit por cadeia): 6 palavras da
+// FIFO com 24 bits, 8 com RGBW
+#define PARALELO_PALAVRAS_POR_PIXEL (LED_BITS / 4)
+
+/**
+ * @brief Intercala 8 buffers de pixels (um por cadeia) no fluxo de palavras do programa paralelo.
+ *
+ * Para cada pixel e cada bit, do mais significativo da palavra ao último de LED_BITS, gera um
+ * byte cujo bit n é o bit correspondente da cadeia n; quatro bytes formam uma palavra, com o
+ * primeiro no byte mais alto. A transposição 8x8 de cada canal é feita em registradores (SWAR).
+ *
+ * @param pistas Buffers no formato de cor_grb (led_palavra); NULL para cadeias sem LEDs.
+ * @param num_pixels Pixels por cadeia.
+ * @param saida Destino com num_pixels * PARALELO_PALAVRAS_POR_PIXEL palavras.
+ */
+void paralelo_transpor(const uint32_t *const pistas[PARALELO_PISTAS], uint32_t num_pixels, uint32_t *saida);
+
+#endif
@@ -1,558 +1,401 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
-#include "pico/stdlib.h"
-#include "hardware/pio.h"
-#include "hardware/clocks.h"
-#include "hardware/adc.h"
-#include "pico/bootrom.h"
-
-// Arquivo .pio
-#include "pio_matrix.pio.h"
-
-// Definição dos pinos do Keypad
-#define ROW1 28
-#define ROW2 27
-#define ROW3 26
-#define ROW4 22
-#define COL1 21
-#define COL2 20
-#define COL3 19
-#define COL4 18
-
-// Pino de saída
-#define OUT_PIN 7
-
-// Número de LEDs
-#define NUM_PIXELS 25
 
-/**
- * @brief Mapeamento das teclas do Keypad
- * 
- * A matriz de teclas representa a organização do teclado matricial 4x4.
- */
-const char keys[4][4] = {
-    {'1', '2', '3', 'A'},
-    {'4', '5', '6', 'B'},
-    {'7', '8', '9', 'C'},
-    {'*', '0', '#', 'D'}
-};
-//botão B
-double blue_max[25] = {1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0};
-
-//vetor para criar as letras de A a E
-double letras[125] = {
-    1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, // A
-    1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, // B
-
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    0.0, 0.0, 0.0, 0.0, 1.0, 
-    1.0, 0.0, 0.0, 0.0, 0.0, 
-    0.0, 0.0, 0.0, 0.0, 1.0, 
-    1.0, 1.0, 1.0, 1.0, 1.0, // C
-    
-    1.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.0, // D
-    
-    1.0, 1.0, 1.0, 1.0, 1.0, 
-    0.0, 0.0, 0.0, 0.0, 1.0, 
-    1.0, 1.0, 1.0, 1.0, 0.0, 
-    0.0, 0.0, 0.0, 0.0, 1.0, 
-    1.0, 1.0, 1.0, 1.0, 1.0  // E
-};
+// Abstração de hardware: SDK da Pico no dispositivo, backend simulado no host
+#include "hal.h"
 
-// Vetor de desenho para as letras F, G, H, I e J.
-double tecla_3[125] = {
-    // Letra F
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    0.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    0.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 0.0,
-
-    // Letra G
-    0.0, 1.0, 1.0, 1.0, 0.0,
-    0.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 1.0, 1.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    0.0, 1.0, 1.0, 1.0, 1.0,
-
-    // Letra H
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-
-    // Letra I
-    0.0, 1.0, 1.0, 1.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 1.0, 1.0, 1.0, 0.0,
-
-    // Letra J
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 1.0,
-    1.0, 1.0, 1.0, 0.0, 0.0,
-};
+#include "pio_matrix.h"
 
-// Vetor de desenho para as letras K, L, M, N e O.
-double tecla_4[125] = {
-    // Letra K
-    1.0, 0.0, 0.0, 1.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 1.0,
-    1.0, 1.0, 0.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 1.0, 0.0,
-
-    // Letra L
-    1.0, 0.0, 0.0, 0.0, 0.0,
-    0.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 0.0,
-    0.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 0.0,
-
-    // Letra M
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 1.0, 0.0, 1.0, 1.0,
-    1.0, 0.0, 1.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-
-    // Letra N
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 1.0, 1.0,
-    1.0, 0.0, 1.0, 0.0, 1.0,
-    1.0, 1.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-
-    // Letra O
-    0.0, 1.0, 1.0, 1.0, 0.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    0.0, 1.0, 1.0, 1.0, 0.0,
-};
+// Codificação de cores em ponto fixo
+#include "cor.h"
 
-// Vetor de desenho para as letras P, Q, R, S e T.
-double tecla_5[125] = {
-    // Letra P
-    1.0, 1.0, 1.0, 1.0, 0.0,
-    0.0, 1.0, 0.0, 0.0, 1.0, 
-    1.0, 1.0, 1.0, 1.0, 0.0,
-    0.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 0.0,
-
-    // Letra Q
-    0.0, 1.0, 1.0, 1.0, 0.0,
-    1.0, 0.0, 0.0, 0.0, 1.0, 
-    1.0, 0.0, 1.0, 0.0, 1.0,
-    1.0, 1.0, 0.0, 0.0, 1.0,
-    0.0, 1.0, 1.0, 1.0, 1.0,
-
-    // Letra R
-    1.0, 1.0, 1.0, 1.0, 0.0,
-    0.0, 1.0, 0.0, 0.0, 1.0, 
-    1.0, 1.0, 1.0, 1.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 1.0, 0.0,
-
-    // Letra S
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    0.0, 0.0, 0.0, 0.0, 1.0, 
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 0.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-
-    // Letra T
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    0.0, 0.0, 1.0, 0.0, 0.0, 
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0};
-
-
-// Vetor de desenho para as letras U, V, W, X, e Y.
-double tecla_6[125] = {
-    // Letra U 
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-
-    // Letra V
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    0.0, 1.0, 0.0, 1.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-
-    // Letra W
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 1.0, 0.0, 1.0,
-    1.0, 1.0, 0.0, 1.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-
-    // Letra X
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    0.0, 1.0, 0.0, 1.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 1.0, 0.0, 1.0, 0.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-
-    // Letra Y
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    0.0, 1.0, 1.0, 1.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-};
+// Escalonador de animações não bloqueante
+#include "animacao.h"
 
-// Vetor de desenho para os números 0, 1, 2, 3 e 4.
-double tecla_7[125] = {
-    //Numero 0
-    0.0, 1.0, 1.0, 1.0, 0.0,
-    1.0, 1.0, 0.0, 0.0, 1.0,
-    1.0, 0.0, 1.0, 0.0, 1.0,
-    1.0, 0.0, 0.0, 1.0, 1.0,
-    0.0, 1.0, 1.0, 1.0, 0.0,
-
-    // Numero 1
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 1.0, 0.0, 
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 1.0, 1.0, 1.0, 0.0,
-
-    //Numero 2
-    0.0, 0.0, 1.0, 1.0, 0.0,
-    1.0, 0.0, 0.0, 1.0, 0.0,
-    0.0, 0.0, 0.0, 1.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 1.0, 1.0, 1.0, 1.0,
-
-    //Numero 3
-    0.0, 1.0, 1.0, 1.0, 0.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    0.0, 0.0, 1.0, 1.0, 0.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    0.0, 1.0, 1.0, 1.0, 0.0,
-
-    //Numero 4
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 1.0, 0.0, 
-    1.0, 1.0, 1.0, 1.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    };
-
-// Vetor de desenho para os números 5, 6, 7, 8 e 9.
-double tecla_8[125] = {
-    //Numero 5
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    0.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 0.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-
-    // Numero 6
-    1.0, 1.0, 1.0, 1.0, 0.0,
-    0.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-
-    //Numero 7
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 0.0,
-    0.0, 0.0, 0.0, 1.0, 0.0,
-    0.0, 0.0, 1.0, 0.0, 0.0,
-    0.0, 1.0, 0.0, 0.0, 0.0,
-
-    //Numero 8
-    0.0, 1.0, 1.0, 1.0, 0.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    0.0, 1.0, 1.0, 1.0, 0.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    0.0, 1.0, 1.0, 1.0, 0.0,
-
-    //Numero 9
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 1.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    1.0, 0.0, 0.0, 0.0, 0.0,
-    1.0, 1.0, 1.0, 1.0, 1.0,
-    };
+// Framebuffer duplo que descarta frames repetidos
+#include "framebuffer.h"
 
-/**
- * @brief Configura os GPIOs para o teclado matricial, LEDs e buzzer.
- * 
- * Configura as linhas (ROW) como saídas e as colunas (COL) como entradas com pull-up.
- * Além de configurar os pinos dos LEDs e do buzzer como saídas.
- */
-void setup_gpio();
+// Animações compactadas geradas por tools/compactar a partir de animacoes/
+#include "animacoes.h"
 
+// Teclado matricial por interrupção, com debounce
+#include "keypad.h"
 
-/**
- * @brief Verifica qual tecla foi pressionada no teclado matricial.
- * 
- * Itera pelas linhas e verifica se alguma coluna foi pressionada.
- * 
- * @return O caractere da tecla pressionada ou '\0' se nenhuma tecla for pressionada.
- */
-char scan_keypad();
+// Frames enviados pelo PC pela serial USB
+#include "stream.h"
+
+// Texto rolando coluna a coluna
+#include "rolagem.h"
+
+// Posição de cada pixel lógico na cadeia de LEDs (serpentina, rotação, mosaicos)
+#include "layout.h"
+
+// Pontilhado temporal para cores entre dois níveis de 8 bits
+#include "pontilhado.h"
+
+// Analisador de espectro do microfone (FFT em ponto fixo) para o visualizador da tecla '*'
+#include "espectro.h"
+
+// Efeitos procedurais (plasma, fogo, arco-íris e brilhos) com matemática inteira por tabelas
+#include "efeitos.h"
+
+// Cena em camadas: efeito ao fundo, texto rolando e barra de progresso (compositor com alfa)
+#include "cena.h"
+
+// Registro de eventos para medir latências (despejado com a tecla TECLA_TRACE segurada)
+#include "trace.h"
+
+// Modo ocioso: WFI entre eventos, tick lento e clock reduzido sem atividade
+#include "energia.h"
+
+// Tabela de comandos do teclado e roteiros em bytecode, embutidos ou recebidos pela serial
+#include "comandos.h"
+#include "roteiro.h"
+
+// Protocolo da serial: instalação de roteiros nas teclas
+#include "protocolo.h"
+
+// Clock do sistema em funcionamento normal (128 MHz divide exatamente o clock da PIO)
+#define CLOCK_KHZ 128000
+
+// Período do timer que avança as animações e os frames recebidos pela serial
+// (2 ms permite exibir até ~500 frames/s vindos do PC, próximo do limite do fio para 25 LEDs)
+#define ANIM_TICK_MS 2
 
+// Segurar esta tecla imprime o registro de eventos (trace.h) pelo stdio
+#define TECLA_TRACE '#'
+
+// Segurar as teclas '1' a '4' troca a animação da tecla pelo efeito procedural correspondente
+#define TECLA_PRIMEIRO_EFEITO '1'
+
+// '*' é também o modificador dos acordes: '*' + dígito ajusta o brilho global em nove níveis; o
+// visualizador da tecla '*' começa quando ela é solta sem ter feito acorde
+#define TECLA_ACORDE '*'
+
+// Segurar a tecla '0' rola o texto sobre o plasma, com uma barra do quanto já passou
+#define TECLA_CENA '0'
+
+// Período dos frames dos efeitos (~60 frames/s); o framebuffer descarta os que não mudam
+#define EFEITO_PERIODO_MS 16
+
+// Com a fila de recepção cheia, o PC é freado pelo USB em vez de perder bytes
+#define STREAM_POLITICA STREAM_SEGURAR
+
+// Textos exibidos pelas teclas '2' a '8', um caractere por frame
+#define NUM_TEXTOS 7
+
+// Texto que rola pela matriz ao pressionar '0', em verde, uma coluna a cada ROLAGEM_PERIODO_MS
+#define ROLAGEM_TEXTO "GPIO LED 5X5"
+#define ROLAGEM_PERIODO_MS 120
+
+// Textos A-E, F-J, K-O, P-T, U-Y, 0-4 e 5-9 em contêineres compactados (animacoes/texto_*.txt):
+// cada frame é decodificado quando o passo começa, sem ocupar RAM com os frames prontos
+const anim_sequencia_t seq_texto[NUM_TEXTOS] = {
+    {.compactada = anim_texto_abcde}, {.compactada = anim_texto_fghij}, {.compactada = anim_texto_klmno},
+    {.compactada = anim_texto_pqrst}, {.compactada = anim_texto_uvwxy}, {.compactada = anim_texto_01234},
+    {.compactada = anim_texto_56789}
+};
+
+// Animações das teclas '1' e '9' em frames pré-codificados no build (animacoes/tecla_1.txt e tecla_9.txt):
+// contíguas em flash, tocar um passo não exige cálculo algum
+const anim_sequencia_t seq_tecla_1 = {.passos = anim_tecla_1,
+                                      .num_passos = sizeof(anim_tecla_1) / sizeof(anim_tecla_1[0])};
+const anim_sequencia_t seq_tecla_9 = {.passos = anim_tecla_9,
+                                      .num_passos = sizeof(anim_tecla_9) / sizeof(anim_tecla_9[0])};
+
+// Teclas 'A' e 'B': roteiros de cor única, exibidos em um único passo
+static const uint8_t programa_apagado[] = {ROT_COR(0, 0, 0), ROT_PREENCHER, ROT_ESPERAR(0), ROT_FIM};
+static const uint8_t programa_tecla_b[] = {ROT_COR(0, 0, 255), ROT_PREENCHER, ROT_ESPERAR(0), ROT_FIM};
+
+// Tecla 'A' segurada: contagem regressiva de 3 a 1, cada dígito esmaecendo, e três piscadas em verde
+static const uint8_t programa_contagem[] = {
+    ROT_COR(255, 160, 0),
+    ROT_GLIFO('3'), ROT_NIVEL(255), ROT_ESPERAR(400), ROT_ESMAECER(0, 12, 25),
+    ROT_GLIFO('2'), ROT_NIVEL(255), ROT_ESPERAR(400), ROT_ESMAECER(0, 12, 25),
+    ROT_GLIFO('1'), ROT_NIVEL(255), ROT_ESPERAR(400), ROT_ESMAECER(0, 12, 25),
+    ROT_COR(0, 255, 0), ROT_PREENCHER,
+    ROT_REPETIR(3),
+        ROT_NIVEL(255), ROT_ESPERAR(150), ROT_NIVEL(0), ROT_ESPERAR(150),
+    ROT_VOLTAR,
+    ROT_FIM
+};
+
+// Tecla 'B' segurada: azul "respirando" até outro comando
+static const uint8_t programa_respirar[] = {
+    ROT_COR(0, 0, 255), ROT_PREENCHER, ROT_NIVEL(16),
+    ROT_REPETIR(0),
+        ROT_ESMAECER(255, 40, 20), ROT_ESMAECER(16, 40, 20),
+    ROT_VOLTAR
+};
+
+roteiro_t roteiro_apagado = ROTEIRO(programa_apagado), roteiro_tecla_b = ROTEIRO(programa_tecla_b);
+roteiro_t roteiro_contagem = ROTEIRO(programa_contagem), roteiro_respirar = ROTEIRO(programa_respirar);
+const anim_sequencia_t seq_apagado = {.gerador = roteiro_gerar, .contexto = &roteiro_apagado};
+const anim_sequencia_t seq_tecla_b = {.gerador = roteiro_gerar, .contexto = &roteiro_tecla_b};
+const anim_sequencia_t seq_contagem = {.gerador = roteiro_gerar, .contexto = &roteiro_contagem};
+const anim_sequencia_t seq_respirar = {.gerador = roteiro_gerar, .contexto = &roteiro_respirar};
+
+// Teclas 'C', 'D' e '#': intensidades que caem entre dois níveis do LED depois da gama
+// (o branco a 20% vira 7,3), renovadas a cada tick com pontilhado temporal; a imagem não muda,
+// então mantê-la não conta como atividade para o modo ocioso
+pontilhado_t pontilhado_tecla_c, pontilhado_tecla_d, pontilhado_tecla_hash;
+const anim_sequencia_t seq_tecla_c = {.gerador = pontilhado_gerar, .contexto = &pontilhado_tecla_c, .manter = true};
+const anim_sequencia_t seq_tecla_d = {.gerador = pontilhado_gerar, .contexto = &pontilhado_tecla_d, .manter = true};
+const anim_sequencia_t seq_tecla_hash = {.gerador = pontilhado_gerar, .contexto = &pontilhado_tecla_hash, .manter = true};
+
+// Rolagem da tecla '0': cada passo da sequência desloca o texto uma coluna
+rolagem_t rolagem_tecla_0;
+const anim_sequencia_t seq_tecla_0 = {.gerador = rolagem_gerar, .contexto = &rolagem_tecla_0};
+
+// Efeitos das teclas '1' a '4' seguradas, cada um com seu próprio estado
+efeito_t efeitos[EFEITO_NUM];
+anim_sequencia_t seq_efeitos[EFEITO_NUM];
+
+// Cena da tecla '0' segurada: reaproveita o plasma e a rolagem da tecla '0'
+cena_t cena_tecla_0;
+const anim_sequencia_t seq_cena_tecla_0 = {.gerador = cena_gerar, .contexto = &cena_tecla_0};
+
+// Visualizador da tecla '*': o ADC preenche um buffer por DMA enquanto o outro é analisado no laço
+// principal; o gerador desenha os níveis mais recentes a cada tick
+espectro_t espectro_tecla_asterisco;
+const anim_sequencia_t seq_tecla_asterisco = {.gerador = espectro_gerar, .contexto = &espectro_tecla_asterisco};
+uint16_t amostras_microfone[2][ESPECTRO_N];
+bool visualizador_ativo = false;
+
+// Bloco completo aguardando análise (NULL se nenhum), entregue pela interrupção do DMA
+const uint16_t *volatile bloco_microfone = NULL;
+
+// Timer que avança as animações sem ocupar o laço principal (modo de um núcleo)
+hal_timer_t timer_animacao;
 
 /**
- * @brief Executa comandos baseados na tecla pressionada.
- * 
- * Executa comandos para acender os LEDs e emitir som no buzzer.
- * Além de imprimir mensagens no console para informar o comando executado.
+ * @brief Prepara o estado das animações geradas na hora (rolagem, efeitos, cena e pontilhado).
  *
- * @param key A tecla pressionada.
+ * Executada uma vez na inicialização, antes de qualquer comando.
  */
-// Executa um comando baseado em uma tecla pressionada e controla os LEDs conforme o valor fornecido
-void execute_comando(char key, uint32_t valor_led, PIO pio, uint sm, double r, double g, double b);
-
-// Desenha um padrão de LEDs usando o periférico PIO (Programmable Input/Output) do RP2040
-// Parâmetros:
-// - desenho: ponteiro para os dados do desenho a serem exibidos
-// - valor_led: valor que representa os LEDs que devem ser alterados
-// - pio: controlador PIO utilizado
-// - sm: state machine dentro do PIO
-// - r, g, b: valores de cor em formato de ponto flutuante (0.0 a 1.0)
-void desenho_pio(double *desenho, uint32_t valor_led, PIO pio, uint sm, double r, double g, double b);
+void preparar_animacoes(void);
 
-// Imprime a representação binária de um número inteiro de 32 bits
-// Útil para depuração e visualização de bits individuais
-void imprimir_binario(int num);
+#if PIO_MATRIX_DUAL_CORE
+// Laço do núcleo 1 no modo de dois núcleos: avança as animações e transmite os frames
+void core1_renderizacao();
+#endif
 
-// Converte valores de cor em formato de ponto flutuante (0.0 a 1.0) para um valor de 32 bits no formato RGB
-// Retorna uma composição das cores em um único valor de 32 bits (G << 24 | R << 16 | B << 8)
-uint32_t matrix_rgb(double b, double r, double g);
+// Entrega um frame à saída dos LEDs (PIO + DMA); usada pelo escalonador como saída
+bool enviar_frame(const uint32_t *frame);
 
-// Apaga todos os LEDs controlados pelo periférico PIO, definindo seus valores para zero
-// Parâmetros:
-// - valor_led: valor que representa os LEDs que devem ser apagados
-// - pio: controlador PIO utilizado
-// - sm: state machine dentro do PIO
-void apagar_leds(uint32_t valor_led, PIO pio, uint sm);
+// Relógio do escalonador, em milissegundos desde o boot
+uint32_t relogio_ms(void);
 
-// Aciona uma ação específica quando a tecla 'D' é pressionada, alterando o estado dos LEDs
-void tecla_d(uint32_t valor_led, PIO pio, uint sm);
+// Callback do timer de animação
+bool timer_animacao_callback(void *contexto);
 
-// tecla_hash: Executa a ação associada à tecla '#'
-void tecla_hash(PIO pio, uint sm);
+// Callback do DMA do ADC: só anota o buffer completo, a FFT roda fora da interrupção
+void microfone_bloco_callback(const uint16_t *amostras, uint num_amostras);
 
-// Executa a animação de encerramento, exibindo a mensagem "END" nos LEDs.
-void tecla_9(uint32_t valor_led, PIO pio, uint sm);
+// Espaça os timers no modo ocioso e os restaura na volta (energia.h)
+void energia_modo(bool economia);
 
-// Realiza a ação associada à tecla 'C', controle dos LEDs para a cor vermelha com intensidade 80%.
-void tecla_c(uint32_t valor_led, PIO pio, uint sm);
-
-// Realiza a ação associada à tecla 'C', controle dos LEDs para a cor azul com intensidade 100%.
-void tecla_b(uint32_t valor_led, PIO pio, uint sm);
+// Imprime a representação binária de um número inteiro de 32 bits
+// Útil para depuração e visualização de bits individuais
+void imprimir_binario(int num);
 
-// Aciona uma ação específica quando a tecla '1' é pressionada, alterando o estado dos LEDs
-void tecla_1(uint32_t valor_led, PIO pio, uint sm);
+// Toca o efeito procedural associado a uma tecla segurada
+void selecionar_efeito(char key);
+
+// Imprime o registro de eventos (trace.h)
+void despejar_trace(char key);
+
+// Executa o acorde de TECLA_ACORDE com outra tecla
+void executar_acorde(char key);
+
+// Liga o microfone e exibe o espectro do som em 5 colunas (graves à esquerda)
+void tecla_asterisco(char key);
+
+// Para a amostragem do microfone, se o visualizador estiver ligado
+void parar_visualizador();
+
+// Instala um roteiro recebido pela serial (PROTO_TIPO_ROTEIRO) na tecla indicada
+void roteiro_recebido(char tecla, uint8_t evento, const uint8_t *codigo, uint32_t tamanho);
+
+// Comandos do teclado: tocar uma sequência interrompe o visualizador e libera o pino do microfone
+// (parar_visualizador, passado a comandos_init); '*' é tratada à parte por também ser o modificador
+static const comando_t tabela_comandos[] = {
+    // Abertura com a mensagem GO e encerramento com a mensagem END
+    {.tecla = '1', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_tecla_1},
+    {.tecla = '9', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_tecla_9},
+
+    // Letras e números de cada tecla: A-E, F-J, K-O, P-T, U-Y, 0-4 e 5-9
+    {.tecla = '2', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_texto[0]},
+    {.tecla = '3', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_texto[1]},
+    {.tecla = '4', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_texto[2]},
+    {.tecla = '5', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_texto[3]},
+    {.tecla = '6', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_texto[4]},
+    {.tecla = '7', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_texto[5]},
+    {.tecla = '8', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_texto[6]},
+
+    {.tecla = '0', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_tecla_0,
+     .mensagem = "Rolando o texto \"" ROLAGEM_TEXTO "\"."},
+    {.tecla = 'A', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_apagado,
+     .mensagem = "Todos os LEDs foram apagados."},
+    {.tecla = 'B', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_tecla_b,
+     .mensagem = "Todos os LEDs foram acessados na cor azul com intensidade de 100 porcento."},
+    {.tecla = 'C', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_tecla_c,
+     .mensagem = "Todos os LEDs foram acessados na cor vermelha com intensidade de 80 porcento."},
+    {.tecla = 'D', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_tecla_d,
+     .mensagem = "Todos os LEDs foram acessos na cor verde com intensidade de 50 porcento."},
+    {.tecla = '#', .evento = KEYPAD_PRESSIONADA, .sequencia = &seq_tecla_hash,
+     .mensagem = "Todos os LEDs foram acessos na cor branca com intensidade de 20%."},
+    {.tecla = TECLA_ACORDE, .evento = KEYPAD_SOLTA, .acao = tecla_asterisco},
+
+    // Teclas seguradas
+    {.tecla = TECLA_PRIMEIRO_EFEITO + EFEITO_PLASMA, .evento = KEYPAD_SEGURADA, .acao = selecionar_efeito},
+    {.tecla = TECLA_PRIMEIRO_EFEITO + EFEITO_FOGO, .evento = KEYPAD_SEGURADA, .acao = selecionar_efeito},
+    {.tecla = TECLA_PRIMEIRO_EFEITO + EFEITO_ARCO_IRIS, .evento = KEYPAD_SEGURADA, .acao = selecionar_efeito},
+    {.tecla = TECLA_PRIMEIRO_EFEITO + EFEITO_BRILHOS, .evento = KEYPAD_SEGURADA, .acao = selecionar_efeito},
+    {.tecla = TECLA_CENA, .evento = KEYPAD_SEGURADA, .sequencia = &seq_cena_tecla_0,
+     .mensagem = "Rolando o texto \"" ROLAGEM_TEXTO "\" sobre o plasma."},
+    {.tecla = TECLA_TRACE, .evento = KEYPAD_SEGURADA, .acao = despejar_trace},
+    {.tecla = 'A', .evento = KEYPAD_SEGURADA, .sequencia = &seq_contagem, .mensagem = "Contagem regressiva."},
+    {.tecla = 'B', .evento = KEYPAD_SEGURADA, .sequencia = &seq_respirar, .mensagem = "Azul respirando."},
+};
 
+#ifndef PIO_MATRIX_HOST
 /**
  * @brief Função principal do programa.
  * 
- * Inicializa os GPIOs, exibe instruções e monitora as teclas pressionadas para executar comandos.
- * Fazendo uso das funções de controle dos LEDs e do buzzer.
+ * Inicializa o sistema e consome os eventos do teclado para executar comandos.
+ * As animações avançam pelo timer, de modo que o teclado continua sendo lido durante sua exibição.
  * 
  * @return Retorna 0 em caso de execução bem-sucedida.
  */
 int main() {
-    PIO pio = pio0; 
-    bool ok;
-    uint16_t i;
-    uint32_t valor_led;
-    double r = 0.0, b = 0.0 , g = 0.0;
-
-    //coloca a frequência de clock para 128 MHz, facilitando a divisão pelo clock
-    ok = set_sys_clock_khz(128000, false);
-
-    // Inicializar o sistema padrão e configurar GPIOs
-    stdio_init_all();
-
-    printf("iniciando a transmissão PIO");
-    if (ok) printf("clock set to %ld\n", clock_get_hz(clk_sys));
-    else printf("clock set failed\n");
-
-    //configurações da PIO
-    uint offset = pio_add_program(pio, &pio_matrix_program);
-    uint sm = pio_claim_unused_sm(pio, true);
-    pio_matrix_program_init(pio, sm, offset, OUT_PIN);
-
-    setup_gpio();
+    pio_matrix_iniciar();
 
     while (1) {
-        char key = scan_keypad();
-        if (key != '\0') {  // Se uma tecla foi pressionada
-            printf("Tecla pressionada: %c\n", key);
-            execute_comando(key, valor_led, pio, sm, r, g, b);
-            sleep_ms(300);         // Debounce
-        }
-
-        sleep_ms(50); // Pequeno atraso para evitar leituras incorretas
+        pio_matrix_processar_eventos();
+        // Uma rajada da serial maior que STREAM_ANALISE_BYTES deixa bytes na fila: sem WFI até esvaziá-la
+        if (!stream_pendente()) energia_ociosa();
     }
 }
+#endif
 
 
 // Implementações das funções
 
 
-void setup_gpio() {
-    // Configurando as linhas (ROW) como saídas
-    gpio_init(ROW1);
-    gpio_init(ROW2);
-    gpio_init(ROW3);
-    gpio_init(ROW4);
-    gpio_set_dir(ROW1, GPIO_OUT);
-    gpio_set_dir(ROW2, GPIO_OUT);
-    gpio_set_dir(ROW3, GPIO_OUT);
-    gpio_set_dir(ROW4, GPIO_OUT);
-
-    // Configurando as colunas (COL) como entradas com pull-up
-    gpio_init(COL1);
-    gpio_init(COL2);
-    gpio_init(COL3);
-    gpio_init(COL4);
-    gpio_set_dir(COL1, GPIO_IN);
-    gpio_set_dir(COL2, GPIO_IN);
-    gpio_set_dir(COL3, GPIO_IN);
-    gpio_set_dir(COL4, GPIO_IN);
-    gpio_pull_up(COL1);
-    gpio_pull_up(COL2);
-    gpio_pull_up(COL3);
-    gpio_pull_up(COL4);
+void pio_matrix_iniciar() {
+    //coloca a frequência de clock para 128 MHz, facilitando a divisão pelo clock
+    // Inicializar o sistema padrão (stdio)
+    uint32_t clock_hz = hal_sistema_iniciar(CLOCK_KHZ);
+
+    // Monta a tabela de gama/brilho usada na codificação das cores e a da fiação da matriz
+    cor_set_brilho(COR_BRILHO_PADRAO);
+    layout_definir(&LAYOUT_PLACA);
+    preparar_animacoes();
+    comandos_init(tabela_comandos, sizeof(tabela_comandos) / sizeof(tabela_comandos[0]), parar_visualizador);
+
+    printf("iniciando a transmissão PIO");
+    if (clock_hz) printf("clock set to %lu\n", (unsigned long)clock_hz);
+    else printf("clock set failed\n");
+
+    // Os pedidos de animação seguem por uma fila sem travas até quem executa anim_tick;
+    // os frames passam pelo framebuffer, que só transmite o que mudou
+    fb_init(enviar_frame, NUM_PIXELS);
+    anim_init(relogio_ms, fb_enviar);
+
+    // Frames recebidos pela serial seguem o mesmo caminho; o mais novo substitui o que estiver na tela
+    // e suspende as animações até STREAM_POSSE_MS sem frames novos
+    stream_init(NUM_PIXELS, fb_enviar, STREAM_POLITICA);
+    proto_roteiros(roteiro_recebido);
+
+#if PIO_MATRIX_DUAL_CORE
+    // O núcleo 1 assume a PIO, o DMA e o avanço das animações; este núcleo fica com o teclado
+    hal_nucleo1_executar(core1_renderizacao);
+    energia_init(CLOCK_KHZ, false, energia_modo);
+#else
+    // As animações avançam pelo timer; o laço principal fica livre para o teclado
+    hal_leds_iniciar(OUT_PIN);
+    hal_timer_iniciar(&timer_animacao, ANIM_TICK_MS, timer_animacao_callback, NULL);
+    energia_init(CLOCK_KHZ, true, energia_modo);
+#endif
+
+    keypad_init();
 }
 
-char scan_keypad() {
-    // Iterando pelas linhas
-    for (int row = 0; row < 4; row++) {
-        // Definir a linha atual como LOW e as outras como HIGH
-        gpio_put(ROW1, row == 0 ? 0 : 1);
-        gpio_put(ROW2, row == 1 ? 0 : 1);
-        gpio_put(ROW3, row == 2 ? 0 : 1);
-        gpio_put(ROW4, row == 3 ? 0 : 1);
-
-        // Verificar cada coluna
-        if (!gpio_get(COL1)) return keys[row][0];
-        if (!gpio_get(COL2)) return keys[row][1];
-        if (!gpio_get(COL3)) return keys[row][2];
-        if (!gpio_get(COL4)) return keys[row][3];
+void pio_matrix_processar_eventos() {
+    static uint32_t bytes_vistos = 0;
+    static bool acorde_feito = false;
+    keypad_evento_t evento;
+    stream_estatisticas_t s;
+
+    stream_processar();
+
+    // Um bloco por vez: o próximo só completa depois de um bloco inteiro de amostras (16 ms)
+    const uint16_t *bloco = bloco_microfone;
+    if (bloco) {
+        bloco_microfone = NULL;
+        espectro_bloco(&espectro_tecla_asterisco, bloco);
     }
-    // Retornar '\0' se nenhuma tecla for pressionada
-    return '\0';
-}
 
-void execute_comando(char key,uint32_t valor_led, PIO pio, uint sm, double r, double g, double b) {
-
-    switch (key) {
-        case '1':
-           tecla_1(valor_led, pio, sm); // Executa a animação de abertura e a mensagem GO.
-            break;
-
-        case '2':
-            desenho_pio(letras, valor_led, pio, sm, r, g, b);
-            break;
-
-        case '3':
-            desenho_pio(tecla_3, valor_led, pio, sm, r, g, b); // Desenha as letras do alfabeto F até J.
-            break;
-
-        case '4':
-            desenho_pio(tecla_4, valor_led, pio, sm, r, g, b); // Desenha as letras do alfabeto K até O.
-            break;
-        
-        case '5':
-	        desenho_pio(tecla_5, valor_led, pio, sm, r, g, b); // Desenha as letras do alfabeto P até T.
-            break;
-
-        case '6':
-	        desenho_pio(tecla_6, valor_led, pio, sm, r, g, b); // Desenha as letras do alfabeto U até Z.
-            break;
-
-        case '7':
-            desenho_pio(tecla_7, valor_led, pio, sm, r, g, b); // Desenha os números de 0 a 4.
-            break;
-
-        case '8':
-            desenho_pio(tecla_8, valor_led, pio, sm, r, g, b);
-            break;
-
-        case '9':
-            tecla_9(valor_led, pio, sm); // Executa a animação de encerramento com a mensagem END.
-            break;
-
-        case 'A':
-            //Desliga todos os LEDs
-            apagar_leds(valor_led, pio, sm);
-            break;
-
-        case 'B':
-            tecla_b(valor_led, pio, sm);
-            break;
-
-        case 'C':
-            tecla_c(valor_led, pio, sm);
-            break;
-
-        case 'D':
-            tecla_d(valor_led, pio, sm);
-            break;
-
-        case '#':
-            tecla_hash(pio, sm);
-            break;
-            
-        case '0':
-            // Inserir código
-            break;
-
-        default:
+    // Animação em andamento ou bytes novos da serial mantêm o sistema fora da economia; uma
+    // imagem fixa renovada pelo pontilhado não
+    stream_obter_estatisticas(&s);
+    bool atividade = (anim_ativa() && !anim_mantendo()) || s.bytes_recebidos != bytes_vistos;
+    bytes_vistos = s.bytes_recebidos;
+
+    while (keypad_obter_evento(&evento)) {
+        atividade = true;
+        if (evento.tipo == KEYPAD_PRESSIONADA) printf("Tecla pressionada: %c\n", evento.tecla);
+
+        // Qualquer tecla que o teclado ainda lê encerra o visualizador e devolve o pino do microfone,
+        // mesmo sem comando na tabela (a matriz apaga, se o comando não tocar outra sequência);
+        // '*' e seus acordes (brilho) continuam valendo com ele ligado
+        if (visualizador_ativo && evento.tipo == KEYPAD_PRESSIONADA && evento.tecla != TECLA_ACORDE &&
+            !keypad_acorde(&evento, TECLA_ACORDE)) {
+            parar_visualizador();
+            anim_tocar(&seq_apagado, ANIM_SUBSTITUIR);
+        }
+
+        if (evento.tecla == TECLA_ACORDE) {
+            // O modificador só vale como comando se for solto sem ter feito acorde
+            if (evento.tipo == KEYPAD_PRESSIONADA) acorde_feito = false;
+            else if (evento.tipo == KEYPAD_SOLTA && !acorde_feito) comandos_executar(evento.tecla, evento.tipo);
+        } else if (keypad_acorde(&evento, TECLA_ACORDE)) {
+            // Com o modificador pressionado, a tecla só vale como acorde
+            if (evento.tipo == KEYPAD_PRESSIONADA) {
+                acorde_feito = true;
+                executar_acorde(evento.tecla);
+            }
+        } else if (!comandos_executar(evento.tecla, evento.tipo) && evento.tipo == KEYPAD_PRESSIONADA) {
             printf("Comando: Sem comando registrado.\n");
             printf("\n");
-            break;
+        }
     }
+    if (atividade) energia_atividade();
 }
 
-// Função da tecla 'd' para acender todos os leds na cor verde com intensidade de 50%
-void tecla_d(uint32_t valor_led, PIO pio, uint sm)
-{
-    for (int i = 0; i < NUM_PIXELS; i++)
-    {
-        valor_led = matrix_rgb(0.0, 0.0, 0.5);
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-    printf("Todos os LEDs foram acessos na cor verde com intensidade de 50 porcento.\n");
-}
+void preparar_animacoes(void) {
+    // As animações das teclas '1' e '9' já vêm codificadas em flash (anim_tecla_1 e anim_tecla_9),
+    // os textos das teclas '2' a '8' são decodificados durante a reprodução (seq_texto) e os
+    // roteiros das teclas 'A' e 'B' desenham cada frame quando ele começa
 
-// Função para apagar todos os leds
-void tecla_hash(PIO pio, uint sm) {
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        pio_sm_put_blocking(pio, sm, matrix_rgb(0.2, 0.2, 0.2));
+    static const uint8_t verde[3] = {0, 255, 0}, apagado[3] = {0, 0, 0};
+    rolagem_configurar(&rolagem_tecla_0, ROLAGEM_TEXTO, verde, apagado, ROLAGEM_PERIODO_MS);
+
+    efeitos_init();
+    for (int i = 0; i < EFEITO_NUM; i++) {
+        efeito_init(&efeitos[i], (efeito_tipo_t)i, EFEITO_PERIODO_MS);
+        seq_efeitos[i] = (anim_sequencia_t){.gerador = efeito_gerar, .contexto = &efeitos[i]};
     }
-    printf("Todos os LEDs foram acessos na cor branca com intensidade de 20%.\n");
-}
 
-void apagar_leds(uint32_t valor_led, PIO pio, uint sm) {
-    for (int i = 0; i < NUM_PIXELS; i++) {
-                valor_led = matrix_rgb(0.0, 0.0, 0.0);  // Todos os LEDs desligados
-                pio_sm_put_blocking(pio, sm, valor_led);
-            }
-            printf("Todos os LEDs foram apagados.\n");  
+    cena_configurar(&cena_tecla_0, &efeitos[EFEITO_PLASMA], &rolagem_tecla_0, EFEITO_PERIODO_MS);
+
+    pontilhado_init(&pontilhado_tecla_c, NUM_PIXELS, ANIM_TICK_MS);
+    pontilhado_preencher(&pontilhado_tecla_c, 204, 0, 0);
+    pontilhado_init(&pontilhado_tecla_d, NUM_PIXELS, ANIM_TICK_MS);
+    pontilhado_preencher(&pontilhado_tecla_d, 0, 128, 0);
+    pontilhado_init(&pontilhado_tecla_hash, NUM_PIXELS, ANIM_TICK_MS);
+    pontilhado_preencher(&pontilhado_tecla_hash, 51, 51, 51);
 }
 
 // Função para imprimir a representação binária de um número inteiro de 32 bits
@@ -563,188 +406,117 @@ void imprimir_binario(int num) {
  }
 }
 
-// Função para converter valores de cor em uma matriz RGB de 32 bits
-uint32_t matrix_rgb(double b, double r, double g)
-{
-  unsigned char R, G, B;
-  R = r * 255;
-  G = g * 255;
-  B = b * 255;
-  return (G << 24) | (R << 16) | (B << 8);
-}
+#if PIO_MATRIX_DUAL_CORE
+void core1_renderizacao() {
+    // A PIO e o DMA são configurados aqui para que suas interrupções sejam atendidas pelo núcleo 1
+    hal_leds_iniciar(OUT_PIN);
 
-// Função para fazer os desenhos 
-void desenho_pio(double *desenho, uint32_t valor_led, PIO pio, uint sm, double r, double g, double b) {
-    for (int letra = 0; letra < 5; letra++) { // 5 letras, cada uma com 25 LEDs
-        for (int16_t i = 0; i < NUM_PIXELS; i++) {
-            // Calcular o índice correto na matriz para cada letra
-            int indice = (letra * 25) + (24 - i); 
-            valor_led = matrix_rgb(desenho[indice], r, g);
-            pio_sm_put_blocking(pio, sm, valor_led);
-        }
-        sleep_ms(1500); // Intervalo de 1,5 segundo antes de acender a próxima letra
+    // Ticks em instantes absolutos: o tratamento do teclado no outro núcleo não altera o ritmo
+    uint64_t proximo_tick_us = hal_agora_us();
+    while (1) {
+        anim_suspender(stream_tick());
+        anim_tick();
+        proximo_tick_us += ANIM_TICK_MS * 1000u;
+        hal_dormir_ate_us(proximo_tick_us);
     }
 }
-void tecla_b(uint32_t valor_led, PIO pio, uint sm)
-{
-    for (int i = 0; i < NUM_PIXELS; i++)
-    {
-        valor_led = matrix_rgb(1.0, 0.0, 0.0); 
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-    printf("Todos os LEDs foram acessados na cor auzl com intensidade de 100 porcento.\n");
+#endif
+
+// Função usada como saída do escalonador: envia o frame pela FIFO da PIO (via DMA no dispositivo)
+bool enviar_frame(const uint32_t *frame) {
+    if (!hal_leds_enviar(frame, NUM_PIXELS)) return false;
+    TRACE(TRACE_TRANSMISSAO, NUM_PIXELS);
+    return true;
 }
 
-void tecla_c(uint32_t valor_led, PIO pio, uint sm)
-{
-    for (int i = 0; i < NUM_PIXELS; i++)
-    {
-        valor_led = matrix_rgb(0.0, 0.8, 0.0); 
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-    printf("Todos os LEDs foram acessados na cor vermelha com intensidade de 80 porcento.\n");
+uint32_t relogio_ms(void) {
+    return hal_agora_ms();
 }
 
-void tecla_9(uint32_t valor_led, PIO pio, uint sm) {
-    // Frame 1: LEDs formam um quadrado ao redor.
-    double quadrado[25] = {
-        1.0, 1.0, 1.0, 1.0, 1.0,
-        1.0, 1.0, 1.0, 1.0, 1.0,
-        1.0, 1.0, 1.0, 1.0, 1.0,
-        1.0, 1.0, 1.0, 1.0, 1.0,
-        1.0, 1.0, 1.0, 1.0, 1.0
-    };
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        valor_led = matrix_rgb(1.0, 1.0, 1.0); // Branco (B = R = G = 1.0)
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-    sleep_ms(2000);
-
-    // Frame 2: Seta apontando para baixo
-    double seta[25] = {
-        0.0, 1.0, 1.0, 1.0, 0.0, 
-        1.0, 0.0, 1.0, 0.0, 1.0, 
-        0.0, 0.0, 1.0, 0.0, 0.0, 
-        0.0, 0.0, 1.0, 0.0, 0.0, 
-        0.0, 0.0, 1.0, 0.0, 0.0  
-    };
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        valor_led = matrix_rgb(seta[i], 0.0, 0.0); // Azul (B=1.0)
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-    sleep_ms(2000);
-
-    // Frame 3: LEDs formam a letra E
-    double letraE[25] = {
-        1.0, 1.0, 1.0, 1.0, 1.0, 
-        1.0, 0.0, 0.0, 0.0, 0.0, 
-        0.0, 0.0, 1.0, 1.0, 1.0, 
-        1.0, 0.0, 0.0, 0.0, 0.0, 
-        1.0, 1.0, 1.0, 1.0, 1.0  
-    };
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        valor_led = matrix_rgb(0.0, letraE[i], 0.0); // Vermelho (R=1.0)
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-    sleep_ms(2000);
-
-    // Frame 4: LEDs formam a letra N
-    double letraN[25] = {
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        1.0, 0.0, 0.0, 1.0, 1.0,
-        1.0, 0.0, 1.0, 0.0, 1.0,
-        1.0, 1.0, 0.0, 0.0, 1.0,
-        1.0, 0.0, 0.0, 0.0, 1.0  
-    };
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        valor_led = matrix_rgb(0.0, letraN[i], 0.0); // Vermelho (R=1.0)
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-    sleep_ms(2000);
-    
-    // Frame 5: LEDs formam a letra D
-    double letraD[25] = {
-        0.0, 1.0, 1.0, 1.0,10.0,
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        0.0, 1.0, 1.0, 1.0, 1.0  
-    };
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        valor_led = matrix_rgb(0.0, letraD[i], 0.0); // Vermelho (R=1.0)
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-    sleep_ms(2000);
+void microfone_bloco_callback(const uint16_t *amostras, uint num_amostras) {
+    (void)num_amostras;
+    bloco_microfone = amostras;
 }
 
-void tecla_1(uint32_t valor_led, PIO pio, uint sm) {
-    // Frame 1: LEDs formam um quadrado ao redor de um ponto.
-    double quadrado[25] = {
-        1.0, 1.0, 1.0, 1.0, 1.0,
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        1.0, 0.0, 1.0, 0.0, 1.0,
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        1.0, 1.0, 1.0, 1.0, 1.0
-    };
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        valor_led = matrix_rgb(quadrado[i], quadrado[i], quadrado[i]); // Branco (B = R = G = 1.0)
-        pio_sm_put_blocking(pio, sm, valor_led);
-    }
-    sleep_ms(2000);
-
-    // Frame 2: LEDs formam um X
-    double X[25] = {
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        0.0, 1.0, 0.0, 1.0, 0.0,
-        0.0, 0.0, 1.0, 0.0, 0.0,
-        0.0, 1.0, 0.0, 1.0, 0.0,
-        1.0, 0.0, 0.0, 0.0, 1.0 
-    };
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        valor_led = matrix_rgb(X[i], X[i], X[i]); // Azul (B=1.0)
-        pio_sm_put_blocking(pio, sm, valor_led);
+bool timer_animacao_callback(void *contexto) {
+    (void)contexto;
+    // Enquanto chegam frames pela serial a matriz é da stream; as animações retomam depois
+    anim_suspender(stream_tick());
+    anim_tick();
+    return true; // Mantém o timer ativo
+}
+
+void energia_modo(bool economia) {
+    // Em economia o tick só precisa entregar o primeiro frame vindo do PC (a serial é lida pelo
+    // laço principal, acordado pelo USB); ao sair, o tick é reiniciado e o pedido de animação que
+    // causou a saída não espera o período longo. Uma imagem mantida pelo pontilhado continua no
+    // tick normal: a 50 ms a alternância dos níveis cintilaria
+#if !PIO_MATRIX_DUAL_CORE
+    hal_timer_periodo(&timer_animacao, economia && !anim_mantendo() ? ENERGIA_TICK_ECONOMIA_MS : ANIM_TICK_MS);
+#else
+    (void)economia;
+#endif
+}
+
+void selecionar_efeito(char key) {
+    int i = key - TECLA_PRIMEIRO_EFEITO;
+
+    parar_visualizador();
+    anim_tocar(&seq_efeitos[i], ANIM_SUBSTITUIR);
+    printf("Efeito: %s.\n", efeito_nome((efeito_tipo_t)i));
+}
+
+void executar_acorde(char key) {
+    TRACE(TRACE_COMANDO, key);
+    if (key >= '1' && key <= '9') {
+        // Só os frames calculados na hora seguem o brilho; os pré-codificados mantêm o padrão
+        uint8_t brilho = (uint8_t)((key - '0') * 255 / 9);
+        cor_set_brilho(brilho);
+        printf("Brilho: %u/255.\n", brilho);
+        return;
     }
-    sleep_ms(2000);
-
-    // Frame 3: LEDs formam uma carinha
-    double carinha[25] = {
-        0.0, 1.0, 1.0, 1.0, 0.0, 
-        1.0, 0.0, 0.0, 0.0, 1.0, 
-        0.0, 1.0, 0.0, 1.0, 0.0, 
-        0.0, 1.0, 0.0, 1.0, 0.0, 
-        0.0, 0.0, 0.0, 0.0, 0.0  
-    };
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        valor_led = matrix_rgb(0.0, carinha[i], 0.0); // Vermelho (R=1.0)
-        pio_sm_put_blocking(pio, sm, valor_led);
+    printf("Acorde %c + %c: sem comando registrado.\n", TECLA_ACORDE, key);
+}
+
+void tecla_asterisco(char key) {
+    (void)key;
+    espectro_init(&espectro_tecla_asterisco, ESPECTRO_TAXA_HZ, ANIM_TICK_MS);
+    bloco_microfone = NULL;
+    if (!hal_adc_iniciar(MIC_ADC_CANAL, ESPECTRO_TAXA_HZ, amostras_microfone[0], amostras_microfone[1], ESPECTRO_N,
+                         microfone_bloco_callback)) {
+        printf("Microfone indisponível no canal %d do ADC.\n", MIC_ADC_CANAL);
+        return;
     }
-    sleep_ms(2000);
-
-    // Frame 4: LEDs formam a letra G
-    double letraG[25] = {
-        1.0, 1.0, 1.0, 1.0, 1.0,
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        1.0, 1.0, 1.0, 0.0, 1.0,
-        1.0, 0.0, 0.0, 0.0, 0.0,
-        1.0, 1.0, 1.0, 1.0, 1.0  
-    };
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        valor_led = matrix_rgb(0.0, 0.0, letraG[i]); // Verde (G=1.0)
-        pio_sm_put_blocking(pio, sm, valor_led);
+    visualizador_ativo = true;
+    anim_tocar(&seq_tecla_asterisco, ANIM_SUBSTITUIR);
+    printf("Visualizador de espectro: %d faixas, %d amostras a %d Hz por frame.\n", ESPECTRO_BANDAS, ESPECTRO_N,
+           ESPECTRO_TAXA_HZ);
+
+    // O pino do microfone pode ser uma linha do teclado: suas teclas ficam mudas até o visualizador parar
+    char mudas[5];
+    if (keypad_teclas_do_pino(MIC_PINO, mudas)) {
+        printf("Teclas %c, %c, %c e %c desativadas pelo microfone (GPIO %d); qualquer outra tecla encerra o "
+               "visualizador.\n", mudas[0], mudas[1], mudas[2], mudas[3], MIC_PINO);
     }
-    sleep_ms(2000);
-    
-    // Frame 5: LEDs formam a letra O
-    double letraO[25] = {
-        0.0, 1.0, 1.0, 1.0,0.0,
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        1.0, 0.0, 0.0, 0.0, 1.0,
-        0.0, 1.0, 1.0, 1.0, 0.0  
-    };
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        valor_led = matrix_rgb(0.0, 0.0, letraO[i]); // Verde (G=1.0)
-        pio_sm_put_blocking(pio, sm, valor_led);
+}
+
+void despejar_trace(char key) {
+    (void)key;
+    trace_despejar();
+}
+
+void parar_visualizador() {
+    if (!visualizador_ativo) return;
+    hal_adc_parar();
+    visualizador_ativo = false;
+    bloco_microfone = NULL;
+}
+
+void roteiro_recebido(char tecla, uint8_t evento, const uint8_t *codigo, uint32_t tamanho) {
+    if (evento > KEYPAD_REPETICAO || !comandos_instalar(tecla, (keypad_tipo_evento_t)evento, codigo, tamanho)) {
+        printf("Roteiro da tecla %c recusado (%lu bytes).\n", tecla, (unsigned long)tamanho);
+        return;
     }
-    sleep_ms(2000);
-}
\ No newline at end of file
+    if (tamanho) printf("Roteiro de %lu bytes instalado na tecla %c.\n", (unsigned long)tamanho, tecla);
+    else printf("Roteiro da tecla %c removido.\n", tecla);
+}
@@ -0,0 +1,35 @@
+#ifndef PIO_MATRIX_H
+#define PIO_MATRIX_H
+
+// Pino de saída
+#define OUT_PIN 7
+
+// Canal do ADC do microfone (visualizador de espectro): 0 a 2 correspondem aos GPIO 26 a 28
+#ifndef MIC_ADC_CANAL
+#define MIC_ADC_CANAL 2
+#endif
+// GPIO do microfone; no esquema do Wokwi é uma linha do teclado
+#define MIC_PINO (26 + MIC_ADC_CANAL)
+
+// Número de LEDs
+#define NUM_PIXELS 25
+
+// Modo de dois núcleos: o núcleo 1 renderiza e transmite os frames, o núcleo 0 trata teclado e comandos
+#ifndef PIO_MATRIX_DUAL_CORE
+#define PIO_MATRIX_DUAL_CORE 0
+#endif
+
+/**
+ * @brief Inicializa clock, stdio, tabelas de cor, animações, saída dos LEDs e teclado.
+ */
+void pio_matrix_iniciar();
+
+/**
+ * @brief Consome os eventos pendentes do teclado e executa os comandos correspondentes.
+ *
+ * Chamada continuamente pelo laço principal, que dorme em energia_ociosa entre as chamadas;
+ * não bloqueia. Teclas, animações em andamento e bytes da serial contam como atividade.
+ */
+void pio_matrix_processar_eventos();
+
+#endif
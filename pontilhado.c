@@ -0,0 +1,75 @@
+#include "pontilhado.h"
+
+#include <string.h>
+#include "cor.h"
+
+#define VALOR_MAXIMO 0xFF00u
+
+// Fases iniciais dos acumuladores: passo de 157/256 (próximo da razão áurea) espalha os pixels.
+// Os três canais de um pixel compartilham a fase, para que um cinza continue neutro a cada frame.
+#define FASE_PASSO 157u
+
+static void reiniciar_fases(pontilhado_t *p) {
+    for (uint32_t i = 0; i < p->num_pixels; i++) {
+        uint8_t fase = (uint8_t)(i * FASE_PASSO);
+        p->erro[i][0] = p->erro[i][1] = p->erro[i][2] = fase;
+    }
+}
+
+void pontilhado_init(pontilhado_t *p, uint16_t num_pixels, uint16_t periodo_ms) {
+    memset(p->alvo, 0, sizeof(p->alvo));
+    p->num_pixels = num_pixels <= PONTILHADO_MAX_PIXELS ? num_pixels : PONTILHADO_MAX_PIXELS;
+    p->periodo_ms = periodo_ms;
+    reiniciar_fases(p);
+}
+
+static inline uint16_t limitar(uint16_t v) {
+    return v > VALOR_MAXIMO ? VALOR_MAXIMO : v;
+}
+
+void pontilhado_definir(pontilhado_t *p, uint16_t pixel, uint16_t r, uint16_t g, uint16_t b) {
+    if (pixel >= p->num_pixels) return;
+    p->alvo[pixel][0] = limitar(r);
+    p->alvo[pixel][1] = limitar(g);
+    p->alvo[pixel][2] = limitar(b);
+}
+
+void pontilhado_preencher(pontilhado_t *p, uint8_t r, uint8_t g, uint8_t b) {
+    for (uint16_t i = 0; i < p->num_pixels; i++) {
+        pontilhado_definir(p, i, cor_lut16[r], cor_lut16[g], cor_lut16[b]);
+    }
+}
+
+bool pontilhado_fracionario(const pontilhado_t *p) {
+    uint8_t fracao = 0;
+
+    for (uint32_t i = 0; i < p->num_pixels; i++) {
+        fracao |= (uint8_t)(p->alvo[i][0] | p->alvo[i][1] | p->alvo[i][2]);
+    }
+    return fracao != 0;
+}
+
+void pontilhado_quadro(pontilhado_t *p, uint32_t *frame) {
+    for (uint32_t i = 0; i < p->num_pixels; i++) {
+        // Com alvo <= 0xFF00 e erro <= 0xFF a soma não passa de 0xFFFF: o nível cabe em 8 bits
+        uint32_t r = p->alvo[i][0] + p->erro[i][0];
+        uint32_t g = p->alvo[i][1] + p->erro[i][1];
+        uint32_t b = p->alvo[i][2] + p->erro[i][2];
+
+        p->erro[i][0] = (uint8_t)r;
+        p->erro[i][1] = (uint8_t)g;
+        p->erro[i][2] = (uint8_t)b;
+        frame[i] = led_palavra((uint8_t)(r >> 8), (uint8_t)(g >> 8), (uint8_t)(b >> 8), 0);
+    }
+}
+
+bool pontilhado_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms) {
+    pontilhado_t *p = contexto;
+
+    if (passo == 0) reiniciar_fases(p);
+    // Níveis inteiros: o primeiro frame já é o definitivo
+    else if (!pontilhado_fracionario(p)) return false;
+    pontilhado_quadro(p, frame);
+    *duracao_ms = p->periodo_ms;
+    return true;
+}
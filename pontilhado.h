@@ -0,0 +1,60 @@
+#ifndef PONTILHADO_H
+#define PONTILHADO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Pontilhado temporal: canais de 16 bits exibidos por LEDs de 8 bits.
+ *
+ * Cada canal guarda o valor desejado em ponto fixo 8.8 (0 a 0xFF00, já com gama e brilho) e um
+ * acumulador com a fração ainda não exibida (modulação sigma-delta de primeira ordem). A cada
+ * frame o LED recebe a parte inteira de valor + acumulador e a fração volta ao acumulador, de modo
+ * que a média ao longo dos frames reproduz o valor de 16 bits. Com a matriz renovada a cada tick
+ * (500 Hz com ANIM_TICK_MS = 2), a alternância entre níveis vizinhos não é percebida.
+ *
+ * Os acumuladores começam com fases diferentes por pixel: numa área de cor única, os pixels não
+ * trocam de nível todos no mesmo frame.
+ */
+
+// Pixels de um pontilhado_t (a matriz 5x5 com folga)
+#define PONTILHADO_MAX_PIXELS 32
+
+typedef struct {
+    uint16_t alvo[PONTILHADO_MAX_PIXELS][3];   // R, G, B em 8.8 (0 a 0xFF00)
+    uint8_t erro[PONTILHADO_MAX_PIXELS][3];    // Fração acumulada de cada canal
+    uint16_t num_pixels;
+    uint16_t periodo_ms;                       // Duração de cada frame quando usado como gerador
+} pontilhado_t;
+
+/**
+ * @brief Prepara um pontilhado com todos os pixels apagados.
+ *
+ * @param periodo_ms Intervalo entre frames (normalmente o tick das animações).
+ */
+void pontilhado_init(pontilhado_t *p, uint16_t num_pixels, uint16_t periodo_ms);
+
+// Indica se algum canal precisa de pontilhado (alvo com fração de nível)
+bool pontilhado_fracionario(const pontilhado_t *p);
+
+// Define um pixel com canais já em 8.8 linear (valores acima de 0xFF00 são limitados)
+void pontilhado_definir(pontilhado_t *p, uint16_t pixel, uint16_t r, uint16_t g, uint16_t b);
+
+// Preenche todos os pixels com uma cor de 8 bits por canal, convertida por cor_lut16 (gama e brilho)
+void pontilhado_preencher(pontilhado_t *p, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Gera o próximo frame GRB e guarda a fração não exibida de cada canal.
+ */
+void pontilhado_quadro(pontilhado_t *p, uint32_t *frame);
+
+/**
+ * @brief Gerador de animação (anim_gerador_t): um frame pontilhado a cada periodo_ms.
+ *
+ * Enquanto algum canal tiver fração (alvo fora de um nível inteiro), a sequência não termina e
+ * renova a matriz até ser substituída. Sem fração, todos os frames seriam iguais: a sequência
+ * entrega um frame e termina, deixando-o aceso sem ocupar o escalonador nem o DMA.
+ */
+bool pontilhado_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms);
+
+#endif
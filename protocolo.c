@@ -0,0 +1,194 @@
+#include "protocolo.h"
+
+#include <string.h>
+
+typedef enum {
+    ESPERA_SINC1,
+    ESPERA_SINC2,
+    CABECALHO,
+    DADOS,
+    CRC
+} estado_t;
+
+static proto_frame_t callback_atual;
+static proto_roteiro_t callback_roteiro = NULL;
+static uint32_t pixels_frame;
+static proto_estatisticas_t estatisticas_atuais;
+
+// Frame montado a partir dos pacotes aceitos; pacotes parciais alteram só a sua faixa
+static uint8_t frame_rgb[PROTO_MAX_PIXELS * 3];
+
+// Pacote em recepção: só é aplicado ao frame depois de conferido o CRC
+static estado_t estado;
+static uint8_t cabecalho[PROTO_CABECALHO - 2];
+static uint8_t dados_pacote[PROTO_MAX_PIXELS * 3];
+static uint32_t recebidos;
+static uint32_t tamanho_dados;
+static uint16_t crc_calculado;
+static uint16_t crc_recebido;
+static uint8_t seq_esperada;
+static bool primeira_seq;
+
+// CRC-16/CCITT por tabela de 16 entradas (meio byte por consulta): compacto e sem laço por bit
+static const uint16_t crc_tabela[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+uint16_t proto_crc16(uint16_t crc, const uint8_t *dados, uint32_t tamanho) {
+    for (uint32_t i = 0; i < tamanho; i++) {
+        crc = (uint16_t)((crc << 4) ^ crc_tabela[(crc >> 12) ^ (dados[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ crc_tabela[(crc >> 12) ^ (dados[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+void proto_init(uint32_t num_pixels, proto_frame_t callback) {
+    callback_atual = callback;
+    pixels_frame = num_pixels <= PROTO_MAX_PIXELS ? num_pixels : PROTO_MAX_PIXELS;
+    memset(frame_rgb, 0, sizeof(frame_rgb));
+    memset(&estatisticas_atuais, 0, sizeof(estatisticas_atuais));
+    estado = ESPERA_SINC1;
+    primeira_seq = true;
+}
+
+static uint16_t ler16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// Valida o cabeçalho completo; devolve false para voltar a procurar o sincronismo
+static bool iniciar_dados(void) {
+    uint8_t tipo = cabecalho[0] & (uint8_t)~PROTO_APRESENTAR;
+    uint32_t inicio = ler16(&cabecalho[2]), quantidade = ler16(&cabecalho[4]);
+
+    if (tipo == PROTO_TIPO_ROTEIRO) {
+        if (quantidade > sizeof(dados_pacote)) {
+            estatisticas_atuais.erros_formato++;
+            return false;
+        }
+        tamanho_dados = quantidade;
+    } else if (tipo != PROTO_TIPO_PIXELS || inicio + quantidade > pixels_frame) {
+        estatisticas_atuais.erros_formato++;
+        return false;
+    } else {
+        tamanho_dados = quantidade * 3;
+    }
+    recebidos = 0;
+    crc_calculado = proto_crc16(0xFFFF, cabecalho, sizeof(cabecalho));
+    estado = tamanho_dados ? DADOS : CRC;
+    return true;
+}
+
+static void aplicar_pacote(void) {
+    uint8_t seq = cabecalho[1];
+    uint32_t inicio = ler16(&cabecalho[2]);
+
+    if (!primeira_seq) estatisticas_atuais.perdidos += (uint8_t)(seq - seq_esperada);
+    primeira_seq = false;
+    seq_esperada = (uint8_t)(seq + 1);
+    estatisticas_atuais.pacotes++;
+
+    if ((cabecalho[0] & (uint8_t)~PROTO_APRESENTAR) == PROTO_TIPO_ROTEIRO) {
+        if (callback_roteiro) callback_roteiro((char)cabecalho[2], cabecalho[3], dados_pacote, tamanho_dados);
+        return;
+    }
+    memcpy(&frame_rgb[inicio * 3], dados_pacote, tamanho_dados);
+    if (cabecalho[0] & PROTO_APRESENTAR) {
+        estatisticas_atuais.frames++;
+        if (callback_atual) callback_atual(frame_rgb, pixels_frame, seq);
+    }
+}
+
+void proto_roteiros(proto_roteiro_t callback) {
+    callback_roteiro = callback;
+}
+
+void proto_alimentar(const uint8_t *dados, uint32_t tamanho) {
+    uint32_t i = 0;
+
+    while (i < tamanho) {
+        switch (estado) {
+        case ESPERA_SINC1:
+            if (dados[i++] == PROTO_SINC1) estado = ESPERA_SINC2;
+            else estatisticas_atuais.bytes_ignorados++;
+            break;
+
+        case ESPERA_SINC2:
+            if (dados[i] == PROTO_SINC2) {
+                i++;
+                recebidos = 0;
+                estado = CABECALHO;
+            } else {
+                // Não consome o byte: ele pode ser o início de um novo sincronismo
+                estatisticas_atuais.bytes_ignorados++;
+                estado = ESPERA_SINC1;
+            }
+            break;
+
+        case CABECALHO:
+            cabecalho[recebidos++] = dados[i++];
+            if (recebidos == sizeof(cabecalho) && !iniciar_dados()) estado = ESPERA_SINC1;
+            break;
+
+        case DADOS: {
+            // Copia de uma vez tudo o que já chegou deste pacote
+            uint32_t bloco = tamanho - i;
+            if (bloco > tamanho_dados - recebidos) bloco = tamanho_dados - recebidos;
+            memcpy(&dados_pacote[recebidos], &dados[i], bloco);
+            crc_calculado = proto_crc16(crc_calculado, &dados[i], bloco);
+            recebidos += bloco;
+            i += bloco;
+            if (recebidos == tamanho_dados) {
+                recebidos = 0;
+                estado = CRC;
+            }
+            break;
+        }
+
+        case CRC:
+            if (recebidos++ == 0) {
+                crc_recebido = dados[i++];
+                break;
+            }
+            crc_recebido |= (uint16_t)(dados[i++] << 8);
+            if (crc_recebido == crc_calculado) aplicar_pacote();
+            else estatisticas_atuais.erros_crc++;
+            estado = ESPERA_SINC1;
+            break;
+        }
+    }
+}
+
+void proto_obter_estatisticas(proto_estatisticas_t *estatisticas) {
+    *estatisticas = estatisticas_atuais;
+}
+
+static uint32_t montar(uint8_t *destino, uint8_t tipo, uint8_t seq, uint16_t inicio, uint16_t quantidade,
+                       const uint8_t *dados, uint32_t tamanho) {
+    uint32_t n = 0;
+
+    destino[n++] = PROTO_SINC1;
+    destino[n++] = PROTO_SINC2;
+    destino[n++] = tipo;
+    destino[n++] = seq;
+    destino[n++] = (uint8_t)inicio;
+    destino[n++] = (uint8_t)(inicio >> 8);
+    destino[n++] = (uint8_t)quantidade;
+    destino[n++] = (uint8_t)(quantidade >> 8);
+    memcpy(&destino[n], dados, tamanho);
+    n += tamanho;
+
+    uint16_t crc = proto_crc16(0xFFFF, &destino[2], n - 2);
+    destino[n++] = (uint8_t)crc;
+    destino[n++] = (uint8_t)(crc >> 8);
+    return n;
+}
+
+uint32_t proto_codificar(uint8_t *destino, uint8_t seq, bool apresentar, uint16_t inicio, uint16_t quantidade, const uint8_t *rgb) {
+    return montar(destino, PROTO_TIPO_PIXELS | (apresentar ? PROTO_APRESENTAR : 0), seq, inicio, quantidade, rgb,
+                  quantidade * 3u);
+}
+
+uint32_t proto_codificar_roteiro(uint8_t *destino, uint8_t seq, char tecla, uint8_t evento, const uint8_t *codigo, uint16_t tamanho) {
+    return montar(destino, PROTO_TIPO_ROTEIRO, seq, (uint16_t)((uint8_t)tecla | (evento << 8)), tamanho, codigo, tamanho);
+}
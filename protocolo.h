@@ -0,0 +1,88 @@
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Protocolo binário de envio de frames pela serial USB (CDC).
+ *
+ * Pacote (inteiros de 16 bits em little-endian):
+ *   0xA5 0x5A        sincronismo
+ *   tipo             bits 0-6: PROTO_TIPO_PIXELS; bit 7 (PROTO_APRESENTAR): exibe o frame após aplicar
+ *   seq              número de sequência, incrementado a cada pacote (gaps contam como perdidos)
+ *   inicio           índice do primeiro pixel, na ordem lógica (linha a linha a partir do canto
+ *                    superior esquerdo); o firmware remapeia para a fiação (layout.h)
+ *   quantidade       número de pixels no pacote
+ *   dados            quantidade * 3 bytes R, G, B
+ *   crc              CRC-16/CCITT (0x1021, início 0xFFFF) de tipo até o fim dos dados
+ *
+ * Um frame completo é um pacote com inicio 0, todos os pixels e PROTO_APRESENTAR; frames
+ * parciais atualizam só uma faixa de pixels sobre o último conteúdo recebido.
+ *
+ * Um pacote PROTO_TIPO_ROTEIRO leva um roteiro de animação (roteiro.h) em vez de pixels: inicio
+ * tem a tecla no byte baixo e o tipo de evento (keypad_tipo_evento_t) no alto, quantidade é o
+ * tamanho do programa em bytes e dados são os bytes do programa. PROTO_APRESENTAR é ignorado.
+ * O analisador não depende do hardware e é compilado também no host.
+ */
+
+#define PROTO_SINC1 0xA5
+#define PROTO_SINC2 0x5A
+#define PROTO_TIPO_PIXELS 0x01
+#define PROTO_TIPO_ROTEIRO 0x02
+#define PROTO_APRESENTAR 0x80
+
+#define PROTO_CABECALHO 8   // sincronismo, tipo, seq, inicio, quantidade
+#define PROTO_MAX_PIXELS 256
+
+// Tamanho de um pacote com a quantidade de pixels indicada
+#define PROTO_TAMANHO_PACOTE(pixels) (PROTO_CABECALHO + 3 * (pixels) + 2)
+
+// Chamada quando um pacote com PROTO_APRESENTAR é aceito; rgb aponta para num_pixels * 3 bytes
+typedef void (*proto_frame_t)(const uint8_t *rgb, uint32_t num_pixels, uint8_t seq);
+
+// Chamada quando um pacote PROTO_TIPO_ROTEIRO é aceito; codigo vale só durante a chamada
+typedef void (*proto_roteiro_t)(char tecla, uint8_t evento, const uint8_t *codigo, uint32_t tamanho);
+
+typedef struct {
+    uint32_t pacotes;        // Pacotes aceitos
+    uint32_t frames;         // Frames entregues ao callback
+    uint32_t erros_crc;      // Pacotes descartados por CRC
+    uint32_t erros_formato;  // Cabeçalhos inválidos (tipo ou faixa de pixels)
+    uint32_t perdidos;       // Pacotes que faltaram na sequência
+    uint32_t bytes_ignorados;// Bytes descartados procurando o sincronismo
+} proto_estatisticas_t;
+
+/**
+ * @brief Prepara o analisador para frames de num_pixels pixels (até PROTO_MAX_PIXELS).
+ */
+void proto_init(uint32_t num_pixels, proto_frame_t callback);
+
+// Registra quem recebe os roteiros (NULL: os pacotes de roteiro são aceitos e ignorados)
+void proto_roteiros(proto_roteiro_t callback);
+
+// Processa bytes recebidos, em qualquer fragmentação; pode chamar o callback várias vezes
+void proto_alimentar(const uint8_t *dados, uint32_t tamanho);
+
+void proto_obter_estatisticas(proto_estatisticas_t *estatisticas);
+
+// CRC-16/CCITT usado nos pacotes, continuando a partir de crc (0xFFFF no início)
+uint16_t proto_crc16(uint16_t crc, const uint8_t *dados, uint32_t tamanho);
+
+/**
+ * @brief Monta um pacote (usado pelo lado do PC e pelos testes de host).
+ *
+ * @param destino Área com PROTO_TAMANHO_PACOTE(quantidade) bytes.
+ * @return Tamanho do pacote em bytes.
+ */
+uint32_t proto_codificar(uint8_t *destino, uint8_t seq, bool apresentar, uint16_t inicio, uint16_t quantidade, const uint8_t *rgb);
+
+/**
+ * @brief Monta um pacote de roteiro.
+ *
+ * @param destino Área com PROTO_CABECALHO + tamanho + 2 bytes.
+ * @return Tamanho do pacote em bytes.
+ */
+uint32_t proto_codificar_roteiro(uint8_t *destino, uint8_t seq, char tecla, uint8_t evento, const uint8_t *codigo, uint16_t tamanho);
+
+#endif
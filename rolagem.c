@@ -0,0 +1,65 @@
+#include "rolagem.h"
+
+#include <string.h>
+#include "cor.h"
+#include "fonte.h"
+
+// Bit da coluna da direita de cada linha de um glifo (pixel (l, 4) = bit 20 - 5 * l)
+#define COLUNA_DIREITA 0x0108421u
+#define GLIFO_COMPLETO ((1u << FONTE_PIXELS) - 1)
+
+void rolagem_configurar(rolagem_t *r, const char *texto, const uint8_t aceso[3], const uint8_t apagado[3], uint16_t periodo_ms) {
+    r->texto = texto;
+    memcpy(r->aceso, aceso, 3);
+    memcpy(r->apagado, apagado, 3);
+    r->periodo_ms = periodo_ms;
+    r->caractere = texto;
+    r->janela = 0;
+}
+
+static void reiniciar(rolagem_t *r) {
+    r->janela = 0;
+    r->caractere = r->texto;
+    r->coluna = 0;
+    // Depois da última coluna do texto (e seu espaço), a tela ainda precisa rolar até ficar vazia
+    r->finais = FONTE_LARGURA - ROLAGEM_ESPACO;
+    r->cor_acesa = cor_grb(r->aceso[0], r->aceso[1], r->aceso[2]);
+    r->cor_apagada = cor_grb(r->apagado[0], r->apagado[1], r->apagado[2]);
+}
+
+// Próxima coluna da faixa, já posicionada na coluna da direita; false ao fim da faixa
+static bool proxima_coluna(rolagem_t *r, uint32_t *coluna) {
+    if (*r->caractere != '\0') {
+        // Coluna c do glifo deslocada para a direita: pixel (l, c) vai para o bit 20 - 5 * l
+        *coluna = r->coluna < FONTE_LARGURA ? (fonte_glifo(*r->caractere) >> (FONTE_LARGURA - 1 - r->coluna)) & COLUNA_DIREITA : 0;
+        if (++r->coluna == FONTE_LARGURA + ROLAGEM_ESPACO) {
+            r->coluna = 0;
+            r->caractere++;
+        }
+        return true;
+    }
+    if (r->finais == 0 || r->caractere == r->texto) return false;
+    r->finais--;
+    *coluna = 0;
+    return true;
+}
+
+bool rolagem_avancar(rolagem_t *r, uint32_t passo) {
+    uint32_t coluna;
+
+    if (passo == 0) reiniciar(r);
+    if (!proxima_coluna(r, &coluna)) return false;
+
+    // Todas as linhas andam uma coluna para a esquerda; a coluna da esquerda sai da tela
+    r->janela = ((r->janela << 1) & GLIFO_COMPLETO & ~COLUNA_DIREITA) | coluna;
+    return true;
+}
+
+bool rolagem_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms) {
+    rolagem_t *r = contexto;
+
+    if (!rolagem_avancar(r, passo)) return false;
+    fonte_desenhar(r->janela, r->cor_acesa, r->cor_apagada, frame);
+    *duracao_ms = r->periodo_ms;
+    return true;
+}
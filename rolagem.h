@@ -0,0 +1,61 @@
+#ifndef ROLAGEM_H
+#define ROLAGEM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Texto rolando da direita para a esquerda na matriz 5x5.
+ *
+ * Os glifos da fonte ficam lado a lado numa faixa virtual, separados por uma coluna vazia.
+ * A cada passo a janela visível (um glifo de 25 bits) desloca uma coluna e recebe a próxima
+ * coluna da faixa: o custo por passo é constante, qualquer que seja o tamanho do texto.
+ * O texto entra pela direita e sai completamente pela esquerda.
+ */
+
+// Colunas vazias entre dois caracteres
+#define ROLAGEM_ESPACO 1
+
+typedef struct {
+    // Configuração: não deve mudar enquanto a sequência estiver tocando
+    const char *texto;
+    uint8_t aceso[3];       // R, G, B dos pixels acesos
+    uint8_t apagado[3];     // R, G, B do fundo
+    uint16_t periodo_ms;    // Tempo de cada deslocamento de coluna
+
+    // Estado da rolagem, reiniciado no passo 0
+    uint32_t janela;        // Conteúdo visível, no formato dos glifos de fonte.h
+    const char *caractere;  // Caractere de onde sai a próxima coluna
+    uint8_t coluna;         // Próxima coluna do caractere (as últimas ROLAGEM_ESPACO são vazias)
+    uint8_t finais;         // Colunas vazias que ainda faltam para o texto sair da tela
+    uint32_t cor_acesa, cor_apagada;
+} rolagem_t;
+
+/**
+ * @brief Define o texto, as cores e a velocidade de uma rolagem.
+ *
+ * @param texto Cadeia terminada em zero, mantida pelo chamador enquanto a rolagem existir.
+ * @param periodo_ms Tempo de cada coluna (ex.: 100 ms = 10 colunas por segundo).
+ */
+void rolagem_configurar(rolagem_t *r, const char *texto, const uint8_t aceso[3], const uint8_t apagado[3], uint16_t periodo_ms);
+
+/**
+ * @brief Desloca a janela uma coluna, sem desenhar (para quem compõe o texto em camadas).
+ *
+ * @param passo 0 recomeça a rolagem com a tela vazia.
+ * @return false quando o texto já saiu da tela.
+ */
+bool rolagem_avancar(rolagem_t *r, uint32_t passo);
+
+/**
+ * @brief Gera o frame do próximo deslocamento (compatível com anim_gerador_t).
+ *
+ * No passo 0 a rolagem recomeça com a tela vazia e as cores são codificadas com o brilho vigente.
+ *
+ * @param contexto rolagem_t configurado.
+ * @param frame Destino com FONTE_PIXELS palavras GRB.
+ * @return false quando o texto já saiu da tela.
+ */
+bool rolagem_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms);
+
+#endif
@@ -0,0 +1,153 @@
+#include "roteiro.h"
+
+#include <string.h>
+#include "cor.h"
+#include "fonte.h"
+
+// Imagem de trabalho em ordem lógica, antes do nível e da gama
+static uint8_t imagem[LAYOUT_MAX_PIXELS][3];
+
+// Bytes de operandos de cada instrução
+static const uint8_t operandos[ROT_NUM_OPS] = {
+    [ROT_OP_FIM] = 0,      [ROT_OP_COR] = 3,      [ROT_OP_PREENCHER] = 0,
+    [ROT_OP_GLIFO] = 1,    [ROT_OP_NIVEL] = 1,    [ROT_OP_ESMAECER] = 3,
+    [ROT_OP_ESPERAR] = 2,  [ROT_OP_REPETIR] = 1,  [ROT_OP_VOLTAR] = 0,
+};
+
+void roteiro_init(roteiro_t *r, const uint8_t *codigo, uint16_t tamanho) {
+    r->codigo = codigo;
+    r->tamanho = tamanho;
+}
+
+bool roteiro_validar(const uint8_t *codigo, uint32_t tamanho) {
+    uint32_t pc = 0, lacos = 0;
+
+    if (tamanho > ROTEIRO_MAX_BYTES) return false;
+    while (pc < tamanho) {
+        uint8_t op = codigo[pc++];
+        if (op >= ROT_NUM_OPS || pc + operandos[op] > tamanho) return false;
+        if (op == ROT_OP_REPETIR && ++lacos > ROTEIRO_MAX_LACOS) return false;
+        if (op == ROT_OP_VOLTAR && lacos-- == 0) return false;
+        pc += operandos[op];
+    }
+    return lacos == 0;
+}
+
+static void reiniciar(roteiro_t *r) {
+    r->pc = 0;
+    memset(r->cor, 0, sizeof(r->cor));
+    r->nivel_q8 = 255u << 8;
+    r->esmaecer_restantes = 0;
+    r->num_lacos = 0;
+    r->instrucoes = 0;
+    memset(imagem, 0, sizeof(imagem));
+}
+
+static void codificar(const roteiro_t *r, uint32_t *frame) {
+    uint32_t escala = (r->nivel_q8 >> 8) + 1u;
+
+    for (uint32_t i = 0; i < layout_matriz.num_pixels; i++) {
+        frame[layout_matriz.fisico[i]] = cor_grb((uint8_t)((imagem[i][0] * escala) >> 8),
+                                                 (uint8_t)((imagem[i][1] * escala) >> 8),
+                                                 (uint8_t)((imagem[i][2] * escala) >> 8));
+    }
+}
+
+static void glifo(const roteiro_t *r, char c) {
+    uint32_t g = fonte_glifo(c);
+    int bit = FONTE_PIXELS - 1;
+
+    for (uint32_t l = 0; l < FONTE_ALTURA && l < layout_matriz.altura; l++) {
+        for (uint32_t col = 0; col < FONTE_LARGURA; col++, bit--) {
+            if (col >= layout_matriz.largura) continue;
+            uint8_t *p = imagem[l * layout_matriz.largura + col];
+            if ((g >> bit) & 1u) memcpy(p, r->cor, 3);
+            else memset(p, 0, 3);
+        }
+    }
+}
+
+// Um frame do esmaecimento em curso; o último cai exatamente no alvo
+static void esmaecer_passo(roteiro_t *r, uint32_t *frame, uint32_t *duracao_ms) {
+    if (--r->esmaecer_restantes == 0) r->nivel_q8 = (uint16_t)(r->esmaecer_alvo << 8);
+    else r->nivel_q8 = (uint16_t)(r->nivel_q8 + r->esmaecer_delta_q8);
+    codificar(r, frame);
+    *duracao_ms = r->esmaecer_ms;
+}
+
+bool roteiro_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms) {
+    roteiro_t *r = contexto;
+    const uint8_t *cod = r->codigo;
+
+    if (passo == 0) reiniciar(r);
+    if (r->esmaecer_restantes) {
+        esmaecer_passo(r, frame, duracao_ms);
+        return true;
+    }
+
+    for (uint32_t n = 0; n < ROTEIRO_MAX_INSTRUCOES; n++) {
+        if (r->pc >= r->tamanho) return false;
+        uint8_t op = cod[r->pc];
+        if (op >= ROT_NUM_OPS || r->pc + 1u + operandos[op] > r->tamanho) return false;
+        const uint8_t *arg = &cod[r->pc + 1];
+        r->pc = (uint16_t)(r->pc + 1u + operandos[op]);
+        r->instrucoes++;
+
+        switch (op) {
+            case ROT_OP_FIM:
+                return false;
+
+            case ROT_OP_COR:
+                memcpy(r->cor, arg, 3);
+                break;
+
+            case ROT_OP_PREENCHER:
+                for (uint32_t i = 0; i < layout_matriz.num_pixels; i++) memcpy(imagem[i], r->cor, 3);
+                break;
+
+            case ROT_OP_GLIFO:
+                glifo(r, (char)arg[0]);
+                break;
+
+            case ROT_OP_NIVEL:
+                r->nivel_q8 = (uint16_t)(arg[0] << 8);
+                break;
+
+            case ROT_OP_ESMAECER:
+                if (arg[1] == 0) {
+                    r->nivel_q8 = (uint16_t)(arg[0] << 8);
+                    break;
+                }
+                // Uma divisão por instrução; os frames só somam o passo
+                r->esmaecer_alvo = arg[0];
+                r->esmaecer_restantes = arg[1];
+                r->esmaecer_ms = arg[2];
+                r->esmaecer_delta_q8 = (int16_t)(((int32_t)(arg[0] << 8) - r->nivel_q8) / arg[1]);
+                esmaecer_passo(r, frame, duracao_ms);
+                return true;
+
+            case ROT_OP_ESPERAR:
+                codificar(r, frame);
+                *duracao_ms = (uint32_t)(arg[0] | (arg[1] << 8));
+                return true;
+
+            case ROT_OP_REPETIR:
+                if (r->num_lacos == ROTEIRO_MAX_LACOS) return false;
+                r->lacos[r->num_lacos].inicio = r->pc;
+                r->lacos[r->num_lacos].restantes = arg[0];
+                r->num_lacos++;
+                break;
+
+            case ROT_OP_VOLTAR: {
+                if (r->num_lacos == 0) return false;
+                // restantes 0 repete sempre; senão conta a volta que acabou e sai na última
+                uint8_t *restantes = &r->lacos[r->num_lacos - 1].restantes;
+                if (*restantes == 0 || --*restantes > 0) r->pc = r->lacos[r->num_lacos - 1].inicio;
+                else r->num_lacos--;
+                break;
+            }
+        }
+    }
+    // Laço sem ROT_ESPERAR nem ROT_ESMAECER: nunca entregaria um frame
+    return false;
+}
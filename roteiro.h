@@ -0,0 +1,112 @@
+#ifndef ROTEIRO_H
+#define ROTEIRO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "layout.h"
+
+/**
+ * @brief Roteiros de animação: programas em bytecode executados por um interpretador que é um
+ * gerador de animacao.h.
+ *
+ * O roteiro desenha numa imagem lógica de 8 bits por canal (layout_matriz) e só entrega um frame
+ * em ROT_ESPERAR e em cada passo de ROT_ESMAECER, quando a imagem é codificada com o nível de
+ * intensidade atual (cor_grb e a tabela do layout). As demais instruções executam em sequência
+ * no mesmo passo. Os operandos vêm logo após o código da instrução; inteiros de 16 bits em
+ * little-endian:
+ *
+ *   ROT_FIM                        termina; o último frame entregue permanece aceso
+ *   ROT_COR r g b                  cor das instruções de desenho seguintes
+ *   ROT_PREENCHER                  toda a imagem na cor atual
+ *   ROT_GLIFO c                    glifo de fonte.h no canto superior esquerdo: acesos na cor
+ *                                  atual, os demais pixels do glifo apagados
+ *   ROT_NIVEL n                    intensidade da saída (255 = a imagem como desenhada)
+ *   ROT_ESMAECER alvo passos ms    leva o nível até alvo em passos frames de ms cada
+ *   ROT_ESPERAR ms                 entrega a imagem e a mantém por ms (0: só a mostra)
+ *   ROT_REPETIR n                  repete n vezes (0: sempre) as instruções até o ROT_VOLTAR
+ *   ROT_VOLTAR                     fim do bloco de ROT_REPETIR
+ *
+ * Como os roteiros também chegam pela serial (protocolo.h), o interpretador confere cada operando
+ * contra o tamanho do programa e termina em códigos inválidos ou laços sem frame; roteiro_validar
+ * faz as mesmas conferências antes de instalar um programa recebido.
+ */
+
+// Blocos de ROT_REPETIR aninhados
+#define ROTEIRO_MAX_LACOS 4
+
+// Instruções executadas num passo sem entregar frame antes de o roteiro ser dado como travado
+#define ROTEIRO_MAX_INSTRUCOES 1024
+
+// Maior programa aceito por roteiro_validar
+#define ROTEIRO_MAX_BYTES 256
+
+typedef enum {
+    ROT_OP_FIM,
+    ROT_OP_COR,
+    ROT_OP_PREENCHER,
+    ROT_OP_GLIFO,
+    ROT_OP_NIVEL,
+    ROT_OP_ESMAECER,
+    ROT_OP_ESPERAR,
+    ROT_OP_REPETIR,
+    ROT_OP_VOLTAR,
+    ROT_NUM_OPS
+} roteiro_op_t;
+
+// Montagem dos programas em listas de bytes: const uint8_t prog[] = {ROT_COR(0, 0, 255), ROT_PREENCHER, ...}
+#define ROT_FIM ROT_OP_FIM
+#define ROT_COR(r, g, b) ROT_OP_COR, (r), (g), (b)
+#define ROT_PREENCHER ROT_OP_PREENCHER
+#define ROT_GLIFO(c) ROT_OP_GLIFO, (c)
+#define ROT_NIVEL(n) ROT_OP_NIVEL, (n)
+#define ROT_ESMAECER(alvo, passos, ms) ROT_OP_ESMAECER, (alvo), (passos), (ms)
+#define ROT_ESPERAR(ms) ROT_OP_ESPERAR, (uint8_t)((ms) & 0xFFu), (uint8_t)((ms) >> 8)
+#define ROT_REPETIR(n) ROT_OP_REPETIR, (n)
+#define ROT_VOLTAR ROT_OP_VOLTAR
+
+typedef struct {
+    const uint8_t *codigo;
+    uint16_t tamanho;
+
+    // Estado, reiniciado no passo 0
+    uint16_t pc;
+    uint8_t cor[3];
+    uint16_t nivel_q8;               // Nível com 8 bits de fração, para o esmaecimento em passos iguais
+    int16_t esmaecer_delta_q8;       // Variação do nível por frame
+    uint8_t esmaecer_restantes;      // Frames que faltam do ROT_ESMAECER em curso
+    uint8_t esmaecer_alvo;
+    uint8_t esmaecer_ms;
+    uint8_t num_lacos;
+    struct {
+        uint16_t inicio;             // Primeira instrução do bloco
+        uint8_t restantes;           // Repetições que faltam (0: sem fim)
+    } lacos[ROTEIRO_MAX_LACOS];
+
+    uint32_t instrucoes;             // Instruções executadas desde o passo 0
+} roteiro_t;
+
+// Inicializador de um roteiro em flash: roteiro_t r = ROTEIRO(programa);
+#define ROTEIRO(programa) {.codigo = (programa), .tamanho = sizeof(programa)}
+
+/**
+ * @brief Associa um programa a um roteiro; o estado começa do zero a cada reprodução.
+ */
+void roteiro_init(roteiro_t *r, const uint8_t *codigo, uint16_t tamanho);
+
+/**
+ * @brief Confere um programa: códigos conhecidos, operandos completos, blocos de ROT_REPETIR
+ * fechados e aninhados até ROTEIRO_MAX_LACOS, e tamanho até ROTEIRO_MAX_BYTES.
+ */
+bool roteiro_validar(const uint8_t *codigo, uint32_t tamanho);
+
+/**
+ * @brief Gerador de animação (anim_gerador_t): executa o roteiro até o próximo frame.
+ *
+ * A imagem de trabalho é compartilhada entre os roteiros, pois só um é reproduzido por vez.
+ *
+ * @return false em ROT_FIM, no fim do programa ou num erro.
+ */
+bool roteiro_gerar(void *contexto, uint32_t passo, uint32_t *frame, uint32_t *duracao_ms);
+
+#endif
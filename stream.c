@@ -0,0 +1,123 @@
+#include "stream.h"
+
+#include <stddef.h>
+
+#include "cor.h"
+#include "fila_spsc.h"
+#include "hal.h"
+#include "layout.h"
+#include "trace.h"
+
+// Quantos bytes são movidos por leitura da serial ou da fila
+#define STREAM_BLOCO 64
+
+static stream_politica_t politica_atual;
+static stream_saida_t saida_atual;
+static stream_estatisticas_t estatisticas_atuais;
+
+// Recepção: bytes lidos da serial que aguardam o analisador
+static uint8_t fila_buffer[STREAM_FILA_BYTES];
+static fila_spsc_t fila_recepcao;
+
+/**
+ * Buffer triplo entre stream_processar (escreve) e stream_tick (lê): cada lado tem seu buffer e
+ * o do meio é trocado atomicamente. O bit NOVO indica que o buffer do meio ainda não foi lido.
+ */
+#define NOVO 0x4
+static uint32_t quadros[3][PROTO_MAX_PIXELS];
+static uint8_t escrita = 0;
+static uint8_t leitura = 1;
+static uint8_t meio = 2;
+static bool pendente = false;
+
+// Posse da matriz: instante do último frame novo, lido apenas por stream_tick
+static bool recebendo = false;
+static uint32_t ultimo_frame_ms = 0;
+
+// Move o que chegou pela serial para a fila; com a fila cheia, aplica a política escolhida
+static void ler_serial(void) {
+    uint8_t bloco[STREAM_BLOCO];
+
+    for (;;) {
+        uint32_t maximo = STREAM_BLOCO;
+        if (politica_atual == STREAM_SEGURAR) {
+            uint32_t livres = STREAM_FILA_BYTES - fila_spsc_ocupacao(&fila_recepcao);
+            if (livres == 0) break;
+            if (maximo > livres) maximo = livres;
+        }
+
+        int lidos = hal_serial_ler(bloco, maximo);
+        if (lidos <= 0) break;
+
+        uint32_t inseridos = fila_spsc_inserir_varios(&fila_recepcao, bloco, (uint32_t)lidos);
+        estatisticas_atuais.bytes_recebidos += (uint32_t)lidos;
+        estatisticas_atuais.bytes_descartados += (uint32_t)lidos - inseridos;
+    }
+}
+
+// Callback do analisador: codifica o frame e o publica no buffer do meio
+static void frame_recebido(const uint8_t *rgb, uint32_t num_pixels, uint8_t seq) {
+    uint32_t *destino = quadros[escrita];
+
+    // Os pixels chegam na ordem lógica; o remapeamento é a própria escrita no destino
+    TRACE(TRACE_CODIFICANDO, seq);
+    for (uint32_t i = 0; i < num_pixels; i++, rgb += 3) {
+        destino[layout_matriz.fisico[i]] = cor_grb(rgb[0], rgb[1], rgb[2]);
+    }
+    TRACE(TRACE_CODIFICADO, seq);
+
+    uint8_t anterior = __atomic_exchange_n(&meio, (uint8_t)(escrita | NOVO), __ATOMIC_ACQ_REL);
+    if (anterior & NOVO) estatisticas_atuais.frames_substituidos++;
+    escrita = anterior & 3;
+}
+
+void stream_init(uint32_t num_pixels, stream_saida_t saida, stream_politica_t politica) {
+    saida_atual = saida;
+    politica_atual = politica;
+    pendente = false;
+    recebendo = false;
+    estatisticas_atuais = (stream_estatisticas_t){0};
+    fila_spsc_init(&fila_recepcao, fila_buffer, 1, STREAM_FILA_BYTES);
+    proto_init(num_pixels, frame_recebido);
+}
+
+void stream_processar(void) {
+    uint8_t bloco[STREAM_BLOCO];
+    uint32_t analisados = 0, n;
+
+    ler_serial();
+    while (analisados < STREAM_ANALISE_BYTES &&
+           (n = fila_spsc_retirar_varios(&fila_recepcao, bloco, sizeof(bloco))) > 0) {
+        proto_alimentar(bloco, n);
+        analisados += n;
+    }
+}
+
+bool stream_tick(void) {
+    uint32_t agora = hal_agora_ms();
+
+    if (__atomic_load_n(&meio, __ATOMIC_ACQUIRE) & NOVO) {
+        leitura = __atomic_exchange_n(&meio, leitura, __ATOMIC_ACQ_REL) & 3;
+        pendente = true;
+        recebendo = true;
+        ultimo_frame_ms = agora;
+    }
+
+    // Saída ocupada: o mesmo frame é tentado no próximo tick, a menos que chegue um mais novo
+    if (pendente && saida_atual(quadros[leitura])) {
+        pendente = false;
+        estatisticas_atuais.frames_exibidos++;
+    }
+
+    if (recebendo && agora - ultimo_frame_ms >= STREAM_POSSE_MS) recebendo = false;
+    return recebendo;
+}
+
+bool stream_pendente(void) {
+    return fila_spsc_ocupacao(&fila_recepcao) > 0;
+}
+
+void stream_obter_estatisticas(stream_estatisticas_t *estatisticas) {
+    *estatisticas = estatisticas_atuais;
+    proto_obter_estatisticas(&estatisticas->protocolo);
+}
@@ -0,0 +1,65 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "protocolo.h"
+
+// Bytes guardados entre a leitura da serial e o analisador do protocolo (potência de 2)
+#define STREAM_FILA_BYTES 2048
+
+// Bytes analisados por chamada de stream_processar; sob rajada, o excedente espera na fila e o
+// laço principal volta ao teclado
+#define STREAM_ANALISE_BYTES 512
+
+// Tempo sem frames novos depois do qual a matriz volta às animações
+#define STREAM_POSSE_MS 500
+
+// O que fazer com bytes que chegam com a fila cheia
+typedef enum {
+    STREAM_SEGURAR,    // Deixa os bytes na serial: o USB deixa de aceitar pacotes e o PC espera
+    STREAM_DESCARTAR   // Lê e descarta: o PC nunca trava e o analisador se ressincroniza pelo CRC
+} stream_politica_t;
+
+// Mesma assinatura de fb_enviar / anim_saida_t
+typedef bool (*stream_saida_t)(const uint32_t *frame);
+
+typedef struct {
+    uint32_t bytes_recebidos;
+    uint32_t bytes_descartados;   // Fila cheia com STREAM_DESCARTAR
+    uint32_t frames_exibidos;
+    uint32_t frames_substituidos; // Frames recebidos e trocados por um mais novo antes de exibidos
+    proto_estatisticas_t protocolo;
+} stream_estatisticas_t;
+
+/**
+ * @brief Inicia a recepção de frames pela serial (USB CDC) no protocolo de protocolo.h.
+ *
+ * stream_processar (laço principal) lê a serial para uma fila circular, analisa os pacotes e
+ * codifica cada frame em um buffer triplo; stream_tick (mesmo contexto de anim_tick) entrega à
+ * saída sempre o frame mais novo, descartando os intermediários. A serial não é lida em
+ * interrupção: a stdio do SDK protege a leitura com um mutex que pode estar com um printf.
+ *
+ * @param num_pixels Pixels por frame (até PROTO_MAX_PIXELS), os de layout_matriz.
+ * @param saida Função que envia o frame codificado (ex.: fb_enviar).
+ */
+void stream_init(uint32_t num_pixels, stream_saida_t saida, stream_politica_t politica);
+
+// Lê a serial e analisa os bytes recebidos; chamada continuamente pelo laço principal
+void stream_processar(void);
+
+/**
+ * @brief Envia o frame mais novo, se houver; chamada a cada tick de renderização, antes de anim_tick.
+ *
+ * @return true enquanto a stream detém a matriz (último frame recebido há menos de
+ *         STREAM_POSSE_MS); nesse período o escalonador de animações deve ficar suspenso.
+ */
+bool stream_tick(void);
+
+// Indica se ficaram bytes na fila para a próxima chamada de stream_processar (o laço não deve dormir)
+bool stream_pendente(void);
+
+void stream_obter_estatisticas(stream_estatisticas_t *estatisticas);
+
+#endif
@@ -0,0 +1,90 @@
+#include "compacta_codificador.h"
+
+#include <string.h>
+
+uint32_t compacta_rle(uint8_t *destino, const uint8_t *indices, uint32_t n) {
+    uint32_t saida = 0, i = 0;
+
+    while (i < n) {
+        uint32_t corrida = 1;
+        while (i + corrida < n && corrida < COMPACTA_CORRIDA_MAX && indices[i + corrida] == indices[i]) corrida++;
+
+        // Corridas de 3 ou mais já economizam; as menores seguem como literais
+        if (corrida >= 3) {
+            destino[saida++] = (uint8_t)(0x80u | (corrida - 1));
+            destino[saida++] = indices[i];
+            i += corrida;
+            continue;
+        }
+
+        // Acumula literais até a próxima corrida longa ou o limite de um bloco
+        uint32_t inicio = i, literais = 0;
+        while (i < n && literais < COMPACTA_CORRIDA_MAX) {
+            if (i + 2 < n && indices[i] == indices[i + 1] && indices[i] == indices[i + 2]) break;
+            i++;
+            literais++;
+        }
+        destino[saida++] = (uint8_t)(literais - 1);
+        memcpy(&destino[saida], &indices[inicio], literais);
+        saida += literais;
+    }
+    return saida;
+}
+
+uint32_t compacta_codificar(uint8_t *destino, const uint8_t *paleta_rgb, uint8_t num_cores,
+                            const uint8_t *indices, const uint16_t *duracoes_ms,
+                            uint16_t num_pixels, uint16_t num_quadros) {
+    static uint8_t delta[COMPACTA_MAX_PIXELS];
+    static uint8_t rle_chave[COMPACTA_MAX_PIXELS + COMPACTA_MAX_PIXELS / COMPACTA_CORRIDA_MAX + 1];
+    static uint8_t rle_delta[sizeof(rle_chave)];
+    uint32_t n = 0;
+
+    if (num_pixels == 0 || num_pixels > COMPACTA_MAX_PIXELS || num_quadros == 0) return 0;
+    if (num_cores == 0 || num_cores > COMPACTA_MAX_CORES) return 0;
+
+    destino[n++] = COMPACTA_MAGICO1;
+    destino[n++] = COMPACTA_MAGICO2;
+    destino[n++] = (uint8_t)num_pixels;
+    destino[n++] = (uint8_t)(num_pixels >> 8);
+    destino[n++] = (uint8_t)num_quadros;
+    destino[n++] = (uint8_t)(num_quadros >> 8);
+    destino[n++] = num_cores;
+    memcpy(&destino[n], paleta_rgb, num_cores * 3u);
+    n += num_cores * 3u;
+
+    for (uint32_t q = 0; q < num_quadros; q++) {
+        const uint8_t *quadro = &indices[q * num_pixels];
+        uint32_t tam_chave = compacta_rle(rle_chave, quadro, num_pixels);
+        uint32_t tam_delta = UINT32_MAX;
+
+        if (q > 0) {
+            const uint8_t *anterior = quadro - num_pixels;
+            for (uint32_t i = 0; i < num_pixels; i++) delta[i] = quadro[i] ^ anterior[i];
+            tam_delta = compacta_rle(rle_delta, delta, num_pixels);
+        }
+
+        bool usar_delta = tam_delta < tam_chave;
+        destino[n++] = usar_delta ? COMPACTA_DELTA : COMPACTA_CHAVE;
+        destino[n++] = (uint8_t)duracoes_ms[q];
+        destino[n++] = (uint8_t)(duracoes_ms[q] >> 8);
+        memcpy(&destino[n], usar_delta ? rle_delta : rle_chave, usar_delta ? tam_delta : tam_chave);
+        n += usar_delta ? tam_delta : tam_chave;
+    }
+    return n;
+}
+
+uint8_t compacta_paleta(const uint8_t *rgb, uint32_t total_pixels, uint8_t *paleta_rgb, uint8_t *indices) {
+    uint8_t num_cores = 0;
+
+    for (uint32_t i = 0; i < total_pixels; i++, rgb += 3) {
+        uint8_t c = 0;
+        while (c < num_cores && memcmp(&paleta_rgb[c * 3], rgb, 3) != 0) c++;
+        if (c == num_cores) {
+            if (num_cores == COMPACTA_MAX_CORES) return 0;
+            memcpy(&paleta_rgb[c * 3], rgb, 3);
+            num_cores++;
+        }
+        indices[i] = c;
+    }
+    return num_cores;
+}
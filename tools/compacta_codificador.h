@@ -0,0 +1,50 @@
+#ifndef COMPACTA_CODIFICADOR_H
+#define COMPACTA_CODIFICADOR_H
+
+#include <stdint.h>
+
+#include "compacta.h"
+
+/**
+ * @brief Codificador do formato de compacta.h, usado no host (tools/compactar e benchmarks).
+ *
+ * Cada frame é gravado como frame-chave ou como delta XOR sobre o anterior, o que ficar menor;
+ * o primeiro é sempre chave.
+ */
+
+// Maior tamanho possível de um contêiner (cada frame com todos os índices literais)
+#define COMPACTA_TAMANHO_MAXIMO(pixels, quadros, cores) \
+    (COMPACTA_CABECALHO + 3u * (cores) + (uint32_t)(quadros) * (3u + (pixels) + ((pixels) + COMPACTA_CORRIDA_MAX - 1) / COMPACTA_CORRIDA_MAX))
+
+/**
+ * @brief Codifica uma sequência de índices em corridas (RLE do contêiner).
+ *
+ * @param destino Área com pelo menos n + n / COMPACTA_CORRIDA_MAX + 1 bytes.
+ * @return Bytes gravados.
+ */
+uint32_t compacta_rle(uint8_t *destino, const uint8_t *indices, uint32_t n);
+
+/**
+ * @brief Monta um contêiner a partir de frames já convertidos em índices de paleta.
+ *
+ * @param destino Área com COMPACTA_TAMANHO_MAXIMO(num_pixels, num_quadros, num_cores) bytes.
+ * @param paleta_rgb num_cores * 3 bytes R, G, B.
+ * @param indices num_quadros * num_pixels índices, frame a frame.
+ * @param duracoes_ms Duração de cada frame.
+ * @return Tamanho do contêiner em bytes, ou 0 se os parâmetros excederem os limites do formato.
+ */
+uint32_t compacta_codificar(uint8_t *destino, const uint8_t *paleta_rgb, uint8_t num_cores,
+                            const uint8_t *indices, const uint16_t *duracoes_ms,
+                            uint16_t num_pixels, uint16_t num_quadros);
+
+/**
+ * @brief Monta a paleta de frames em RGB e converte cada pixel no índice da sua cor.
+ *
+ * @param rgb total_pixels * 3 bytes.
+ * @param paleta_rgb Destino com COMPACTA_MAX_CORES * 3 bytes.
+ * @param indices Destino com total_pixels índices.
+ * @return Número de cores, ou 0 se houver mais de COMPACTA_MAX_CORES.
+ */
+uint8_t compacta_paleta(const uint8_t *rgb, uint32_t total_pixels, uint8_t *paleta_rgb, uint8_t *indices);
+
+#endif
@@ -0,0 +1,301 @@
+/**
+ * @brief Codifica animações descritas em texto no formato compacto de compacta.h ou em frames
+ * pré-codificados.
+ *
+ * Gera um arquivo C com um vetor const por entrada (anim_<nome do arquivo>) e, opcionalmente,
+ * o cabeçalho com as declarações. Cada contêiner é decodificado de volta e conferido. No build,
+ * pio_matrix_gerar_animacoes (animacoes.cmake) executa esta ferramenta sobre animacoes/<nome>.txt.
+ *
+ * Uso:
+ *   compactar [-o saida.c] [-H saida.h] entrada.txt...
+ *
+ * Formato de entrada (uma diretiva por linha; linhas iniciadas por // são comentários):
+ *   pixels n                  pixels por frame (obrigatório, antes dos frames)
+ *   matriz largura altura     os frames são desenhados linha a linha, de cima para baixo, e
+ *                             reordenados para a fiação da placa (LAYOUT_PLACA de layout.h)
+ *   cor c RRGGBB              associa o caractere c a uma cor
+ *   quadro ms                 inicia um frame; as linhas seguintes trazem os caracteres dos
+ *                             pixels (espaços ignorados) até completar o frame
+ *   texto TEXTO ms c_aceso c_apagado
+ *                             um frame por caractere de TEXTO, desenhado com a fonte 5x5
+ *                             (exige matriz 5 5)
+ *   formato compacta|quadros  compacta (padrão): vetor uint8_t com o contêiner de compacta.h;
+ *                             quadros: palavras já codificadas com cor_grb no brilho padrão e o
+ *                             protocolo de PIO_MATRIX_LED (anim_<nome>_quadros) e o vetor de
+ *                             passos anim_<nome> para uma anim_sequencia_t
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compacta_codificador.h"
+#include "cor.h"
+#include "fonte.h"
+#include "layout.h"
+
+typedef struct {
+    uint16_t num_pixels;
+    uint16_t largura, altura;     // 0 quando os frames já vêm na ordem dos LEDs
+    layout_t layout;              // Fiação da placa com as dimensões de 'matriz'
+    uint8_t cor_rgb[256][3];
+    bool cor_definida[256];
+    uint8_t *rgb;                 // num_quadros * num_pixels * 3
+    uint16_t *duracoes;
+    uint32_t num_quadros;
+    uint32_t preenchidos;         // Pixels já lidos do frame em andamento
+    bool quadros;                 // Saída em frames pré-codificados em vez do contêiner
+} animacao_texto_t;
+
+static const char *arquivo_atual;
+static int linha_atual;
+
+static void falhar(const char *mensagem) {
+    fprintf(stderr, "%s:%d: %s\n", arquivo_atual, linha_atual, mensagem);
+    exit(1);
+}
+
+// Posição do pixel lógico i (linha a linha, de cima para baixo) na fiação da placa
+static uint32_t posicao_fisica(const animacao_texto_t *a, uint32_t i) {
+    return a->largura == 0 ? i : a->layout.fisico[i];
+}
+
+static void novo_quadro(animacao_texto_t *a, uint32_t duracao) {
+    if (a->num_pixels == 0) falhar("'pixels' precisa vir antes dos frames");
+    if (a->preenchidos != 0) falhar("frame anterior incompleto");
+    if (duracao > UINT16_MAX) falhar("duração acima de 65535 ms");
+
+    a->num_quadros++;
+    a->rgb = realloc(a->rgb, (size_t)a->num_quadros * a->num_pixels * 3);
+    a->duracoes = realloc(a->duracoes, a->num_quadros * sizeof(uint16_t));
+    if (!a->rgb || !a->duracoes) falhar("memória insuficiente");
+    a->duracoes[a->num_quadros - 1] = (uint16_t)duracao;
+}
+
+static void definir_pixel(animacao_texto_t *a, char c) {
+    if (!a->cor_definida[(uint8_t)c]) falhar("caractere sem cor definida");
+    uint8_t *destino = &a->rgb[((size_t)(a->num_quadros - 1) * a->num_pixels + posicao_fisica(a, a->preenchidos)) * 3];
+    memcpy(destino, a->cor_rgb[(uint8_t)c], 3);
+    if (++a->preenchidos == a->num_pixels) a->preenchidos = 0;
+}
+
+static void ler_entrada(const char *caminho, animacao_texto_t *a) {
+    char linha[512], palavra[256], arg1[256];
+    unsigned v1, v2;
+    char c1, c2;
+
+    FILE *f = fopen(caminho, "r");
+    if (!f) {
+        perror(caminho);
+        exit(1);
+    }
+    arquivo_atual = caminho;
+    linha_atual = 0;
+
+    while (fgets(linha, sizeof(linha), f)) {
+        linha_atual++;
+        if (strncmp(linha, "//", 2) == 0) continue;
+
+        if (sscanf(linha, "%255s", palavra) != 1) continue;
+
+        if (strcmp(palavra, "pixels") == 0 && sscanf(linha, "%*s %u", &v1) == 1) {
+            if (v1 == 0 || v1 > COMPACTA_MAX_PIXELS) falhar("número de pixels fora do limite");
+            if (a->num_quadros > 0) falhar("'pixels' depois dos frames");
+            a->num_pixels = (uint16_t)v1;
+        } else if (strcmp(palavra, "matriz") == 0 && sscanf(linha, "%*s %u %u", &v1, &v2) == 2) {
+            if (v1 * v2 != a->num_pixels) falhar("matriz não corresponde ao número de pixels");
+            a->largura = (uint16_t)v1;
+            a->altura = (uint16_t)v2;
+            // Mesma fiação da placa; com um quarto de volta, o painel tem as dimensões trocadas
+            layout_config_t config = LAYOUT_PLACA;
+            config.largura = (uint8_t)((config.rotacao & 1) ? v2 : v1);
+            config.altura = (uint8_t)((config.rotacao & 1) ? v1 : v2);
+            if (v1 > UINT8_MAX || v2 > UINT8_MAX || !layout_montar(&a->layout, &config)) falhar("matriz fora do limite");
+        } else if (strcmp(palavra, "formato") == 0 && sscanf(linha, "%*s %255s", arg1) == 1) {
+            if (strcmp(arg1, "quadros") == 0) a->quadros = true;
+            else if (strcmp(arg1, "compacta") == 0) a->quadros = false;
+            else falhar("formato desconhecido (compacta ou quadros)");
+        } else if (strcmp(palavra, "cor") == 0 && sscanf(linha, "%*s %c %x", &c1, &v1) == 2) {
+            a->cor_rgb[(uint8_t)c1][0] = (uint8_t)(v1 >> 16);
+            a->cor_rgb[(uint8_t)c1][1] = (uint8_t)(v1 >> 8);
+            a->cor_rgb[(uint8_t)c1][2] = (uint8_t)v1;
+            a->cor_definida[(uint8_t)c1] = true;
+        } else if (strcmp(palavra, "quadro") == 0 && sscanf(linha, "%*s %u", &v1) == 1) {
+            novo_quadro(a, v1);
+            // As linhas seguintes completam o frame
+            int faltam = a->num_pixels;
+            while (faltam > 0 && fgets(linha, sizeof(linha), f)) {
+                linha_atual++;
+                for (char *p = linha; *p && faltam > 0; p++) {
+                    if (isspace((unsigned char)*p)) continue;
+                    definir_pixel(a, *p);
+                    faltam--;
+                }
+            }
+            if (faltam > 0) falhar("frame incompleto no fim do arquivo");
+        } else if (strcmp(palavra, "texto") == 0 &&
+                   sscanf(linha, "%*s %255s %u %c %c", arg1, &v1, &c1, &c2) == 4) {
+            if (a->largura != FONTE_LARGURA || a->altura != FONTE_ALTURA) falhar("'texto' exige matriz 5 5");
+            for (const char *t = arg1; *t; t++) {
+                uint32_t glifo = fonte_glifo(*t);
+                novo_quadro(a, v1);
+                for (int i = 0; i < FONTE_PIXELS; i++) {
+                    definir_pixel(a, ((glifo >> (FONTE_PIXELS - 1 - i)) & 1u) ? c1 : c2);
+                }
+            }
+        } else {
+            falhar("diretiva inválida");
+        }
+    }
+    fclose(f);
+    if (a->num_quadros == 0) falhar("nenhum frame");
+}
+
+// Nome do vetor: anim_ seguido do nome do arquivo sem diretório e extensão
+static void nome_vetor(const char *caminho, char *nome, size_t tamanho) {
+    const char *base = strrchr(caminho, '/');
+    base = base ? base + 1 : caminho;
+    size_t n = (size_t)snprintf(nome, tamanho, "anim_%s", base);
+    char *ponto = strrchr(nome, '.');
+    if (ponto) *ponto = '\0';
+    for (size_t i = 0; i < n && nome[i]; i++) {
+        if (!isalnum((unsigned char)nome[i])) nome[i] = '_';
+    }
+}
+
+// Frames pré-codificados: um vetor de palavras por frame e os passos que apontam para eles
+static void escrever_quadros(FILE *saida_c, FILE *saida_h, const char *nome, const animacao_texto_t *a) {
+    fprintf(saida_c, "const uint32_t %s_quadros[%u][%u] = {\n", nome, a->num_quadros, a->num_pixels);
+    for (uint32_t q = 0; q < a->num_quadros; q++) {
+        fprintf(saida_c, "    {");
+        for (uint32_t i = 0; i < a->num_pixels; i++) {
+            const uint8_t *rgb = &a->rgb[((size_t)q * a->num_pixels + i) * 3];
+            fprintf(saida_c, "%s0x%08X,", (i % 6) ? " " : "\n        ", cor_grb(rgb[0], rgb[1], rgb[2]));
+        }
+        fprintf(saida_c, "\n    },\n");
+    }
+    fprintf(saida_c, "};\n\nconst anim_passo_t %s[%u] = {", nome, a->num_quadros);
+    for (uint32_t q = 0; q < a->num_quadros; q++) {
+        fprintf(saida_c, "%s{%s_quadros[%u], %u},", (q % 3) ? " " : "\n    ", nome, q, a->duracoes[q]);
+    }
+    fprintf(saida_c, "\n};\n\n");
+    if (saida_h) {
+        fprintf(saida_h, "extern const uint32_t %s_quadros[%u][%u];\n", nome, a->num_quadros, a->num_pixels);
+        fprintf(saida_h, "extern const anim_passo_t %s[%u];\n", nome, a->num_quadros);
+    }
+}
+
+// Decodifica o contêiner e compara cada frame com a codificação direta das cores de entrada
+static void conferir(const uint8_t *dados, const animacao_texto_t *a) {
+    static compacta_t c;
+    static uint32_t frame[COMPACTA_MAX_PIXELS];
+    uint32_t duracao;
+
+    if (!compacta_abrir(&c, dados)) falhar("contêiner gerado não abre");
+    for (uint32_t q = 0; q < a->num_quadros; q++) {
+        if (!compacta_proximo(&c, frame, &duracao) || duracao != a->duracoes[q]) falhar("falha ao decodificar");
+        for (uint32_t i = 0; i < a->num_pixels; i++) {
+            const uint8_t *rgb = &a->rgb[((size_t)q * a->num_pixels + i) * 3];
+            if (frame[i] != cor_grb(rgb[0], rgb[1], rgb[2])) falhar("frame decodificado difere da entrada");
+        }
+    }
+    if (compacta_proximo(&c, frame, &duracao)) falhar("frames a mais no contêiner");
+}
+
+int main(int argc, char **argv) {
+    const char *caminho_c = NULL, *caminho_h = NULL;
+    const char *entradas[64];
+    int num_entradas = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) caminho_c = argv[++i];
+        else if (strcmp(argv[i], "-H") == 0 && i + 1 < argc) caminho_h = argv[++i];
+        else if (argv[i][0] != '-' && num_entradas < 64) entradas[num_entradas++] = argv[i];
+        else { num_entradas = 0; break; }
+    }
+    if (num_entradas == 0) {
+        fprintf(stderr, "uso: compactar [-o saida.c] [-H saida.h] entrada.txt...\n");
+        return 1;
+    }
+
+    FILE *saida_c = caminho_c ? fopen(caminho_c, "w") : stdout;
+    FILE *saida_h = caminho_h ? fopen(caminho_h, "w") : NULL;
+    if (!saida_c || (caminho_h && !saida_h)) {
+        perror("saída");
+        return 1;
+    }
+    cor_set_brilho(COR_BRILHO_PADRAO);
+
+    const char *base_h = caminho_h ? strrchr(caminho_h, '/') : NULL;
+    base_h = base_h ? base_h + 1 : caminho_h;
+    fprintf(saida_c, "// Gerado por tools/compactar; edite os arquivos de entrada, não este arquivo\n\n");
+    if (base_h) {
+        fprintf(saida_c, "#include \"%s\"\n\n", base_h);
+        fprintf(saida_h, "// Gerado por tools/compactar; edite os arquivos de entrada, não este arquivo\n\n");
+        // Guarda de inclusão derivada do nome do arquivo (animacoes.h -> ANIMACOES_H)
+        char guarda[128];
+        size_t n = 0;
+        for (const char *p = base_h; *p && n < sizeof(guarda) - 1; p++) {
+            guarda[n++] = isalnum((unsigned char)*p) ? (char)toupper((unsigned char)*p) : '_';
+        }
+        guarda[n] = '\0';
+        fprintf(saida_h, "#ifndef %s\n#define %s\n\n#include <stdint.h>\n#include \"animacao.h\"\n\n", guarda, guarda);
+    } else {
+        fprintf(saida_c, "#include <stdint.h>\n#include \"animacao.h\"\n\n");
+    }
+
+    for (int e = 0; e < num_entradas; e++) {
+        static animacao_texto_t a;
+        char nome[128];
+
+        free(a.rgb);
+        free(a.duracoes);
+        memset(&a, 0, sizeof(a));
+        ler_entrada(entradas[e], &a);
+        if (a.num_quadros > UINT16_MAX) falhar("frames demais");
+        nome_vetor(entradas[e], nome, sizeof(nome));
+
+        if (a.quadros) {
+            // anim_sequencia_t conta os passos em 8 bits
+            if (a.num_quadros > UINT8_MAX) falhar("frames demais para uma sequência de passos");
+            fprintf(saida_c, "// %s: %u frames pré-codificados de %u pixels\n", entradas[e], a.num_quadros, a.num_pixels);
+            escrever_quadros(saida_c, saida_h, nome, &a);
+            fprintf(stderr, "%-24s %3u frames:           %6u bytes pré-codificados\n",
+                    nome, a.num_quadros, a.num_quadros * a.num_pixels * 4u);
+            continue;
+        }
+
+        static uint8_t paleta[COMPACTA_MAX_CORES * 3];
+        uint8_t *indices = malloc((size_t)a.num_quadros * a.num_pixels);
+        uint8_t *dados = malloc(COMPACTA_TAMANHO_MAXIMO(a.num_pixels, a.num_quadros, COMPACTA_MAX_CORES));
+        if (!indices || !dados) falhar("memória insuficiente");
+
+        uint8_t num_cores = compacta_paleta(a.rgb, a.num_quadros * a.num_pixels, paleta, indices);
+        if (num_cores == 0) falhar("cores demais para a paleta");
+        uint32_t tamanho = compacta_codificar(dados, paleta, num_cores, indices, a.duracoes,
+                                              a.num_pixels, (uint16_t)a.num_quadros);
+        conferir(dados, &a);
+
+        fprintf(saida_c, "// %s: %u frames de %u pixels, %u cores\n", entradas[e], a.num_quadros, a.num_pixels, num_cores);
+        fprintf(saida_c, "const uint8_t %s[%u] = {", nome, tamanho);
+        for (uint32_t i = 0; i < tamanho; i++) {
+            fprintf(saida_c, "%s0x%02X,", (i % 12) ? " " : "\n    ", dados[i]);
+        }
+        fprintf(saida_c, "\n};\n\n");
+        if (saida_h) fprintf(saida_h, "extern const uint8_t %s[%u];\n", nome, tamanho);
+
+        uint32_t bruto = a.num_quadros * a.num_pixels * 4u;
+        fprintf(stderr, "%-24s %3u frames %3u cores: %6u bytes pré-codificados -> %5u bytes (%.1fx)\n",
+                nome, a.num_quadros, num_cores, bruto, tamanho, (double)bruto / tamanho);
+        free(indices);
+        free(dados);
+    }
+
+    if (saida_h) {
+        fprintf(saida_h, "\n#endif\n");
+        fclose(saida_h);
+    }
+    if (saida_c != stdout) fclose(saida_c);
+    return 0;
+}
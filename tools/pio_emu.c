@@ -0,0 +1,310 @@
+/**
+ * @brief Emulador de ciclo da PIO (RP2040) para verificar o tempo dos pulsos dos LEDs no host.
+ *
+ * Monta um programa de um arquivo .pio (o subconjunto do pioasm de tools/pio_maquina.h, com
+ * side-set), executa as instruções codificadas
+ * em uma state machine com a configuração de pio_matrix_program_init e alimenta a FIFO TX com
+ * as palavras lidas da entrada padrão, como o DMA do firmware. O sinal do pino de saída é
+ * medido e resumido: T0H, T1H, T0L e T1L por bit, tempo de cada frame no fio, pausas entre
+ * frames (reset), esvaziamentos da FIFO (underrun) e bits decodificados diferentes dos enviados.
+ *
+ * Uso:
+ *   pio_emu [opções] pio_matrix.pio < palavras.txt
+ *
+ * As palavras são números hexadecimais (0x...) separados por espaço; outros textos são ignorados,
+ * de modo que a saída do comando "x" de pio_matrix_host pode ser usada diretamente:
+ *   echo "1 w100 x q" | pio_matrix_host | pio_emu pio_matrix.pio
+ *
+ * Para outras variantes de PIO_MATRIX_LED, use a cópia de pio_matrix.pio gerada na pasta de build
+ * e o mesmo protocolo, por exemplo:
+ *   echo "1 w100 x q" | build/pio_matrix_host | build/pio_emu --protocolo WS2811 build/pio_matrix.pio
+ *
+ * Opções (padrões iguais ao firmware):
+ *   --protocolo nome    WS2812, SK6812_RGBW ou WS2811: limites de especificação dos pulsos, clock
+ *                       da PIO, bits por palavra e reset dos descritores de led_protocolo.h (WS2812)
+ *   --programa nome     programa do arquivo a executar (padrão: o primeiro)
+ *   --sysclk hz         clock do sistema (128000000)
+ *   --clkdiv d          divisor da PIO (sysclk / clock da PIO do protocolo)
+ *   --limiar-pull n     bits por palavra no autopull (bits do protocolo)
+ *   --shift-direita     desloca a OSR para a direita (padrão: esquerda)
+ *   --pinos-set b n     base e quantidade dos pinos de set (0 1)
+ *   --pinos-out b n     base e quantidade dos pinos de out/mov (0 1)
+ *   --pino-side b       base dos pinos de side-set, em quantidade dada pelo .side_set (0)
+ *   --pino p            pino observado, relativo à base (0)
+ *   --quadros n         quantas vezes as palavras lidas são enviadas (2)
+ *   --intervalo-us t    espera após o DMA entregar um frame antes do próximo (FRAME_DMA_LATCH_US:
+ *                       320 no WS2812)
+ *   --dma-ciclos c      ciclos de sistema entre escritas do DMA na FIFO (4)
+ *   --reset-us t        pausa mínima entre frames exigida pelos LEDs (do protocolo; WS2812B-V5: 280)
+ *   --paralelo          fluxo do programa pio_matrix_paralelo: autopull de 32 bits, 8 pinos de
+ *                       out e um byte por bit, com o bit n indo para o pino n (observe com --pino)
+ *   --sem-verificacao   não compara os bits decodificados com as palavras enviadas
+ *   --listar            imprime o programa montado
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "led_protocolo.h"
+#include "pio_maquina.h"
+
+#define MAX_PALAVRAS 4096
+
+// Pausa máxima dentro de um frame sem risco de latch (ns)
+#define TL_PAUSA_MAX 5000
+
+// Limites de especificação de cada protocolo (ns, das folhas de dados), com o clock da PIO, os
+// bits por LED e o reset usados pelo firmware para ele
+typedef struct {
+    const char *nome;
+    double freq_bit_hz, freq_pio_hz;
+    int bits;
+    double reset_us;
+    double t0h_min, t0h_max, t1h_min, t1h_max;
+    double t0l_min, t0l_max, t1l_min, t1l_max;
+} protocolo_t;
+
+#define PROTOCOLO(v) #v, LED_##v##_FREQ_BIT_HZ, (double)LED_##v##_FREQ_BIT_HZ * LED_##v##_CICLOS_BIT, \
+                     LED_##v##_BITS, LED_##v##_RESET_US
+
+static const protocolo_t protocolos[] = {
+    {PROTOCOLO(WS2812), 250, 550, 650, 950, 700, 1000, 300, 600},
+    {PROTOCOLO(SK6812_RGBW), 150, 450, 450, 750, 750, 1050, 450, 750},
+    {PROTOCOLO(WS2811), 350, 650, 1050, 1350, 1850, 2150, 1150, 1450},
+};
+
+// ----- Medição do sinal -----
+
+typedef struct {
+    uint64_t n;
+    double min, max, soma;
+} estatistica_t;
+
+static void registrar(estatistica_t *e, double valor) {
+    if (e->n == 0 || valor < e->min) e->min = valor;
+    if (e->n == 0 || valor > e->max) e->max = valor;
+    e->soma += valor;
+    e->n++;
+}
+
+// Imprime a estatística de um tempo; devolve false se saiu da especificação
+static bool relatar(const char *nome, const estatistica_t *e, double min_spec, double max_spec) {
+    if (e->n == 0) {
+        printf("  %-4s        -\n", nome);
+        return true;
+    }
+    bool ok = e->min >= min_spec && e->max <= max_spec;
+    printf("  %-4s min %7.1f  média %7.1f  max %7.1f ns  (especificação %4.0f..%4.0f) %s\n",
+           nome, e->min, e->soma / e->n, e->max, min_spec, max_spec, ok ? "ok" : "FORA");
+    return ok;
+}
+
+static void uso(void) {
+    fprintf(stderr, "uso: pio_emu [opções] arquivo.pio < palavras (veja o cabeçalho de tools/pio_emu.c)\n");
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    const char *caminho = NULL, *nome = NULL;
+    double sysclk = 128000000.0, clkdiv = 0, intervalo_us = 0, reset_us = 0;
+    int quadros = 2, dma_ciclos = 4, pino = 0;
+    bool verificar = true, listar = false, paralelo = false;
+    config_t cfg = {.set_qtd = 1, .out_qtd = 1};
+    const protocolo_t *proto = &protocolos[0];
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        bool tem_valor = i + 1 < argc;
+        if (strcmp(a, "--protocolo") == 0 && tem_valor) {
+            const char *p = argv[++i];
+            size_t n = sizeof(protocolos) / sizeof(protocolos[0]);
+            for (proto = protocolos; proto < protocolos + n && strcasecmp(proto->nome, p) != 0; proto++) {}
+            if (proto == protocolos + n) uso();
+        }
+        else if (strcmp(a, "--programa") == 0 && tem_valor) nome = argv[++i];
+        else if (strcmp(a, "--sysclk") == 0 && tem_valor) sysclk = atof(argv[++i]);
+        else if (strcmp(a, "--clkdiv") == 0 && tem_valor) clkdiv = atof(argv[++i]);
+        else if (strcmp(a, "--limiar-pull") == 0 && tem_valor) cfg.limiar_pull = atoi(argv[++i]);
+        else if (strcmp(a, "--shift-direita") == 0) cfg.shift_direita = true;
+        else if (strcmp(a, "--pinos-set") == 0 && i + 2 < argc) { cfg.set_base = atoi(argv[++i]); cfg.set_qtd = atoi(argv[++i]); }
+        else if (strcmp(a, "--pinos-out") == 0 && i + 2 < argc) { cfg.out_base = atoi(argv[++i]); cfg.out_qtd = atoi(argv[++i]); }
+        else if (strcmp(a, "--pino-side") == 0 && tem_valor) cfg.side_base = atoi(argv[++i]);
+        else if (strcmp(a, "--pino") == 0 && tem_valor) pino = atoi(argv[++i]);
+        else if (strcmp(a, "--quadros") == 0 && tem_valor) quadros = atoi(argv[++i]);
+        else if (strcmp(a, "--intervalo-us") == 0 && tem_valor) intervalo_us = atof(argv[++i]);
+        else if (strcmp(a, "--dma-ciclos") == 0 && tem_valor) dma_ciclos = atoi(argv[++i]);
+        else if (strcmp(a, "--reset-us") == 0 && tem_valor) reset_us = atof(argv[++i]);
+        else if (strcmp(a, "--paralelo") == 0) paralelo = true;
+        else if (strcmp(a, "--sem-verificacao") == 0) verificar = false;
+        else if (strcmp(a, "--listar") == 0) listar = true;
+        else if (a[0] != '-' && !caminho) caminho = a;
+        else uso();
+    }
+    if (cfg.limiar_pull == 0) cfg.limiar_pull = proto->bits;
+    if (reset_us <= 0) reset_us = proto->reset_us;
+    // Mesma espera de frame_dma.h: FIFO de 8 palavras e OSR esvaziando, mais o reset
+    if (intervalo_us <= 0) intervalo_us = (PIO_FIFO_TAM + 1) * proto->bits * 1e6 / proto->freq_bit_hz + proto->reset_us;
+    if (paralelo) {
+        cfg.limiar_pull = 32;
+        cfg.out_qtd = 8;
+        if (!nome) nome = "pio_matrix_paralelo";
+    }
+    if (!caminho || quadros < 1 || dma_ciclos < 1 || cfg.limiar_pull < 1 || cfg.limiar_pull > 32) uso();
+
+    // Mesmo cálculo de pio_matrix_program_init: clock da PIO do protocolo
+    if (clkdiv <= 0) clkdiv = sysclk / proto->freq_pio_hz;
+    if (clkdiv < 1.0) clkdiv = 1.0;
+    // O divisor da PIO é 16.8 em ponto fixo
+    uint32_t divisor_256 = (uint32_t)(clkdiv * 256.0);
+    cfg.clkdiv = divisor_256 / 256.0;
+
+    programa_t programa;
+    pio_montar(caminho, nome, &programa);
+    if (listar) {
+        printf("programa %s (%d instruções, wrap %d..%d)\n", programa.nome, programa.tamanho, programa.wrap_target, programa.wrap);
+        for (int i = 0; i < programa.tamanho; i++) printf("  %2d: 0x%04x\n", i, programa.instrucoes[i]);
+    }
+
+    // Palavras do frame
+    static uint32_t palavras[MAX_PALAVRAS];
+    int num_palavras = 0;
+    char token[64];
+    while (num_palavras < MAX_PALAVRAS && scanf("%63s", token) == 1) {
+        long long v;
+        char *fim;
+        if (token[0] != '0' || (token[1] != 'x' && token[1] != 'X')) continue;
+        v = strtoll(token, &fim, 16);
+        if (*fim == '\0') palavras[num_palavras++] = (uint32_t)v;
+    }
+    if (num_palavras == 0) {
+        if (listar) return 0;
+        fprintf(stderr, "pio_emu: nenhuma palavra na entrada\n");
+        return 1;
+    }
+
+    sm_t sm = {0};
+    sm.programa = &programa;
+    sm.config = &cfg;
+    sm.pc = 0;
+    sm.osr_cont = 32;   // OSR vazia: o primeiro out dispara o autopull
+
+    // Bits esperados no fio (deslocamento à esquerda: bits mais altos primeiro); no modo paralelo
+    // cada palavra leva 4 bytes, e o pino observado recebe um bit de cada byte
+    int bits_palavra = paralelo ? 4 : cfg.limiar_pull;
+
+    // Largura do pulso alto que separa um bit 0 de um bit 1
+    const double th_limiar_bit = (proto->t0h_max + proto->t1h_min) / 2;
+    uint64_t bits_quadro = (uint64_t)num_palavras * bits_palavra;
+
+    const double ns_por_ciclo = 1e9 / sysclk;
+    const uint64_t intervalo_ciclos = (uint64_t)(intervalo_us * 1e-6 * sysclk);
+    const uint32_t mascara_pino = 1u << (cfg.out_base + pino);
+    const uint32_t mascara_pino_set = 1u << (cfg.set_base + pino);
+
+    estatistica_t t0h = {0}, t1h = {0}, t0l = {0}, t1l = {0}, quadro_fio = {0}, pausa_reset = {0};
+    uint64_t bits_vistos = 0, bits_errados = 0, pausas_longas = 0, violacoes_reset = 0, underruns = 0;
+
+    int quadro_dma = 0, palavra_dma = 0;
+    uint64_t proximo_dma = 0, quadro_liberado = 0;
+    uint64_t proximo_passo_256 = 0;
+    uint64_t subida = 0, descida = 0, inicio_quadro = 0;
+    bool nivel = false, houve_descida = false, ultimo_bit = false;
+    uint64_t paradas_antes = 0;
+
+    // O tempo corre em ciclos de sistema; a state machine avança a cada clkdiv ciclos
+    uint64_t limite = (uint64_t)quadros * (bits_quadro * 64 * divisor_256 / 256 + intervalo_ciclos) + 10 * intervalo_ciclos + sysclk / 1000;
+    for (uint64_t ciclo = 0; ciclo < limite; ciclo++) {
+        // DMA: uma palavra a cada dma_ciclos, com a FIFO aceitando, respeitando a espera entre frames
+        if (quadro_dma < quadros && ciclo >= quadro_liberado && ciclo >= proximo_dma && sm.fifo_qtd < PIO_FIFO_TAM) {
+            sm.fifo[(sm.fifo_ini + sm.fifo_qtd) % PIO_FIFO_TAM] = palavras[palavra_dma];
+            sm.fifo_qtd++;
+            proximo_dma = ciclo + (uint64_t)dma_ciclos;
+            if (++palavra_dma == num_palavras) {
+                palavra_dma = 0;
+                quadro_dma++;
+                quadro_liberado = ciclo + intervalo_ciclos;
+            }
+        }
+
+        if (ciclo * 256 < proximo_passo_256) continue;
+        proximo_passo_256 += divisor_256;
+
+        pio_ciclo(&sm);
+
+        // Parada com palavras do frame atual ainda não entregues pelo DMA: underrun
+        if (sm.paradas != paradas_antes) {
+            if (palavra_dma != 0 && sm.fifo_qtd == 0) underruns++;
+            paradas_antes = sm.paradas;
+        }
+
+        bool novo = ((sm.pinos & mascara_pino) | (sm.pinos & mascara_pino_set)) != 0;
+        if (novo == nivel) continue;
+        nivel = novo;
+
+        if (nivel) {
+            // Subida: fecha o tempo baixo do bit anterior, ou mede a pausa entre frames
+            if (houve_descida) {
+                double baixo_ns = (ciclo - descida) * ns_por_ciclo;
+                if (bits_vistos % bits_quadro == 0) {
+                    registrar(&pausa_reset, baixo_ns / 1000.0);
+                    if (baixo_ns < reset_us * 1000.0) violacoes_reset++;
+                } else {
+                    registrar(ultimo_bit ? &t1l : &t0l, baixo_ns);
+                    if (baixo_ns > TL_PAUSA_MAX) pausas_longas++;
+                }
+            }
+            if (bits_vistos % bits_quadro == 0) inicio_quadro = ciclo;
+            subida = ciclo;
+        } else {
+            // Descida: largura do pulso alto decide o bit
+            double alto_ns = (ciclo - subida) * ns_por_ciclo;
+            ultimo_bit = alto_ns > th_limiar_bit;
+            registrar(ultimo_bit ? &t1h : &t0h, alto_ns);
+
+            if (verificar) {
+                uint64_t bit_quadro = bits_vistos % bits_quadro;
+                uint32_t palavra = palavras[bit_quadro / bits_palavra];
+                int deslocamento = paralelo ? 24 - 8 * (int)(bit_quadro % 4) + pino : 31 - (int)(bit_quadro % bits_palavra);
+                if ((bool)((palavra >> deslocamento) & 1u) != ultimo_bit) bits_errados++;
+            }
+            bits_vistos++;
+            descida = ciclo;
+            houve_descida = true;
+            if (bits_vistos % bits_quadro == 0) registrar(&quadro_fio, (ciclo - inicio_quadro) * ns_por_ciclo / 1000.0);
+        }
+    }
+
+    double pio_hz = sysclk / cfg.clkdiv;
+    printf("protocolo %s\n", proto->nome);
+    printf("programa %s: sysclk %.3f MHz, clkdiv %.4f (PIO a %.4f MHz)\n", programa.nome, sysclk / 1e6, cfg.clkdiv, pio_hz / 1e6);
+    printf("frame: %d palavras x %d bits, %d frames enviados, intervalo %.0f µs após o DMA\n",
+           num_palavras, bits_palavra, quadros, intervalo_us);
+    printf("bits no fio: %llu de %llu", (unsigned long long)bits_vistos, (unsigned long long)(bits_quadro * quadros));
+    if (verificar) printf(", %llu diferentes do enviado", (unsigned long long)bits_errados);
+    printf("\n");
+
+    bool tempos_ok = relatar("T0H", &t0h, proto->t0h_min, proto->t0h_max);
+    tempos_ok &= relatar("T1H", &t1h, proto->t1h_min, proto->t1h_max);
+    tempos_ok &= relatar("T0L", &t0l, proto->t0l_min, proto->t0l_max);
+    tempos_ok &= relatar("T1L", &t1l, proto->t1l_min, proto->t1l_max);
+
+    if (quadro_fio.n) {
+        double periodo_bit = quadro_fio.soma / quadro_fio.n * 1000.0 / (bits_quadro > 1 ? bits_quadro - 1 : 1);
+        printf("tempo no fio por frame: %.2f µs (bit a cada %.1f ns, %.1f kbit/s)\n",
+               quadro_fio.soma / quadro_fio.n, periodo_bit, 1e6 / periodo_bit);
+        printf("taxa máxima com reset de %.0f µs: %.1f frames/s\n", reset_us, 1e6 / (quadro_fio.max + reset_us));
+    }
+    if (pausa_reset.n) {
+        printf("pausa entre frames: min %.1f µs, max %.1f µs; %llu abaixo do reset de %.0f µs\n",
+               pausa_reset.min, pausa_reset.max, (unsigned long long)violacoes_reset, reset_us);
+    }
+    printf("pausas no meio do frame acima de %d ns: %llu\n", TL_PAUSA_MAX, (unsigned long long)pausas_longas);
+    printf("underruns da FIFO: %llu ciclos parados com o frame incompleto\n", (unsigned long long)underruns);
+
+    bool falhou = !tempos_ok || bits_vistos != bits_quadro * quadros || bits_errados || pausas_longas || violacoes_reset || underruns;
+    return falhou ? 2 : 0;
+}
@@ -0,0 +1,534 @@
+#include "pio_maquina.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define MAX_ROTULOS 32
+#define MAX_DEFINICOES 16
+
+// ----- Montador -----
+
+typedef struct {
+    char nome[32];
+    int endereco;
+} rotulo_t;
+
+static rotulo_t rotulos[MAX_ROTULOS];
+static int num_rotulos;
+
+// Símbolos de .define (globais e do programa selecionado)
+static rotulo_t definicoes[MAX_DEFINICOES];
+static int num_definicoes;
+static int linha_atual;
+
+static void erro(const char *mensagem, const char *detalhe) {
+    fprintf(stderr, "pio_emu: linha %d: %s%s%s\n", linha_atual, mensagem, detalhe ? ": " : "", detalhe ? detalhe : "");
+    exit(1);
+}
+
+static char *aparar(char *s) {
+    while (isspace((unsigned char)*s)) s++;
+    char *fim = s + strlen(s);
+    while (fim > s && isspace((unsigned char)fim[-1])) *--fim = '\0';
+    return s;
+}
+
+static bool numero(const char *s, long *valor) {
+    char *fim;
+
+    if (*s == '\0') return false;
+    if (s[0] == '0' && (s[1] == 'b' || s[1] == 'B')) *valor = strtol(s + 2, &fim, 2);
+    else *valor = strtol(s, &fim, 0);
+    return *fim == '\0';
+}
+
+/**
+ * @brief Avalia um número, um símbolo de .define ou uma soma/subtração deles ("T1 - 2").
+ */
+static bool avaliar(const char *s, long *valor) {
+    char termo[32];
+    long total = 0;
+    int sinal = 1;
+
+    while (*s) {
+        while (isspace((unsigned char)*s)) s++;
+        int n = 0;
+        while (*s && *s != '+' && *s != '-' && !isspace((unsigned char)*s) && n < (int)sizeof(termo) - 1) termo[n++] = *s++;
+        termo[n] = '\0';
+        while (isspace((unsigned char)*s)) s++;
+
+        long v;
+        if (!numero(termo, &v)) {
+            int i;
+            // Sem distinção de caixa: os operandos de set chegam aqui já em minúsculas
+            for (i = 0; i < num_definicoes && strcasecmp(definicoes[i].nome, termo) != 0; i++) {}
+            if (i == num_definicoes) return false;
+            v = definicoes[i].endereco;
+        }
+        total += sinal * v;
+
+        if (*s == '\0') break;
+        if (*s != '+' && *s != '-') return false;
+        sinal = *s++ == '+' ? 1 : -1;
+        if (*s == '\0') return false;
+    }
+    *valor = total;
+    return true;
+}
+
+static int indice(const char *s, const char *const *nomes, int quantidade) {
+    for (int i = 0; i < quantidade; i++) {
+        if (nomes[i] && strcmp(s, nomes[i]) == 0) return i;
+    }
+    return -1;
+}
+
+static int alvo_salto(const char *s) {
+    long valor;
+
+    if (numero(s, &valor)) return (int)valor;
+    for (int i = 0; i < num_rotulos; i++) {
+        if (strcmp(rotulos[i].nome, s) == 0) return rotulos[i].endereco;
+    }
+    erro("rótulo desconhecido", s);
+    return 0;
+}
+
+static int contagem_bits(const char *s) {
+    long valor;
+
+    if (!numero(s, &valor) || valor < 1 || valor > 32) erro("quantidade de bits inválida", s);
+    return (int)(valor & 31);   // 32 é codificado como 0
+}
+
+// Separa os operandos por vírgula; devolve a quantidade
+static int operandos(char *s, char *saida[], int maximo) {
+    int n = 0;
+
+    if (*s == '\0') return 0;
+    for (char *parte = strtok(s, ","); parte && n < maximo; parte = strtok(NULL, ",")) {
+        saida[n++] = aparar(parte);
+    }
+    return n;
+}
+
+/**
+ * @brief Retira de texto o side-set ("side v", antes ou depois do atraso) e devolve seu valor.
+ *
+ * @return false se a instrução não tiver side-set.
+ */
+static bool extrair_side(char *texto, long *valor) {
+    for (char *p = texto; (p = strstr(p, "side")) != NULL; p += 4) {
+        if ((p != texto && !isspace((unsigned char)p[-1])) || !isspace((unsigned char)p[4])) continue;
+
+        char termo[32], *fim = p + 4;
+        int n = 0;
+        while (isspace((unsigned char)*fim)) fim++;
+        while (*fim && *fim != '[' && !isspace((unsigned char)*fim) && n < (int)sizeof(termo) - 1) termo[n++] = *fim++;
+        termo[n] = '\0';
+        if (!avaliar(termo, valor)) erro("valor de side-set inválido", termo);
+        memmove(p, fim, strlen(fim) + 1);
+        return true;
+    }
+    return false;
+}
+
+static uint16_t codificar(const programa_t *programa, char *texto) {
+    static const char *const cond_jmp[] = {"", "!x", "x--", "!y", "y--", "x!=y", "pin", "!osre"};
+    static const char *const origem_in[] = {"pins", "x", "y", "null", NULL, NULL, "isr", "osr"};
+    static const char *const destino_out[] = {"pins", "x", "y", "null", "pindirs", "pc", "isr", "exec"};
+    static const char *const destino_mov[] = {"pins", "x", "y", NULL, "exec", "pc", "isr", "osr"};
+    static const char *const origem_mov[] = {"pins", "x", "y", "null", NULL, "status", "isr", "osr"};
+    static const char *const destino_set[] = {"pins", "x", "y", NULL, "pindirs"};
+    char *ops[3];
+    int n, atraso = 0, v;
+    long valor, side;
+
+    // Campo de 5 bits dividido entre o side-set (no alto, com o bit de habilitação do opt) e o atraso
+    int bits_side = programa->side_bits + (programa->side_opt ? 1 : 0);
+    uint16_t campo_side = 0;
+    if (extrair_side(texto, &side)) {
+        if (programa->side_bits == 0) erro("side-set sem .side_set", NULL);
+        if (side < 0 || side >= (1L << programa->side_bits)) erro("valor de side-set fora dos bits de .side_set", NULL);
+        campo_side = (uint16_t)((programa->side_opt ? (1L << programa->side_bits) : 0) | side);
+    } else if (programa->side_bits > 0 && !programa->side_opt) {
+        erro("side-set obrigatório sem opt", NULL);
+    }
+
+    char *colchete = strchr(texto, '[');
+    if (colchete) {
+        if (!avaliar(aparar(strtok(colchete + 1, "]")), &valor) || valor < 0 || valor >= (1L << (5 - bits_side))) {
+            erro("atraso inválido", NULL);
+        }
+        atraso = (int)valor;
+        *colchete = '\0';
+    }
+    for (char *c = texto; *c; c++) *c = (char)tolower((unsigned char)*c);
+
+    char *mnemonico = strtok(texto, " \t");
+    char *resto = strtok(NULL, "");
+    resto = aparar(resto ? resto : (char *)"");
+    uint16_t base = (uint16_t)((atraso | campo_side << (5 - bits_side)) << 8);
+
+    if (strcmp(mnemonico, "nop") == 0) {
+        return 0xa042 | base;   // mov y, y
+    }
+    if (strcmp(mnemonico, "jmp") == 0) {
+        // jmp [condição] alvo: a condição é separada por espaço ou vírgula
+        n = 0;
+        for (char *parte = strtok(resto, " \t,"); parte && n < 3; parte = strtok(NULL, " \t,")) ops[n++] = parte;
+        if (n == 1) return base | (uint16_t)alvo_salto(ops[0]);
+        if (n != 2 || (v = indice(ops[0], cond_jmp, 8)) < 1) erro("condição de jmp inválida", n ? ops[0] : NULL);
+        return base | (uint16_t)(v << 5) | (uint16_t)alvo_salto(ops[1]);
+    }
+    if (strcmp(mnemonico, "wait") == 0) {
+        // wait <polaridade> gpio|pin <índice>
+        char *pol = strtok(resto, " \t"), *origem = strtok(NULL, " \t"), *num = strtok(NULL, " \t,");
+        int o = origem ? (strcmp(origem, "gpio") == 0 ? 0 : strcmp(origem, "pin") == 0 ? 1 : -1) : -1;
+        if (!pol || o < 0 || !num || !numero(num, &valor)) erro("wait suporta apenas gpio e pin", NULL);
+        return 0x2000 | base | (uint16_t)((atoi(pol) & 1) << 7) | (uint16_t)(o << 5) | (uint16_t)(valor & 31);
+    }
+    if (strcmp(mnemonico, "in") == 0 || strcmp(mnemonico, "out") == 0) {
+        bool entrada = mnemonico[0] == 'i';
+        if (operandos(resto, ops, 2) != 2) erro("esperado destino e quantidade de bits", NULL);
+        v = entrada ? indice(ops[0], origem_in, 8) : indice(ops[0], destino_out, 8);
+        if (v < 0) erro("operando inválido", ops[0]);
+        return (entrada ? 0x4000 : 0x6000) | base | (uint16_t)(v << 5) | (uint16_t)contagem_bits(ops[1]);
+    }
+    if (strcmp(mnemonico, "push") == 0 || strcmp(mnemonico, "pull") == 0) {
+        bool pull = mnemonico[1] == 'u' && mnemonico[2] == 'l';
+        uint16_t palavra = 0x8000 | base | (pull ? 0x80 : 0) | 0x20;   // bloqueante por padrão
+        for (char *opcao = strtok(resto, " \t"); opcao; opcao = strtok(NULL, " \t")) {
+            if (strcmp(opcao, "noblock") == 0) palavra &= (uint16_t)~0x20;
+            else if (strcmp(opcao, "block") == 0) palavra |= 0x20;
+            else if (strcmp(opcao, pull ? "ifempty" : "iffull") == 0) palavra |= 0x40;
+            else erro("opção inválida", opcao);
+        }
+        return palavra;
+    }
+    if (strcmp(mnemonico, "mov") == 0) {
+        int op = 0;
+        if (operandos(resto, ops, 2) != 2) erro("esperado destino e origem", NULL);
+        char *origem = ops[1];
+        if (origem[0] == '!' || origem[0] == '~') { op = 1; origem++; }
+        else if (origem[0] == ':' && origem[1] == ':') { op = 2; origem += 2; }
+        origem = aparar(origem);
+        int d = indice(ops[0], destino_mov, 8), o = indice(origem, origem_mov, 8);
+        if (d < 0 || o < 0) erro("operando de mov inválido", d < 0 ? ops[0] : origem);
+        return 0xa000 | base | (uint16_t)(d << 5) | (uint16_t)(op << 3) | (uint16_t)o;
+    }
+    if (strcmp(mnemonico, "set") == 0) {
+        if (operandos(resto, ops, 2) != 2 || (v = indice(ops[0], destino_set, 5)) < 0) erro("destino de set inválido", NULL);
+        if (!avaliar(ops[1], &valor) || valor < 0 || valor > 31) erro("valor de set inválido", ops[1]);
+        return 0xe000 | base | (uint16_t)(v << 5) | (uint16_t)valor;
+    }
+    erro("instrução não suportada", mnemonico);
+    return 0;
+}
+
+// .side_set n [opt] [pindirs]
+static void declarar_side_set(programa_t *programa, char *argumentos) {
+    long bits;
+    char *parte = strtok(argumentos, " \t");
+
+    if (!parte || !numero(parte, &bits) || bits < 1 || bits > 5) erro(".side_set inválido", NULL);
+    programa->side_bits = (int)bits;
+    programa->side_opt = programa->side_pindirs = false;
+    while ((parte = strtok(NULL, " \t")) != NULL) {
+        if (strcmp(parte, "opt") == 0) programa->side_opt = true;
+        else if (strcmp(parte, "pindirs") == 0) programa->side_pindirs = true;
+        else erro("opção de .side_set inválida", parte);
+    }
+    if (programa->side_bits + programa->side_opt > 5) erro(".side_set excede o campo de 5 bits", NULL);
+}
+
+// Remove comentários; devolve NULL para linhas vazias
+static char *limpar_linha(char *linha) {
+    char *c = strchr(linha, ';');
+    if (c) *c = '\0';
+    c = strstr(linha, "//");
+    if (c) *c = '\0';
+    linha = aparar(linha);
+    return *linha ? linha : NULL;
+}
+
+/**
+ * @brief Monta o programa pedido (ou o primeiro) do arquivo .pio em duas passagens.
+ *
+ * A primeira registra rótulos e endereços; a segunda codifica as instruções.
+ */
+void pio_montar(const char *caminho, const char *nome, programa_t *programa) {
+    char linha[256];
+
+    memset(programa, 0, sizeof(*programa));
+    programa->wrap = -1;
+
+    for (int passagem = 0; passagem < 2; passagem++) {
+        FILE *arquivo = fopen(caminho, "r");
+        bool selecionado = false, encontrado = false, bloco_c = false, em_programa = false;
+        int endereco = 0;
+
+        if (!arquivo) { perror(caminho); exit(1); }
+        linha_atual = 0;
+        while (fgets(linha, sizeof(linha), arquivo)) {
+            char *s;
+            linha_atual++;
+
+            if (bloco_c) { if (strstr(linha, "%}")) bloco_c = false; continue; }
+            if (!(s = limpar_linha(linha))) continue;
+            if (s[0] == '%') { bloco_c = strstr(s, "%}") == NULL; continue; }
+
+            // .define [public] nome valor: fora de qualquer programa vale para todos
+            if (strncmp(s, ".define", 7) == 0 && isspace((unsigned char)s[7])) {
+                char *simbolo = strtok(s + 7, " \t"), *expressao;
+                if (simbolo && strcasecmp(simbolo, "public") == 0) simbolo = strtok(NULL, " \t");
+                expressao = strtok(NULL, "");
+                if (passagem == 1 || (em_programa && !selecionado)) continue;
+                if (!simbolo || !expressao || num_definicoes == MAX_DEFINICOES) erro(".define inválido", NULL);
+                long valor;
+                if (!avaliar(aparar(expressao), &valor)) erro("valor de .define inválido", expressao);
+                snprintf(definicoes[num_definicoes].nome, sizeof(definicoes[0].nome), "%s", simbolo);
+                definicoes[num_definicoes++].endereco = (int)valor;
+                continue;
+            }
+
+            if (strncmp(s, ".program", 8) == 0) {
+                char *n = aparar(s + 8);
+                if (encontrado) break;
+                em_programa = true;
+                selecionado = !nome || strcmp(n, nome) == 0;
+                if (selecionado) {
+                    encontrado = true;
+                    snprintf(programa->nome, sizeof(programa->nome), "%s", n);
+                }
+                continue;
+            }
+            if (!selecionado) continue;
+
+            if (s[0] == '.') {
+                if (strcmp(s, ".wrap_target") == 0) programa->wrap_target = endereco;
+                else if (strcmp(s, ".wrap") == 0) programa->wrap = endereco - 1;
+                else if (strncmp(s, ".side_set", 9) == 0) declarar_side_set(programa, s + 9);
+                else if (strncmp(s, ".origin", 7) != 0) erro("diretiva não suportada", s);
+                continue;
+            }
+
+            char *dois_pontos = strchr(s, ':');
+            if (dois_pontos && (dois_pontos[1] == '\0' || isspace((unsigned char)dois_pontos[1]))) {
+                *dois_pontos = '\0';
+                if (strncmp(s, "public ", 7) == 0) s = aparar(s + 7);
+                if (passagem == 0) {
+                    if (num_rotulos == MAX_ROTULOS) erro("rótulos demais", NULL);
+                    snprintf(rotulos[num_rotulos].nome, sizeof(rotulos[0].nome), "%s", s);
+                    rotulos[num_rotulos++].endereco = endereco;
+                }
+                s = aparar(dois_pontos + 1);
+                if (*s == '\0') continue;
+            }
+
+            if (endereco == PIO_MAX_INSTRUCOES) erro("programa excede 32 instruções", NULL);
+            if (passagem == 1) programa->instrucoes[endereco] = codificar(programa, s);
+            endereco++;
+        }
+        fclose(arquivo);
+
+        if (!encontrado) {
+            fprintf(stderr, "pio_emu: programa %s não encontrado em %s\n", nome ? nome : "", caminho);
+            exit(1);
+        }
+        programa->tamanho = endereco;
+    }
+    if (programa->wrap < 0) programa->wrap = programa->tamanho - 1;
+}
+
+// ----- State machine -----
+
+static void escrever_pinos(int base, int qtd, uint32_t valor, uint32_t *destino) {
+    uint32_t mascara = (qtd >= 32 ? 0xffffffffu : ((1u << qtd) - 1u)) << base;
+    *destino = (*destino & ~mascara) | ((valor << base) & mascara);
+}
+
+static bool fifo_retirar(sm_t *sm, uint32_t *palavra) {
+    if (sm->fifo_qtd == 0) return false;
+    *palavra = sm->fifo[sm->fifo_ini];
+    sm->fifo_ini = (sm->fifo_ini + 1) % PIO_FIFO_TAM;
+    sm->fifo_qtd--;
+    return true;
+}
+
+static uint32_t deslocar_osr(sm_t *sm, int bits) {
+    uint32_t valor;
+
+    if (bits == 32) {
+        valor = sm->osr;
+        sm->osr = 0;
+    } else if (sm->config->shift_direita) {
+        valor = sm->osr & ((1u << bits) - 1u);
+        sm->osr >>= bits;
+    } else {
+        valor = sm->osr >> (32 - bits);
+        sm->osr <<= bits;
+    }
+    sm->osr_cont = sm->osr_cont + bits > 32 ? 32 : sm->osr_cont + bits;
+    return valor;
+}
+
+static void deslocar_isr(sm_t *sm, uint32_t valor, int bits) {
+    uint32_t mascara = bits == 32 ? 0xffffffffu : (1u << bits) - 1u;
+    sm->isr = bits == 32 ? valor : (sm->isr << bits) | (valor & mascara);
+    sm->isr_cont = sm->isr_cont + bits > 32 ? 32 : sm->isr_cont + bits;
+}
+
+static uint32_t inverter_bits(uint32_t v) {
+    uint32_t r = 0;
+    for (int i = 0; i < 32; i++) r |= ((v >> i) & 1u) << (31 - i);
+    return r;
+}
+
+bool pio_rx_retirar(sm_t *sm, uint32_t *palavra) {
+    if (sm->rx_qtd == 0) return false;
+    *palavra = sm->fifo_rx[sm->rx_ini];
+    sm->rx_ini = (sm->rx_ini + 1) % PIO_FIFO_TAM;
+    sm->rx_qtd--;
+    return true;
+}
+
+// Níveis dos GPIO a partir de in_base, com a volta do pino 31 ao 0 como no hardware
+static uint32_t ler_entradas(const sm_t *sm) {
+    uint32_t gpio = sm->entradas ? sm->entradas(sm->contexto, sm->pinos, sm->dirs) : 0;
+    int base = sm->config->in_base & 31;
+    return base ? (gpio >> base) | (gpio << (32 - base)) : gpio;
+}
+
+void pio_ciclo(sm_t *sm) {
+    const config_t *cfg = sm->config;
+    const programa_t *prog = sm->programa;
+
+    if (sm->atraso > 0) {
+        sm->atraso--;
+        return;
+    }
+
+    uint16_t instr = prog->instrucoes[sm->pc];
+    int bits_side = prog->side_bits + (prog->side_opt ? 1 : 0);
+    int campo = (instr >> 8) & 31, operacao = instr >> 13, atraso = campo & ((1 << (5 - bits_side)) - 1);
+    int arg1 = (instr >> 5) & 7, arg2 = instr & 31;
+    int bits = arg2 ? arg2 : 32;
+    bool saltou = false;
+    uint32_t valor;
+
+    // O side-set vale no início da instrução, antes da operação, mesmo que ela fique parada
+    if (bits_side > 0) {
+        uint32_t side = (uint32_t)campo >> (5 - bits_side);
+        if (!prog->side_opt || (side >> prog->side_bits) & 1u) {
+            escrever_pinos(cfg->side_base, prog->side_bits, side, prog->side_pindirs ? &sm->dirs : &sm->pinos);
+        }
+    }
+
+    switch (operacao) {
+    case 0: {   // jmp
+        bool condicao = true;
+        switch (arg1) {
+        case 1: condicao = sm->x == 0; break;
+        case 2: condicao = sm->x != 0; sm->x--; break;
+        case 3: condicao = sm->y == 0; break;
+        case 4: condicao = sm->y != 0; sm->y--; break;
+        case 5: condicao = sm->x != sm->y; break;
+        case 6: condicao = false; break;   // Entradas não são simuladas: pino em 0
+        case 7: condicao = sm->osr_cont < cfg->limiar_pull; break;
+        }
+        if (condicao) { sm->pc = (uint8_t)arg2; saltou = true; }
+        break;
+    }
+    case 1:     // wait: entradas em 0, apenas "wait 0" prossegue
+        if ((instr >> 7) & 1) { sm->paradas++; return; }
+        break;
+    case 2:     // in
+        switch (arg1) {
+        case 0: valor = ler_entradas(sm); break;
+        case 1: valor = sm->x; break;
+        case 2: valor = sm->y; break;
+        case 6: valor = sm->isr; break;
+        case 7: valor = sm->osr; break;
+        default: valor = 0; break;
+        }
+        deslocar_isr(sm, valor, bits);
+        break;
+    case 3:     // out, com autopull
+        if (sm->osr_cont >= cfg->limiar_pull) {
+            if (!fifo_retirar(sm, &sm->osr)) { sm->paradas++; return; }
+            sm->osr_cont = 0;
+        }
+        valor = deslocar_osr(sm, bits);
+        switch (arg1) {
+        case 0: escrever_pinos(cfg->out_base, cfg->out_qtd, valor, &sm->pinos); break;
+        case 1: sm->x = valor; break;
+        case 2: sm->y = valor; break;
+        case 4: escrever_pinos(cfg->out_base, cfg->out_qtd, valor, &sm->dirs); break;
+        case 5: sm->pc = (uint8_t)valor; saltou = true; break;
+        case 6: sm->isr = valor; sm->isr_cont = bits; break;
+        }
+        break;
+    case 4:
+        if (instr & 0x80) {     // pull
+            bool se_vazia = (instr >> 6) & 1, bloqueante = (instr >> 5) & 1;
+            if (se_vazia && sm->osr_cont < cfg->limiar_pull) break;
+            if (!fifo_retirar(sm, &sm->osr)) {
+                if (bloqueante) { sm->paradas++; return; }
+                sm->osr = sm->x;
+            }
+            sm->osr_cont = 0;
+        } else {                // push (sem autopush: iffull exige a ISR cheia)
+            bool se_cheia = (instr >> 6) & 1, bloqueante = (instr >> 5) & 1;
+            if (se_cheia && sm->isr_cont < 32) break;
+            if (sm->rx_qtd == PIO_FIFO_TAM) {
+                if (bloqueante) { sm->paradas++; return; }
+            } else {
+                sm->fifo_rx[(sm->rx_ini + sm->rx_qtd) % PIO_FIFO_TAM] = sm->isr;
+                sm->rx_qtd++;
+            }
+            sm->isr = 0;
+            sm->isr_cont = 0;
+        }
+        break;
+    case 5: {   // mov
+        int origem = instr & 7, op = (instr >> 3) & 3;
+        switch (origem) {
+        case 1: valor = sm->x; break;
+        case 2: valor = sm->y; break;
+        case 5: valor = sm->fifo_qtd == 0 ? 0xffffffffu : 0; break;   // STATUS_TX_LESSTHAN 1
+        case 6: valor = sm->isr; break;
+        case 7: valor = sm->osr; break;
+        default: valor = 0; break;
+        }
+        if (op == 1) valor = ~valor;
+        else if (op == 2) valor = inverter_bits(valor);
+        switch (arg1) {
+        case 0: escrever_pinos(cfg->out_base, cfg->out_qtd, valor, &sm->pinos); break;
+        case 1: sm->x = valor; break;
+        case 2: sm->y = valor; break;
+        case 5: sm->pc = (uint8_t)valor; saltou = true; break;
+        case 6: sm->isr = valor; sm->isr_cont = 0; break;
+        case 7: sm->osr = valor; sm->osr_cont = 0; break;
+        }
+        break;
+    }
+    case 7:     // set
+        switch (arg1) {
+        case 0: escrever_pinos(cfg->set_base, cfg->set_qtd, (uint32_t)arg2, &sm->pinos); break;
+        case 1: sm->x = (uint32_t)arg2; break;
+        case 2: sm->y = (uint32_t)arg2; break;
+        case 4: escrever_pinos(cfg->set_base, cfg->set_qtd, (uint32_t)arg2, &sm->dirs); break;
+        }
+        break;
+    default:
+        fprintf(stderr, "pio_emu: instrução 0x%04x não suportada na execução\n", instr);
+        exit(1);
+    }
+
+    if (!saltou) sm->pc = (uint8_t)(sm->pc == prog->wrap ? prog->wrap_target : sm->pc + 1);
+    sm->atraso = atraso;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef PIO_MAQUINA_H
+#define PIO_MAQUINA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Montador e state machine da PIO (RP2040) no host, usados por tools/pio_emu e pelos benchmarks.
+ *
+ * O montador aceita um subconjunto do pioasm: jmp, wait, in, out, push, pull, mov, set, nop,
+ * atrasos [n], side-set (.side_set n [opt] [pindirs] e "side v"), rótulos, .wrap_target/.wrap e
+ * .define com somas e subtrações nos atrasos e valores de set. A state machine executa as
+ * instruções codificadas, um ciclo de clock da PIO por chamada.
+ */
+
+#define PIO_MAX_INSTRUCOES 32
+#define PIO_FIFO_TAM 8   // Cada FIFO com a outra unida a ela (PIO_FIFO_JOIN_TX ou _RX)
+
+typedef struct {
+    char nome[32];
+    uint16_t instrucoes[PIO_MAX_INSTRUCOES];
+    int tamanho;
+    int wrap_target;
+    int wrap;
+    int side_bits;       // Pinos de side-set (0 sem .side_set), sem o bit de habilitação do opt
+    bool side_opt;       // Side-set opcional: o bit mais alto do campo o habilita
+    bool side_pindirs;   // Side-set nas direções dos pinos em vez dos níveis
+} programa_t;
+
+// Configuração da state machine, como a de pio_sm_config
+typedef struct {
+    double clkdiv;
+    int limiar_pull;
+    bool shift_direita;
+    int set_base, set_qtd;
+    int out_base, out_qtd;
+    int in_base;
+    int side_base;
+} config_t;
+
+/**
+ * @brief Níveis dos 32 GPIO lidos por "in pins", dados os níveis e as direções conduzidos pela
+ *        própria state machine (o circuito ligado aos pinos).
+ */
+typedef uint32_t (*pio_entradas_t)(void *contexto, uint32_t pinos, uint32_t dirs);
+
+typedef struct {
+    const programa_t *programa;
+    const config_t *config;
+    pio_entradas_t entradas;   // NULL: entradas em 0
+    void *contexto;
+    uint8_t pc;
+    uint32_t x, y, osr, isr;
+    int osr_cont, isr_cont;
+    int atraso;
+    uint32_t pinos, dirs;
+    uint32_t fifo[PIO_FIFO_TAM];      // TX, com autopull sempre ativo
+    int fifo_ini, fifo_qtd;
+    uint32_t fifo_rx[PIO_FIFO_TAM];   // RX, preenchida por push
+    int rx_ini, rx_qtd;
+    uint64_t paradas;   // Ciclos em que a state machine ficou parada esperando uma FIFO ou um wait
+} sm_t;
+
+/**
+ * @brief Monta o programa pedido (ou o primeiro, com nome NULL) de um arquivo .pio.
+ *
+ * Erros de montagem encerram o processo com a linha do arquivo.
+ */
+void pio_montar(const char *caminho, const char *nome, programa_t *programa);
+
+/**
+ * @brief Executa um ciclo de clock da state machine.
+ *
+ * Instruções paradas (out/pull com a FIFO TX vazia, push com a RX cheia, wait não satisfeito)
+ * repetem no ciclo seguinte sem aplicar o atraso, como no hardware.
+ */
+void pio_ciclo(sm_t *sm);
+
+// Retira a palavra mais antiga da FIFO RX; false se estiver vazia
+bool pio_rx_retirar(sm_t *sm, uint32_t *palavra);
+
+#endif
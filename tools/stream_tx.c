@@ -0,0 +1,163 @@
+/**
+ * @brief Envia frames à matriz pela serial USB (ou ao pseudo-terminal de pio_matrix_host --pty).
+ *
+ * Gera um padrão animado (um ponto percorrendo a matriz sobre um fundo que muda de cor) e o envia
+ * no protocolo de protocolo.h, um pacote por frame com número de sequência.
+ *
+ * Uso:
+ *   stream_tx [opções] /dev/ttyACM0
+ *
+ * Opções:
+ *   --fps n        frames por segundo (200; 0 = o mais rápido possível)
+ *   --frames n     total de frames (1000)
+ *   --pixels n     pixels por frame (25)
+ *   --parcial      envia cada frame em dois pacotes (metade, depois a outra metade com PROTO_APRESENTAR)
+ *   --roteiro t e hex
+ *                  em vez de frames, instala na tecla t, para o evento e (0 pressionada, 1 solta,
+ *                  2 segurada), o roteiro de roteiro.h dado em hexadecimal; "-" remove o instalado
+ *                  (ex.: --roteiro B 2 010000ff02060000 acende a matriz em azul ao segurar 'B')
+ */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "protocolo.h"
+
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int escrever_tudo(int fd, const uint8_t *dados, uint32_t tamanho) {
+    while (tamanho > 0) {
+        ssize_t n = write(fd, dados, tamanho);
+        if (n < 0) return -1;
+        dados += n;
+        tamanho -= (uint32_t)n;
+    }
+    return 0;
+}
+
+// Converte pares de dígitos hexadecimais em bytes; devolve o número de bytes ou -1 se inválido
+static int ler_hex(const char *texto, uint8_t *destino, uint32_t max) {
+    uint32_t n = 0;
+
+    if (strcmp(texto, "-") == 0) return 0;
+    for (; texto[0] && texto[1]; texto += 2) {
+        unsigned int byte;
+        if (n == max || sscanf(texto, "%2x", &byte) != 1) return -1;
+        destino[n++] = (uint8_t)byte;
+    }
+    return texto[0] ? -1 : (int)n;
+}
+
+static void gerar_padrao(uint8_t *rgb, uint32_t pixels, uint32_t quadro) {
+    uint8_t fundo_r = (uint8_t)(quadro * 3), fundo_b = (uint8_t)(255 - quadro * 3);
+
+    for (uint32_t i = 0; i < pixels; i++) {
+        rgb[i * 3 + 0] = fundo_r / 8;
+        rgb[i * 3 + 1] = 0;
+        rgb[i * 3 + 2] = fundo_b / 8;
+    }
+    uint32_t ponto = quadro % pixels;
+    rgb[ponto * 3 + 0] = rgb[ponto * 3 + 1] = rgb[ponto * 3 + 2] = 255;
+}
+
+int main(int argc, char **argv) {
+    const char *caminho = NULL;
+    double fps = 200;
+    uint32_t frames = 1000, pixels = 25;
+    int parcial = 0, tamanho_roteiro = -1;
+    char tecla_roteiro = 0;
+    uint8_t evento_roteiro = 0;
+    static uint8_t roteiro[PROTO_MAX_PIXELS * 3];
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) fps = atof(argv[++i]);
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) frames = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--pixels") == 0 && i + 1 < argc) pixels = (uint32_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--parcial") == 0) parcial = 1;
+        else if (strcmp(argv[i], "--roteiro") == 0 && i + 3 < argc) {
+            tecla_roteiro = argv[i + 1][0];
+            evento_roteiro = (uint8_t)atoi(argv[i + 2]);
+            tamanho_roteiro = ler_hex(argv[i + 3], roteiro, sizeof(roteiro));
+            i += 3;
+            if (tamanho_roteiro < 0) { caminho = NULL; break; }
+        }
+        else if (argv[i][0] != '-' && !caminho) caminho = argv[i];
+        else { caminho = NULL; break; }
+    }
+    if (!caminho || pixels == 0 || pixels > PROTO_MAX_PIXELS) {
+        fprintf(stderr, "uso: stream_tx [--fps n] [--frames n] [--pixels n] [--parcial] [--roteiro t e hex] dispositivo\n");
+        return 1;
+    }
+
+    int fd = open(caminho, O_WRONLY | O_NOCTTY);
+    if (fd < 0) {
+        perror(caminho);
+        return 1;
+    }
+    struct termios modo;
+    if (isatty(fd) && tcgetattr(fd, &modo) == 0) {
+        cfmakeraw(&modo);
+        tcsetattr(fd, TCSANOW, &modo);
+    }
+
+    static uint8_t rgb[PROTO_MAX_PIXELS * 3];
+    static uint8_t pacote[2 * PROTO_TAMANHO_PACOTE(PROTO_MAX_PIXELS)];
+    uint64_t bytes = 0;
+    uint8_t seq = 0;
+
+    if (tamanho_roteiro >= 0) {
+        uint32_t n = proto_codificar_roteiro(pacote, seq, tecla_roteiro, evento_roteiro, roteiro,
+                                             (uint16_t)tamanho_roteiro);
+        if (escrever_tudo(fd, pacote, n) != 0) {
+            perror("write");
+            return 1;
+        }
+        printf("roteiro de %d bytes enviado para a tecla %c\n", tamanho_roteiro, tecla_roteiro);
+        close(fd);
+        return 0;
+    }
+    double inicio = agora_s();
+
+    for (uint32_t q = 0; q < frames; q++) {
+        uint32_t n;
+
+        gerar_padrao(rgb, pixels, q);
+        if (parcial) {
+            uint16_t metade = (uint16_t)(pixels / 2);
+            n = proto_codificar(pacote, seq++, false, 0, metade, rgb);
+            n += proto_codificar(pacote + n, seq++, true, metade, (uint16_t)(pixels - metade), rgb + metade * 3);
+        } else {
+            n = proto_codificar(pacote, seq++, true, 0, (uint16_t)pixels, rgb);
+        }
+        if (escrever_tudo(fd, pacote, n) != 0) {
+            perror("write");
+            return 1;
+        }
+        bytes += n;
+
+        if (fps > 0) {
+            double alvo = inicio + (q + 1) / fps, espera = alvo - agora_s();
+            if (espera > 0) {
+                struct timespec ts = {(time_t)espera, (long)((espera - (time_t)espera) * 1e9)};
+                nanosleep(&ts, NULL);
+            }
+        }
+    }
+
+    double duracao = agora_s() - inicio;
+    printf("%u frames, %llu bytes em %.3f s: %.1f frames/s, %.1f kB/s\n", frames, (unsigned long long)bytes,
+           duracao, frames / duracao, bytes / duracao / 1000.0);
+    close(fd);
+    return 0;
+}
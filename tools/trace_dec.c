@@ -0,0 +1,216 @@
+/**
+ * @brief Decodifica o registro de eventos despejado pelo firmware (trace.h) e imprime latências.
+ *
+ * Lê a saída do stdio da placa (ou de pio_matrix_host com o comando t), ignorando as linhas que não
+ * são do trace; vários despejos podem ser concatenados, e registros repetidos são descartados.
+ * Para cada medida imprime min/p50/p90/p99/max e um histograma em faixas de potência de 2.
+ *
+ * Medidas:
+ *   debounce                borda na coluna -> tecla confirmada
+ *   tecla -> comando        tecla confirmada -> comando despachado no laço principal
+ *   comando -> transmissão  comando -> primeira transmissão de frame seguinte
+ *   tecla -> transmissão    tecla confirmada -> primeiro pixel do novo frame saindo pela PIO
+ *   codificação             produção de um frame (passo da animação ou frame da serial)
+ *   transmissão             frame entregue ao DMA -> última palavra na FIFO
+ *   intervalo entre frames  transmissão -> transmissão seguinte
+ *
+ * Uso:
+ *   trace_dec [arquivo]            (sem arquivo, lê a entrada padrão)
+ *   echo "1 w100 2 w3000 t q" | ./build_host/pio_matrix_host --silencioso | ./build_host/trace_dec
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace.h"
+
+#define NUM_FAIXAS 32
+#define LARGURA_BARRA 40
+
+typedef struct {
+    uint32_t tempo_us;
+    uint8_t evento;
+    uint16_t arg;
+} registro_t;
+
+typedef struct {
+    const char *nome;
+    uint32_t *valores;
+    uint32_t n, capacidade;
+} medida_t;
+
+enum {
+    DEBOUNCE,
+    TECLA_COMANDO,
+    COMANDO_TRANSMISSAO,
+    TECLA_TRANSMISSAO,
+    CODIFICACAO,
+    TRANSMISSAO,
+    INTERVALO,
+    NUM_MEDIDAS
+};
+
+static medida_t medidas[NUM_MEDIDAS] = {
+    [DEBOUNCE] = {"debounce"},
+    [TECLA_COMANDO] = {"tecla -> comando"},
+    [COMANDO_TRANSMISSAO] = {"comando -> transmissão"},
+    [TECLA_TRANSMISSAO] = {"tecla -> transmissão"},
+    [CODIFICACAO] = {"codificação"},
+    [TRANSMISSAO] = {"transmissão"},
+    [INTERVALO] = {"intervalo entre frames"},
+};
+
+static void acrescentar(int m, uint32_t inicio_us, uint32_t fim_us) {
+    medida_t *d = &medidas[m];
+    if (d->n == d->capacidade) {
+        d->capacidade = d->capacidade ? d->capacidade * 2 : 64;
+        d->valores = realloc(d->valores, d->capacidade * sizeof(uint32_t));
+        if (!d->valores) exit(1);
+    }
+    // Diferença em 32 bits: tolera o estouro do contador de µs
+    d->valores[d->n++] = fim_us - inicio_us;
+}
+
+static int comparar(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil pelo posto mais próximo
+static uint32_t percentil(const medida_t *d, uint32_t p) {
+    uint32_t posto = (d->n * p + 99) / 100;
+    return d->valores[posto ? posto - 1 : 0];
+}
+
+// Nome alinhado em colunas contando caracteres, não bytes (os nomes têm acentos em UTF-8)
+static void imprimir_nome(const char *nome) {
+    int largura = 0;
+    for (const char *p = nome; *p; p++) largura += ((*p & 0xC0) != 0x80);
+    printf("%s%*s", nome, largura < 24 ? 24 - largura : 0, "");
+}
+
+static void imprimir(const medida_t *d) {
+    uint32_t faixas[NUM_FAIXAS] = {0}, maior = 0;
+    int primeira = NUM_FAIXAS, ultima = 0;
+
+    if (d->n == 0) {
+        imprimir_nome(d->nome);
+        printf(" sem amostras\n\n");
+        return;
+    }
+    qsort(d->valores, d->n, sizeof(uint32_t), comparar);
+    imprimir_nome(d->nome);
+    printf(" n=%-5u min %7u  p50 %7u  p90 %7u  p99 %7u  max %7u us\n", d->n,
+           d->valores[0], percentil(d, 50), percentil(d, 90), percentil(d, 99), d->valores[d->n - 1]);
+
+    // Faixa k: [2^k, 2^(k+1)) µs, com a faixa 0 incluindo o zero
+    for (uint32_t i = 0; i < d->n; i++) {
+        int k = d->valores[i] ? 31 - __builtin_clz(d->valores[i]) : 0;
+        if (++faixas[k] > maior) maior = faixas[k];
+        if (k < primeira) primeira = k;
+        if (k > ultima) ultima = k;
+    }
+    for (int k = primeira; k <= ultima; k++) {
+        int barra = (int)((uint64_t)faixas[k] * LARGURA_BARRA / maior);
+        printf("  [%8lu, %8lu) |%-*.*s| %u\n", k ? 1ul << k : 0ul, 1ul << (k + 1), LARGURA_BARRA, barra,
+               "########################################", faixas[k]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    FILE *entrada = stdin;
+    char linha[256];
+    registro_t *registros = NULL;
+    uint32_t num = 0, capacidade = 0, descontinuidades = 0;
+    unsigned long n, t, e, a;
+    long long ultimo_n = -1;
+
+    if (argc > 2 || (argc == 2 && !(entrada = fopen(argv[1], "r")))) {
+        if (argc == 2) perror(argv[1]);
+        else fprintf(stderr, "uso: trace_dec [arquivo]\n");
+        return 1;
+    }
+
+    while (fgets(linha, sizeof(linha), entrada)) {
+        // As linhas do trace podem vir no meio de outras mensagens do firmware
+        char *p = strstr(linha, "trace ");
+        if (!p || sscanf(p, "trace %lu %lu %lu %lu", &n, &t, &e, &a) != 4) continue;
+        if ((long long)n <= ultimo_n) continue;  // Já visto num despejo anterior
+        if (ultimo_n >= 0 && (long long)n != ultimo_n + 1) descontinuidades++;
+        ultimo_n = (long long)n;
+
+        if (num == capacidade) {
+            capacidade = capacidade ? capacidade * 2 : 1024;
+            registros = realloc(registros, capacidade * sizeof(registro_t));
+            if (!registros) return 1;
+        }
+        registros[num++] = (registro_t){(uint32_t)t, (uint8_t)e, (uint16_t)a};
+    }
+    if (num == 0) {
+        fprintf(stderr, "nenhum registro de trace na entrada\n");
+        return 1;
+    }
+
+    // Pareamento em ordem de registro: cada medida guarda o instante do evento que a inicia
+    bool borda = false, tecla = false, comando = false, codificando = false, transmitindo = false, houve_frame = false;
+    uint32_t t_borda = 0, t_tecla = 0, t_tecla_comando = 0, t_comando = 0, t_codificando = 0, t_transmissao = 0;
+
+    for (uint32_t i = 0; i < num; i++) {
+        const registro_t *r = &registros[i];
+        switch (r->evento) {
+        case TRACE_TECLA_BORDA:
+            borda = true;
+            t_borda = r->tempo_us;
+            break;
+        case TRACE_TECLA:
+            if (borda) acrescentar(DEBOUNCE, t_borda, r->tempo_us);
+            borda = false;
+            tecla = true;
+            t_tecla = r->tempo_us;
+            break;
+        case TRACE_COMANDO:
+            if (tecla) {
+                acrescentar(TECLA_COMANDO, t_tecla, r->tempo_us);
+                t_tecla_comando = t_tecla;
+            } else {
+                t_tecla_comando = r->tempo_us;
+            }
+            tecla = false;
+            comando = true;
+            t_comando = r->tempo_us;
+            break;
+        case TRACE_CODIFICANDO:
+            codificando = true;
+            t_codificando = r->tempo_us;
+            break;
+        case TRACE_CODIFICADO:
+            if (codificando) acrescentar(CODIFICACAO, t_codificando, r->tempo_us);
+            codificando = false;
+            break;
+        case TRACE_TRANSMISSAO:
+            if (comando) {
+                acrescentar(COMANDO_TRANSMISSAO, t_comando, r->tempo_us);
+                acrescentar(TECLA_TRANSMISSAO, t_tecla_comando, r->tempo_us);
+            }
+            if (houve_frame) acrescentar(INTERVALO, t_transmissao, r->tempo_us);
+            comando = false;
+            houve_frame = true;
+            transmitindo = true;
+            t_transmissao = r->tempo_us;
+            break;
+        case TRACE_FIFO_VAZIA:
+            if (transmitindo) acrescentar(TRANSMISSAO, t_transmissao, r->tempo_us);
+            transmitindo = false;
+            break;
+        }
+    }
+
+    printf("%u registros", num);
+    if (descontinuidades) printf(" (%u descontinuidades: registros sobrescritos entre despejos)", descontinuidades);
+    printf("\n\n");
+    for (int m = 0; m < NUM_MEDIDAS; m++) imprimir(&medidas[m]);
+    return 0;
+}
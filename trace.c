@@ -0,0 +1,35 @@
+#include "trace.h"
+
+#include <stdio.h>
+#include "hal.h"
+
+static trace_registro_t registros[TRACE_TAM];
+
+// Total de registros já feitos; o índice no buffer são os bits baixos
+static uint32_t cabeca = 0;
+
+void trace_registrar_em(uint32_t tempo_us, trace_evento_t evento, uint16_t arg) {
+    // O incremento atômico reserva a posição mesmo com interrupções e o outro núcleo registrando
+    uint32_t n = __atomic_fetch_add(&cabeca, 1, __ATOMIC_RELAXED);
+    trace_registro_t *r = &registros[n & (TRACE_TAM - 1)];
+
+    r->tempo_us = tempo_us;
+    r->evento = (uint8_t)evento;
+    r->arg = arg;
+}
+
+void trace_registrar(trace_evento_t evento, uint16_t arg) {
+    trace_registrar_em((uint32_t)hal_agora_us(), evento, arg);
+}
+
+void trace_despejar(void) {
+    uint32_t fim = __atomic_load_n(&cabeca, __ATOMIC_RELAXED);
+    uint32_t inicio = fim > TRACE_TAM ? fim - TRACE_TAM : 0;
+
+    printf("trace inicio %lu\n", (unsigned long)(fim - inicio));
+    for (uint32_t n = inicio; n < fim; n++) {
+        const trace_registro_t *r = &registros[n & (TRACE_TAM - 1)];
+        printf("trace %lu %lu %u %u\n", (unsigned long)n, (unsigned long)r->tempo_us, r->evento, r->arg);
+    }
+    printf("trace fim\n");
+}
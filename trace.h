@@ -0,0 +1,63 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Registro de eventos com carimbo de tempo em um buffer circular na RAM.
+ *
+ * Cada registro custa uma leitura do relógio, um incremento atômico e três escritas, e pode ser
+ * feito de interrupções e dos dois núcleos; os mais antigos são sobrescritos. trace_despejar
+ * imprime o conteúdo em texto pelo stdio (UART/USB), para tools/trace_dec calcular as latências.
+ *
+ * Compilado por padrão; com PIO_MATRIX_TRACE=0 as chamadas de TRACE desaparecem.
+ */
+
+#ifndef PIO_MATRIX_TRACE
+#define PIO_MATRIX_TRACE 1
+#endif
+
+// Registros guardados (potência de 2); cada um ocupa 8 bytes
+#define TRACE_TAM 256
+
+typedef enum {
+    TRACE_TECLA_BORDA = 1,  // Tecla fechando: borda numa coluna (arg: pino) ou leitura nova da PIO (arg: 16 teclas)
+    TRACE_TECLA,            // Tecla confirmada pelo debounce; arg: caractere
+    TRACE_COMANDO,          // Comando despachado no laço principal; arg: caractere
+    TRACE_CODIFICANDO,      // Início da produção de um frame; arg: passo da animação ou seq do pacote
+    TRACE_CODIFICADO,       // Frame pronto para o framebuffer; arg: o mesmo do início
+    TRACE_TRANSMISSAO,      // Primeira palavra do frame a caminho da FIFO da PIO; arg: palavras
+    TRACE_FIFO_VAZIA        // DMA concluído: todas as palavras entregues à FIFO; arg: 0
+} trace_evento_t;
+
+typedef struct {
+    uint32_t tempo_us;
+    uint8_t evento;
+    uint8_t reservado;
+    uint16_t arg;
+} trace_registro_t;
+
+// Registra um evento no instante atual
+void trace_registrar(trace_evento_t evento, uint16_t arg);
+
+// Registra um evento num instante já conhecido (ex.: fim de transmissão calculado pelo simulador)
+void trace_registrar_em(uint32_t tempo_us, trace_evento_t evento, uint16_t arg);
+
+/**
+ * @brief Imprime os registros guardados, do mais antigo ao mais novo.
+ *
+ * Formato (uma linha por registro, entre "trace inicio" e "trace fim"):
+ *   trace <número> <tempo_us> <evento> <arg>
+ * Registros gravados durante o despejo podem sair misturados; o número permite descartá-los.
+ */
+void trace_despejar(void);
+
+#if PIO_MATRIX_TRACE
+#define TRACE(evento, arg) trace_registrar((evento), (uint16_t)(arg))
+#define TRACE_EM(tempo_us, evento, arg) trace_registrar_em((uint32_t)(tempo_us), (evento), (uint16_t)(arg))
+#else
+#define TRACE(evento, arg) ((void)sizeof(arg))
+#define TRACE_EM(tempo_us, evento, arg) ((void)sizeof(tempo_us), (void)sizeof(arg))
+#endif
+
+#endif